@@ -0,0 +1,256 @@
+#include <benchmark/benchmark.h>
+
+#include <components/bsa/compressedbsafile.hpp>
+
+#include <lz4frame.h>
+
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_streambuf.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using namespace Bsa;
+
+    constexpr std::uint32_t zlibVersion = 0x68;
+    constexpr std::uint32_t lz4Version = 0x69;
+
+    struct ArchiveFile
+    {
+        std::string mName;
+        std::string mContent;
+    };
+
+    template <class Random>
+    std::string generateContent(Random& random)
+    {
+        // Text-like data with a compression ratio close to the one of typical meshes
+        constexpr const char* words[] = { "NiNode", "NiTriShape", "NiTexturingProperty", "NiMaterialProperty",
+            "Bip01", "Scene Root", "Tri Shape", "Collision" };
+        std::uniform_int_distribution<std::size_t> size(1024, 64 * 1024);
+        std::uniform_int_distribution<std::size_t> word(0, std::size(words) - 1);
+        std::uniform_int_distribution<int> byte(0, 255);
+        const std::size_t targetSize = size(random);
+        std::string result;
+        while (result.size() < targetSize)
+        {
+            result += words[word(random)];
+            for (int i = 0; i < 8; ++i)
+                result += static_cast<char>(byte(random));
+        }
+        return result;
+    }
+
+    std::string compress(const std::string& content, std::uint32_t version)
+    {
+        std::string result;
+        if (version == lz4Version)
+        {
+            result.resize(LZ4F_compressFrameBound(content.size(), nullptr));
+            const std::size_t size
+                = LZ4F_compressFrame(result.data(), result.size(), content.data(), content.size(), nullptr);
+            if (LZ4F_isError(size))
+                throw std::runtime_error(std::string("Failed to compress: ") + LZ4F_getErrorName(size));
+            result.resize(size);
+        }
+        else
+        {
+            boost::iostreams::filtering_streambuf<boost::iostreams::input> input;
+            input.push(boost::iostreams::zlib_compressor());
+            input.push(boost::iostreams::array_source(content.data(), content.size()));
+            boost::iostreams::copy(input, boost::iostreams::back_inserter(result));
+        }
+        return result;
+    }
+
+    template <class T>
+    void write(std::ostream& stream, T value)
+    {
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    std::uint64_t getFileHash(const std::string& name)
+    {
+        const std::filesystem::path path(name);
+        return CompressedBSAFile::generateHash(path.stem(), path.extension().string());
+    }
+
+    /// Writes archive with all files compressed following https://en.uesp.net/wiki/Tes4Mod:BSA_File_Format
+    void writeArchive(const std::filesystem::path& path,
+        const std::map<std::string, std::vector<ArchiveFile>>& folders, std::uint32_t version)
+    {
+        std::size_t fileCount = 0;
+        std::uint32_t totalFolderNameLength = 0;
+        std::uint32_t totalFileNameLength = 0;
+        for (const auto& [folder, files] : folders)
+        {
+            fileCount += files.size();
+            totalFolderNameLength += static_cast<std::uint32_t>(folder.size() + 1);
+            for (const ArchiveFile& file : files)
+                totalFileNameLength += static_cast<std::uint32_t>(file.mName.size() + 1);
+        }
+
+        const std::size_t folderRecordSize = version == lz4Version ? 24 : 16;
+        std::size_t offset = 36 + folderRecordSize * folders.size() + totalFolderNameLength + folders.size()
+            + 16 * fileCount + totalFileNameLength;
+
+        std::ofstream stream(path, std::ios_base::binary);
+
+        write<std::uint32_t>(stream, 0x00415342);
+        write<std::uint32_t>(stream, version);
+        write<std::uint32_t>(stream, 36);
+        // Has names for directories and files, files are compressed by default
+        write<std::uint32_t>(stream, 0x1 | 0x2 | 0x4);
+        write<std::uint32_t>(stream, static_cast<std::uint32_t>(folders.size()));
+        write<std::uint32_t>(stream, static_cast<std::uint32_t>(fileCount));
+        write<std::uint32_t>(stream, totalFolderNameLength);
+        write<std::uint32_t>(stream, totalFileNameLength);
+        write<std::uint32_t>(stream, 0);
+
+        for (const auto& [folder, files] : folders)
+        {
+            write<std::uint64_t>(stream, CompressedBSAFile::generateHash(folder, {}));
+            write<std::uint32_t>(stream, static_cast<std::uint32_t>(files.size()));
+            if (version == lz4Version)
+            {
+                write<std::uint32_t>(stream, 0);
+                write<std::uint64_t>(stream, 0);
+            }
+            else
+                write<std::uint32_t>(stream, 0);
+        }
+
+        std::vector<std::string> data;
+        for (const auto& [folder, files] : folders)
+        {
+            write<std::uint8_t>(stream, static_cast<std::uint8_t>(folder.size() + 1));
+            stream.write(folder.c_str(), folder.size() + 1);
+            for (const ArchiveFile& file : files)
+            {
+                std::string compressed = compress(file.mContent, version);
+                const auto size = static_cast<std::uint32_t>(compressed.size() + sizeof(std::uint32_t));
+                write<std::uint64_t>(stream, getFileHash(file.mName));
+                write<std::uint32_t>(stream, size);
+                write<std::uint32_t>(stream, static_cast<std::uint32_t>(offset));
+                offset += size;
+                data.push_back(std::move(compressed));
+            }
+        }
+
+        for (const auto& [folder, files] : folders)
+            for (const ArchiveFile& file : files)
+                stream.write(file.mName.c_str(), file.mName.size() + 1);
+
+        std::size_t index = 0;
+        for (const auto& [folder, files] : folders)
+        {
+            for (const ArchiveFile& file : files)
+            {
+                write<std::uint32_t>(stream, static_cast<std::uint32_t>(file.mContent.size()));
+                stream.write(data[index].data(), data[index].size());
+                ++index;
+            }
+        }
+    }
+
+    const std::filesystem::path& getArchivePath(std::uint32_t version)
+    {
+        static const std::map<std::uint32_t, std::filesystem::path> paths = [] {
+            std::minstd_rand random;
+            std::map<std::string, std::vector<ArchiveFile>> folders;
+            for (int i = 0; i < 1000; ++i)
+                folders["meshes\\f\\folder" + std::to_string(i % 50)].push_back(
+                    ArchiveFile{ "file" + std::to_string(i) + ".nif", generateContent(random) });
+            std::map<std::uint32_t, std::filesystem::path> result;
+            for (const std::uint32_t version : { zlibVersion, lz4Version })
+            {
+                auto path = std::filesystem::temp_directory_path()
+                    / ("openmw_compressedbsafile_benchmark_" + std::to_string(version) + ".bsa");
+                writeArchive(path, folders, version);
+                result.emplace(version, std::move(path));
+            }
+            return result;
+        }();
+        return paths.at(version);
+    }
+
+    std::vector<const BSAFile::FileStruct*> getAllFiles(const CompressedBSAFile& archive)
+    {
+        std::vector<const BSAFile::FileStruct*> result;
+        for (const BSAFile::FileStruct& file : archive.getList())
+            result.push_back(&file);
+        return result;
+    }
+
+    template <std::uint32_t version, bool mapped>
+    void extractAllSequentially(benchmark::State& state)
+    {
+        CompressedBSAFile archive;
+        archive.open(getArchivePath(version), mapped);
+        std::size_t bytes = 0;
+
+        for (auto _ : state)
+        {
+            for (const BSAFile::FileStruct& file : archive.getList())
+            {
+                const Files::IStreamPtr stream = archive.getFile(&file);
+                benchmark::DoNotOptimize(stream->rdbuf());
+                bytes += file.fileSize;
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * archive.getList().size());
+        state.SetBytesProcessed(bytes);
+    }
+
+    template <std::uint32_t version, bool mapped>
+    void extractAllConcurrently(benchmark::State& state)
+    {
+        CompressedBSAFile archive;
+        archive.open(getArchivePath(version), mapped);
+        const std::vector<const BSAFile::FileStruct*> files = getAllFiles(archive);
+        const auto threads = static_cast<std::size_t>(state.range(0));
+        std::size_t bytes = 0;
+
+        for (auto _ : state)
+        {
+            const std::vector<Files::IStreamPtr> streams = archive.getFiles(files, threads);
+            benchmark::DoNotOptimize(streams.data());
+            for (const BSAFile::FileStruct* file : files)
+                bytes += file->fileSize;
+        }
+
+        state.SetItemsProcessed(state.iterations() * files.size());
+        state.SetBytesProcessed(bytes);
+    }
+
+    void threadsCounts(benchmark::internal::Benchmark* benchmark)
+    {
+        const int maxThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        for (int threads = 1; threads < maxThreads; threads *= 2)
+            benchmark->Arg(threads);
+        benchmark->Arg(maxThreads);
+    }
+}
+
+BENCHMARK(extractAllSequentially<zlibVersion, false>);
+BENCHMARK(extractAllSequentially<zlibVersion, true>);
+BENCHMARK(extractAllSequentially<lz4Version, false>);
+BENCHMARK(extractAllSequentially<lz4Version, true>);
+BENCHMARK(extractAllConcurrently<zlibVersion, true>)->Apply(threadsCounts)->UseRealTime();
+BENCHMARK(extractAllConcurrently<lz4Version, true>)->Apply(threadsCounts)->UseRealTime();
+
+BENCHMARK_MAIN();
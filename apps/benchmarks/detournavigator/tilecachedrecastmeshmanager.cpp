@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+
+#include <components/detournavigator/settings.hpp>
+#include <components/detournavigator/tilecachedrecastmeshmanager.hpp>
+
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace DetourNavigator;
+
+    struct Scene
+    {
+        RecastSettings mSettings;
+        osg::ref_ptr<const Resource::BulletShapeInstance> mInstance
+            = new Resource::BulletShapeInstance(new Resource::BulletShape);
+        std::vector<std::unique_ptr<btBoxShape>> mShapes;
+        std::unique_ptr<TileCachedRecastMeshManager> mManager;
+
+        explicit Scene(std::size_t staticObjects)
+        {
+            mSettings.mBorderSize = 16;
+            mSettings.mCellSize = 0.2f;
+            mSettings.mRecastScaleFactor = 0.017647058823529415f;
+            mSettings.mTileSize = 64;
+            mManager = std::make_unique<TileCachedRecastMeshManager>(mSettings);
+            mManager->setWorldspace("worldspace", nullptr);
+            const ObjectTransform objectTransform{ ESM::Position{ { 0, 0, 0 }, { 0, 0, 0 } }, 0.0f };
+            std::minstd_rand random;
+            std::uniform_real_distribution<float> distribution(-2000, 2000);
+            for (std::size_t i = 0; i < staticObjects + 1; ++i)
+            {
+                mShapes.push_back(std::make_unique<btBoxShape>(btVector3(20, 20, 100)));
+                const CollisionShape shape(mInstance, *mShapes.back(), objectTransform);
+                const btTransform transform(
+                    btMatrix3x3::getIdentity(), btVector3(distribution(random), distribution(random), 0));
+                mManager->addObject(ObjectId(mShapes.back().get()), shape, transform, AreaType_ground, nullptr);
+            }
+            mManager->takeChangedTiles(nullptr);
+        }
+
+        const btBoxShape& getMovingShape() const { return *mShapes.back(); }
+    };
+
+    // Moves one object and gets recast meshes of the changed tiles like AsyncNavMeshUpdater does.
+    void updateMovingObject(benchmark::State& state)
+    {
+        Scene scene(static_cast<std::size_t>(state.range(0)));
+        const ObjectId movingObject(&scene.getMovingShape());
+        int step = 0;
+        for (auto _ : state)
+        {
+            ++step;
+            const btTransform transform(btMatrix3x3::getIdentity(), btVector3(step % 200, step % 100, 0));
+            scene.mManager->updateObject(movingObject, transform, AreaType_ground, nullptr);
+            for (const auto& [tilePosition, changeType] : scene.mManager->takeChangedTiles(nullptr))
+                benchmark::DoNotOptimize(scene.mManager->getMesh("worldspace", tilePosition));
+        }
+    }
+
+    // The same but every recast mesh is built from the shapes of all objects.
+    void updateMovingObjectWithoutCache(benchmark::State& state)
+    {
+        Scene scene(static_cast<std::size_t>(state.range(0)));
+        const ObjectId movingObject(&scene.getMovingShape());
+        int step = 0;
+        for (auto _ : state)
+        {
+            ++step;
+            const btTransform transform(btMatrix3x3::getIdentity(), btVector3(step % 200, step % 100, 0));
+            scene.mManager->updateObject(movingObject, transform, AreaType_ground, nullptr);
+            for (const auto& [tilePosition, changeType] : scene.mManager->takeChangedTiles(nullptr))
+                benchmark::DoNotOptimize(scene.mManager->getNewMesh("worldspace", tilePosition));
+        }
+    }
+} // namespace
+
+BENCHMARK(updateMovingObject)->Arg(100)->Arg(1000)->Arg(10000);
+BENCHMARK(updateMovingObjectWithoutCache)->Arg(100)->Arg(1000)->Arg(10000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,113 @@
+#include <benchmark/benchmark.h>
+
+#include <components/esm3/esmreader.hpp>
+#include <components/esm3/esmwriter.hpp>
+#include <components/esm3/formatversion.hpp>
+#include <components/esm3/loadacti.hpp>
+#include <components/esm3/loadstat.hpp>
+#include <components/files/openfile.hpp>
+#include <components/to_utf8/to_utf8.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace
+{
+    constexpr std::size_t recordsCount = 100000;
+
+    /// Writes a content file with records similar to the ones that make up most of the large masters
+    const std::filesystem::path& getContentFilePath()
+    {
+        static const std::filesystem::path path = [] {
+            auto result = std::filesystem::temp_directory_path() / "openmw_esmreader_benchmark.omwaddon";
+            std::ofstream stream(result, std::ios::binary);
+            ESM::ESMWriter writer;
+            writer.setFormatVersion(ESM::CurrentContentFormatVersion);
+            writer.save(stream);
+            for (std::size_t i = 0; i < recordsCount; ++i)
+            {
+                const std::string suffix = std::to_string(i);
+                if (i % 2 == 0)
+                {
+                    ESM::Static record;
+                    record.blank();
+                    record.mId = ESM::RefId::stringRefId("static_" + suffix);
+                    record.mModel = "meshes\\x\\ex_common_static_" + suffix + ".nif";
+                    writer.startRecord(ESM::REC_STAT);
+                    record.save(writer);
+                    writer.endRecord(ESM::REC_STAT);
+                }
+                else
+                {
+                    ESM::Activator record;
+                    record.blank();
+                    record.mId = ESM::RefId::stringRefId("activator_" + suffix);
+                    record.mName = "Activator " + suffix;
+                    record.mModel = "meshes\\x\\ex_common_activator_" + suffix + ".nif";
+                    record.mScript = ESM::RefId::stringRefId("script_" + suffix);
+                    writer.startRecord(ESM::REC_ACTI);
+                    record.save(writer);
+                    writer.endRecord(ESM::REC_ACTI);
+                }
+            }
+            writer.close();
+            return result;
+        }();
+        return path;
+    }
+
+    std::size_t readRecords(ESM::ESMReader& reader)
+    {
+        std::size_t result = 0;
+        bool isDeleted = false;
+        ESM::Static staticRecord;
+        ESM::Activator activatorRecord;
+        while (reader.hasMoreRecs())
+        {
+            const ESM::NAME name = reader.getRecName();
+            reader.getRecHeader();
+            if (name == ESM::REC_STAT)
+                staticRecord.load(reader, isDeleted);
+            else if (name == ESM::REC_ACTI)
+                activatorRecord.load(reader, isDeleted);
+            else
+                reader.skipRecord();
+            ++result;
+        }
+        benchmark::DoNotOptimize(staticRecord);
+        benchmark::DoNotOptimize(activatorRecord);
+        return result;
+    }
+
+    template <bool mapped, bool encode>
+    void readContentFile(benchmark::State& state)
+    {
+        const std::filesystem::path& path = getContentFilePath();
+        ToUTF8::Utf8Encoder encoder(ToUTF8::WINDOWS_1252);
+        std::size_t records = 0;
+
+        for (auto _ : state)
+        {
+            ESM::ESMReader reader;
+            if (encode)
+                reader.setEncoder(&encoder);
+            if (mapped)
+                reader.open(path);
+            else
+                reader.open(Files::openBinaryInputFileStream(path), path);
+            records += readRecords(reader);
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(records));
+        state.SetBytesProcessed(
+            static_cast<std::int64_t>(state.iterations() * std::filesystem::file_size(getContentFilePath())));
+    }
+}
+
+BENCHMARK(readContentFile<false, false>);
+BENCHMARK(readContentFile<true, false>);
+BENCHMARK(readContentFile<false, true>);
+BENCHMARK(readContentFile<true, true>);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,68 @@
+#include <benchmark/benchmark.h>
+
+#include <components/esm3terrain/storage.hpp>
+#include <components/misc/constants.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr float cellSize = Constants::CellSizeInUnits;
+
+    struct Data
+    {
+        std::unique_ptr<ESM::Land::LandData> mLand = std::make_unique<ESM::Land::LandData>();
+        std::vector<osg::Vec3f> mPositions;
+    };
+
+    Data makeData(std::size_t count)
+    {
+        std::minstd_rand random;
+        Data result;
+        std::uniform_real_distribution<float> height(-1000, 1000);
+        for (float& v : result.mLand->mHeights)
+            v = height(random);
+        std::uniform_real_distribution<float> position(0, cellSize);
+        result.mPositions.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+            result.mPositions.emplace_back(position(random), position(random), 0);
+        return result;
+    }
+
+    void getHeightAt(benchmark::State& state)
+    {
+        const Data data = makeData(static_cast<std::size_t>(state.range(0)));
+        std::vector<float> heights(data.mPositions.size());
+
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < data.mPositions.size(); ++i)
+                heights[i] = ESMTerrain::getHeightAt(*data.mLand, 0, 0, data.mPositions[i]);
+            benchmark::DoNotOptimize(heights.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void getHeightsAt(benchmark::State& state)
+    {
+        const Data data = makeData(static_cast<std::size_t>(state.range(0)));
+        std::vector<float> heights(data.mPositions.size());
+
+        for (auto _ : state)
+        {
+            ESMTerrain::getHeightsAt(*data.mLand, 0, 0, data.mPositions, heights);
+            benchmark::DoNotOptimize(heights.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}
+
+BENCHMARK(getHeightAt)->Arg(16)->Arg(64)->Arg(1024)->Arg(16384);
+BENCHMARK(getHeightsAt)->Arg(16)->Arg(64)->Arg(1024)->Arg(16384);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,131 @@
+#include <benchmark/benchmark.h>
+
+#include "../../openmw_test_suite/mwscript/test_utils.hpp"
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    struct Compiled
+    {
+        Interpreter::Program mProgram;
+        Compiler::Locals mLocals;
+    };
+
+    Compiled compile(const std::string& script)
+    {
+        TestErrorHandler errorHandler;
+        TestCompilerContext compilerContext;
+        Compiler::Extensions extensions;
+        Compiler::registerExtensions(extensions);
+        compilerContext.setExtensions(&extensions);
+        Compiler::FileParser parser(errorHandler, compilerContext);
+        std::istringstream input(script);
+        Compiler::Scanner scanner(errorHandler, input, compilerContext.getExtensions());
+        scanner.scan(parser);
+        if (!errorHandler.isGood())
+            throw std::runtime_error("Failed to compile script: " + errorHandler.getErrors().front().first);
+        return Compiled{ parser.getProgram(), parser.getLocals() };
+    }
+
+    // Script without branches, so the number of executed instructions is equal to the program size
+    std::string makeStraightLineScript(int lines)
+    {
+        std::string result = "Begin straight_line\nshort a\nlong b\nfloat c\n";
+        for (int i = 0; i < lines; ++i)
+        {
+            result += "set a to a + " + std::to_string(i % 7) + "\n";
+            result += "set b to b * 3 - a\n";
+            result += "set c to c + a / 2.5\n";
+        }
+        result += "End\n";
+        return result;
+    }
+
+    const std::string loopScript = R"mwscript(Begin loop
+short i
+long sum
+float f
+
+set i to 0
+while ( i < 1000 )
+    set sum to sum + i * 2
+    set f to f + 0.5
+    if ( sum > 100000 )
+        set sum to 0
+    elseif ( sum < 0 )
+        set sum to 1
+    endif
+    set i to i + 1
+endwhile
+
+End
+)mwscript";
+
+    void runStraightLineScript(benchmark::State& state)
+    {
+        const Compiled script = compile(makeStraightLineScript(static_cast<int>(state.range(0))));
+        Interpreter::Interpreter interpreter;
+        Interpreter::installOpcodes(interpreter);
+        TestInterpreterContext context;
+
+        for (auto _ : state)
+            interpreter.run(script.mProgram, context);
+
+        state.SetItemsProcessed(state.iterations() * script.mProgram.mInstructions.size());
+        state.SetLabel("items are instructions");
+    }
+
+    void runDecodedStraightLineScript(benchmark::State& state)
+    {
+        const Compiled script = compile(makeStraightLineScript(static_cast<int>(state.range(0))));
+        Interpreter::Interpreter interpreter;
+        Interpreter::installOpcodes(interpreter);
+        const Interpreter::DecodedProgram decoded = interpreter.decode(script.mProgram);
+        TestInterpreterContext context;
+
+        for (auto _ : state)
+            interpreter.run(script.mProgram, decoded, context);
+
+        state.SetItemsProcessed(state.iterations() * script.mProgram.mInstructions.size());
+        state.SetLabel("items are instructions");
+    }
+
+    void runLoopScript(benchmark::State& state)
+    {
+        const Compiled script = compile(loopScript);
+        Interpreter::Interpreter interpreter;
+        Interpreter::installOpcodes(interpreter);
+        TestInterpreterContext context;
+
+        for (auto _ : state)
+            interpreter.run(script.mProgram, context);
+
+        state.SetItemsProcessed(state.iterations());
+        state.SetLabel("items are script runs");
+    }
+
+    void runDecodedLoopScript(benchmark::State& state)
+    {
+        const Compiled script = compile(loopScript);
+        Interpreter::Interpreter interpreter;
+        Interpreter::installOpcodes(interpreter);
+        const Interpreter::DecodedProgram decoded = interpreter.decode(script.mProgram);
+        TestInterpreterContext context;
+
+        for (auto _ : state)
+            interpreter.run(script.mProgram, decoded, context);
+
+        state.SetItemsProcessed(state.iterations());
+        state.SetLabel("items are script runs");
+    }
+}
+
+BENCHMARK(runStraightLineScript)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(runDecodedStraightLineScript)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(runLoopScript);
+BENCHMARK(runDecodedLoopScript);
+
+BENCHMARK_MAIN();
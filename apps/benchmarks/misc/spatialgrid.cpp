@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+
+#include <components/misc/spatialgrid.hpp>
+
+#include <osg/Vec3f>
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // Actors are spread over an area of 4x4 exterior cells similar to a large town with the processing range
+    // covering most of it
+    constexpr float areaSize = 4 * 8192;
+    constexpr float cellSize = 1024;
+
+    std::vector<osg::Vec3f> generatePositions(std::size_t count)
+    {
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> horizontal(0, areaSize);
+        std::uniform_real_distribution<float> vertical(0, 2000);
+        std::vector<osg::Vec3f> result;
+        result.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+            result.emplace_back(horizontal(random), horizontal(random), vertical(random));
+        return result;
+    }
+
+    // Each actor looks for the others within radius once per frame
+    void linearSearch(benchmark::State& state)
+    {
+        const std::vector<osg::Vec3f> positions = generatePositions(static_cast<std::size_t>(state.range(0)));
+        const float radius = static_cast<float>(state.range(1));
+
+        for (auto _ : state)
+        {
+            std::size_t found = 0;
+            for (const osg::Vec3f& position : positions)
+                for (const osg::Vec3f& other : positions)
+                    if ((other - position).length2() <= radius * radius)
+                        ++found;
+            benchmark::DoNotOptimize(found);
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    // Same as linearSearch but also includes grid building once per frame
+    void gridSearch(benchmark::State& state)
+    {
+        const std::vector<osg::Vec3f> positions = generatePositions(static_cast<std::size_t>(state.range(0)));
+        const float radius = static_cast<float>(state.range(1));
+        Misc::SpatialGrid<std::size_t> grid(cellSize);
+
+        for (auto _ : state)
+        {
+            grid.clear();
+            for (std::size_t i = 0; i < positions.size(); ++i)
+                grid.add(positions[i], i);
+            grid.build();
+            std::size_t found = 0;
+            for (const osg::Vec3f& position : positions)
+                grid.forEachInRange(position, radius, [&](std::size_t, const osg::Vec3f&) { ++found; });
+            benchmark::DoNotOptimize(found);
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void arguments(benchmark::internal::Benchmark* benchmark)
+    {
+        for (std::int64_t radius : { 200, 1024, 7168 })
+            for (std::int64_t count : { 64, 256, 1024, 4096 })
+                benchmark->Args({ count, radius });
+    }
+}
+
+BENCHMARK(linearSearch)->Apply(arguments);
+BENCHMARK(gridSearch)->Apply(arguments);
+
+BENCHMARK_MAIN();
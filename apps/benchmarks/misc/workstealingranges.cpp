@@ -0,0 +1,217 @@
+#include <benchmark/benchmark.h>
+
+#include <components/misc/barrier.hpp>
+#include <components/misc/workstealingranges.hpp>
+
+#include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcher.h>
+#include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
+#include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
+#include <BulletCollision/CollisionShapes/btCapsuleShape.h>
+#include <BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr int heightfieldSize = 65;
+    constexpr float cellSize = 8192;
+
+    // Similar to the tests done by MovementSolver for a single actor per simulation step. Some actors are stuck
+    // against geometry and MovementSolver runs all of its iterations for them.
+    constexpr std::size_t sweepsPerActor = 4;
+    constexpr std::size_t sweepsPerStuckActor = 64;
+    constexpr std::size_t stuckActorsInterval = 16;
+
+    struct World
+    {
+        btDefaultCollisionConfiguration mConfiguration;
+        btCollisionDispatcher mDispatcher{ &mConfiguration };
+        btDbvtBroadphase mBroadphase;
+        std::vector<float> mHeights;
+        std::unique_ptr<btHeightfieldTerrainShape> mHeightfieldShape;
+        btCollisionObject mHeightfield;
+        btCapsuleShapeZ mActorShape{ 30, 70 };
+        // Has to be destroyed before the objects it refers to
+        btCollisionWorld mCollisionWorld{ &mDispatcher, &mBroadphase, &mConfiguration };
+        std::vector<btVector3> mActors;
+    };
+
+    std::unique_ptr<World> makeWorld(std::size_t actors)
+    {
+        std::minstd_rand random;
+        auto result = std::make_unique<World>();
+
+        std::uniform_real_distribution<float> noise(-50, 50);
+        result->mHeights.reserve(heightfieldSize * heightfieldSize);
+        for (int y = 0; y < heightfieldSize; ++y)
+            for (int x = 0; x < heightfieldSize; ++x)
+                result->mHeights.push_back(400 * std::sin(x * 0.3f) * std::cos(y * 0.2f) + noise(random));
+        result->mHeightfieldShape = std::make_unique<btHeightfieldTerrainShape>(heightfieldSize, heightfieldSize,
+            result->mHeights.data(), 1, -500, 500, 2, PHY_FLOAT, false);
+        const btScalar scaling = cellSize / (heightfieldSize - 1);
+        result->mHeightfieldShape->setLocalScaling(btVector3(scaling, scaling, 1));
+        result->mHeightfield.setCollisionShape(result->mHeightfieldShape.get());
+        result->mCollisionWorld.addCollisionObject(&result->mHeightfield);
+
+        std::uniform_real_distribution<btScalar> horizontal(-cellSize / 2, cellSize / 2);
+        result->mActors.reserve(actors);
+        for (std::size_t i = 0; i < actors; ++i)
+            result->mActors.emplace_back(horizontal(random), horizontal(random), 600);
+
+        return result;
+    }
+
+    std::size_t simulateActor(const World& world, std::size_t index)
+    {
+        const btVector3& position = world.mActors[index];
+        const std::size_t sweeps = index % stuckActorsInterval == 0 ? sweepsPerStuckActor : sweepsPerActor;
+        std::size_t hits = 0;
+        for (std::size_t i = 0; i < sweeps; ++i)
+        {
+            const btScalar angle = static_cast<btScalar>(i) * 0.7f;
+            const btVector3 to = position + btVector3(std::cos(angle) * 100, std::sin(angle) * 100, -1400);
+            btCollisionWorld::ClosestConvexResultCallback callback(position, to);
+            btTransform fromTransform(btQuaternion::getIdentity(), position);
+            btTransform toTransform(btQuaternion::getIdentity(), to);
+            world.mCollisionWorld.convexSweepTest(&world.mActorShape, fromTransform, toTransform, callback);
+            if (callback.hasHit())
+                ++hits;
+        }
+        return hits;
+    }
+
+    // The scheme used by PhysicsTaskScheduler before: all workers take one job at a time from the same counter
+    class SharedCounter
+    {
+    public:
+        explicit SharedCounter(std::size_t /*workers*/) {}
+
+        void reset(std::size_t count)
+        {
+            mCount = count;
+            mNext.store(0, std::memory_order_relaxed);
+        }
+
+        std::pair<std::size_t, std::size_t> take(std::size_t /*worker*/)
+        {
+            const std::size_t job = mNext.fetch_add(1, std::memory_order_relaxed);
+            if (job >= mCount)
+                return { 0, 0 };
+            return { job, job + 1 };
+        }
+
+    private:
+        std::size_t mCount = 0;
+        std::atomic<std::size_t> mNext{ 0 };
+    };
+
+    template <class Scheduler>
+    std::size_t work(const World& world, Scheduler& scheduler, std::size_t worker)
+    {
+        std::size_t hits = 0;
+        while (true)
+        {
+            const auto [begin, end] = scheduler.take(worker);
+            if (begin == end)
+                break;
+            for (std::size_t job = begin; job < end; ++job)
+                hits += simulateActor(world, job);
+        }
+        return hits;
+    }
+
+    // Each iteration is a single simulation step, the calling thread participates like the main thread does for
+    // PhysicsTaskScheduler without async threads
+    template <class Scheduler>
+    void simulate(benchmark::State& state)
+    {
+        const std::size_t actors = static_cast<std::size_t>(state.range(0));
+        const std::size_t workers = static_cast<std::size_t>(state.range(1));
+        const std::unique_ptr<World> world = makeWorld(actors);
+        if (workers > static_cast<std::size_t>(world->mBroadphase.m_rayTestStacks.size()))
+        {
+            state.SkipWithError("Bullet is not compiled with multithreading support");
+            return;
+        }
+        Scheduler scheduler(workers);
+        Misc::Barrier stepStart(static_cast<unsigned>(workers));
+        Misc::Barrier stepEnd(static_cast<unsigned>(workers));
+        bool quit = false;
+        std::atomic<std::size_t> hits{ 0 };
+
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < workers; ++i)
+            threads.emplace_back([&, i] {
+                while (true)
+                {
+                    stepStart.wait([] {});
+                    if (quit)
+                        return;
+                    hits += work(*world, scheduler, i);
+                    stepEnd.wait([] {});
+                }
+            });
+
+        std::vector<double> durations;
+        for (auto _ : state)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            // Other workers are done with the previous step and wait for the next one
+            scheduler.reset(actors);
+            stepStart.wait([] {});
+            hits += work(*world, scheduler, 0);
+            stepEnd.wait([] {});
+            const auto duration = std::chrono::steady_clock::now() - start;
+            durations.push_back(std::chrono::duration<double, std::micro>(duration).count());
+        }
+
+        quit = true;
+        stepStart.wait([] {});
+        for (std::thread& thread : threads)
+            thread.join();
+
+        benchmark::DoNotOptimize(hits.load());
+        std::sort(durations.begin(), durations.end());
+        if (!durations.empty())
+        {
+            state.counters["p50_us"] = durations[durations.size() / 2];
+            state.counters["p99_us"] = durations[durations.size() * 99 / 100];
+            state.counters["max_us"] = durations.back();
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * actors));
+    }
+
+    void sharedCounter(benchmark::State& state)
+    {
+        simulate<SharedCounter>(state);
+    }
+
+    void workStealingRanges(benchmark::State& state)
+    {
+        simulate<Misc::WorkStealingRanges>(state);
+    }
+
+    void arguments(benchmark::internal::Benchmark* benchmark)
+    {
+        for (std::int64_t actors : { 32, 128, 512 })
+            for (std::int64_t workers : { 1, 2, 4, 8 })
+                benchmark->Args({ actors, workers });
+        benchmark->UseRealTime();
+    }
+}
+
+BENCHMARK(sharedCounter)->Apply(arguments);
+BENCHMARK(workStealingRanges)->Apply(arguments);
+
+BENCHMARK_MAIN();
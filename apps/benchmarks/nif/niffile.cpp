@@ -0,0 +1,159 @@
+#include <benchmark/benchmark.h>
+
+#include <components/files/memorystream.hpp>
+#include <components/nif/niffile.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+
+namespace
+{
+    class NifWriter
+    {
+    public:
+        template <class T>
+        void write(T value)
+        {
+            mData.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        void writeChars(std::string_view value) { mData += value; }
+
+        void writeString(std::string_view value)
+        {
+            write(static_cast<std::uint32_t>(value.size()));
+            writeChars(value);
+        }
+
+        void writeFloats(std::size_t count, std::minstd_rand& random)
+        {
+            std::uniform_real_distribution<float> distribution(-1000, 1000);
+            for (std::size_t i = 0; i < count; ++i)
+                write(distribution(random));
+        }
+
+        void writeNode(std::string_view name)
+        {
+            writeString(name);
+            write<std::int32_t>(-1); // Extra data
+            write<std::int32_t>(-1); // Controller
+            write<std::uint16_t>(0); // Flags
+            for (float value : { 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f, 1.f })
+                write(value); // Translation, rotation and scale
+            for (int i = 0; i < 3; ++i)
+                write(0.f); // Velocity
+            write<std::int32_t>(0); // Properties
+            write<std::int32_t>(0); // Has bounds
+        }
+
+        std::string release() { return std::move(mData); }
+
+    private:
+        std::string mData;
+    };
+
+    /// Generates a Morrowind format NIF file with a root node and the given number of triangle shapes
+    std::string generateNif(std::size_t shapes, std::size_t vertices, std::minstd_rand& random)
+    {
+        NifWriter writer;
+        writer.writeChars("NetImmerse File Format, Version 4.0.0.2\n");
+        writer.write<std::uint32_t>(0x04000002);
+        writer.write(static_cast<std::uint32_t>(1 + 2 * shapes));
+
+        writer.writeString("NiNode");
+        writer.writeNode("Root");
+        writer.write(static_cast<std::int32_t>(shapes));
+        for (std::size_t i = 0; i < shapes; ++i)
+            writer.write(static_cast<std::int32_t>(1 + 2 * i));
+        writer.write<std::int32_t>(0); // Effects
+
+        const std::size_t triangles = vertices - 2;
+        for (std::size_t i = 0; i < shapes; ++i)
+        {
+            writer.writeString("NiTriShape");
+            writer.writeNode("Shape" + std::to_string(i));
+            writer.write(static_cast<std::int32_t>(2 + 2 * i)); // Data
+            writer.write<std::int32_t>(-1); // Skin instance
+
+            writer.writeString("NiTriShapeData");
+            writer.write(static_cast<std::uint16_t>(vertices));
+            writer.write<std::int32_t>(1); // Has vertices
+            writer.writeFloats(vertices * 3, random);
+            writer.write<std::int32_t>(1); // Has normals
+            writer.writeFloats(vertices * 3, random);
+            writer.writeFloats(4, random); // Center and radius
+            writer.write<std::int32_t>(1); // Has vertex colors
+            writer.writeFloats(vertices * 4, random);
+            writer.write<std::uint16_t>(1); // UV sets
+            writer.write<std::int32_t>(1); // Has UV
+            writer.writeFloats(vertices * 2, random);
+            writer.write(static_cast<std::uint16_t>(triangles));
+            writer.write(static_cast<std::int32_t>(triangles * 3));
+            for (std::size_t j = 0; j < triangles; ++j)
+                for (std::size_t k = 0; k < 3; ++k)
+                    writer.write(static_cast<std::uint16_t>(j + k));
+            writer.write<std::uint16_t>(0); // Match groups
+        }
+
+        writer.write<std::uint32_t>(1); // Roots
+        writer.write<std::int32_t>(0);
+
+        return writer.release();
+    }
+
+    const std::string& getNif()
+    {
+        static const std::string nif = [] {
+            std::minstd_rand random;
+            return generateNif(16, 1000, random);
+        }();
+        return nif;
+    }
+
+    const std::filesystem::path& getNifPath()
+    {
+        static const std::filesystem::path path = [] {
+            auto result = std::filesystem::temp_directory_path() / "openmw_niffile_benchmark.nif";
+            std::ofstream(result, std::ios::binary) << getNif();
+            return result;
+        }();
+        return path;
+    }
+
+    template <class MakeStream>
+    void parse(benchmark::State& state, MakeStream&& makeStream)
+    {
+        for (auto _ : state)
+        {
+            Nif::NIFFile file("test.nif");
+            Nif::Reader reader(file);
+            reader.parse(makeStream());
+            benchmark::DoNotOptimize(file.mRecords.data());
+        }
+
+        state.SetItemsProcessed(state.iterations());
+        state.SetBytesProcessed(state.iterations() * getNif().size());
+    }
+
+    void parseFromMemoryBuffer(benchmark::State& state)
+    {
+        const std::string& nif = getNif();
+        parse(state, [&] { return std::make_unique<Files::IMemStream>(nif.data(), nif.size()); });
+    }
+
+    void parseFromFile(benchmark::State& state)
+    {
+        const std::filesystem::path& path = getNifPath();
+        parse(state, [&] { return std::make_unique<std::ifstream>(path, std::ios::binary); });
+    }
+}
+
+BENCHMARK(parseFromMemoryBuffer);
+BENCHMARK(parseFromFile);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,182 @@
+#include <benchmark/benchmark.h>
+
+#include <components/misc/strings/lower.hpp>
+#include <components/vfs/fileindex.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace VFS;
+
+    constexpr const char* directories[] = { "meshes/", "textures/", "icons/", "sound/", "music/", "splash/" };
+
+    template <class Random>
+    std::string generatePath(Random& random)
+    {
+        std::uniform_int_distribution<std::size_t> directory(0, std::size(directories) - 1);
+        std::uniform_int_distribution<int> depth(0, 3);
+        std::uniform_int_distribution<int> length(3, 16);
+        std::uniform_int_distribution<int> letter('a', 'z');
+        std::string result = directories[directory(random)];
+        const int parts = depth(random) + 1;
+        for (int i = 0; i < parts; ++i)
+        {
+            if (i != 0)
+                result += '/';
+            std::generate_n(
+                std::back_inserter(result), length(random), [&] { return static_cast<char>(letter(random)); });
+        }
+        result += ".nif";
+        return result;
+    }
+
+    template <class Random>
+    std::map<std::string, File*> generateFiles(std::size_t count, Random& random)
+    {
+        std::map<std::string, File*> result;
+        while (result.size() < count)
+            result.emplace(generatePath(random), reinterpret_cast<File*>(result.size() + 1));
+        return result;
+    }
+
+    // Not normalized version of the path as it usually comes from the content files
+    std::string denormalize(std::string path)
+    {
+        std::transform(path.begin(), path.end(), path.begin(), [](char v) { return v == '/' ? '\\' : v; });
+        if (!path.empty())
+            path[0] = static_cast<char>(std::toupper(path[0]));
+        return path;
+    }
+
+    template <class Random>
+    std::vector<std::string> generateQueries(
+        const std::map<std::string, File*>& files, int hitPercentage, Random& random)
+    {
+        std::vector<std::string> result;
+        std::uniform_int_distribution<int> percent(0, 99);
+        for (const auto& [path, file] : files)
+        {
+            if (percent(random) < hitPercentage)
+                result.push_back(denormalize(path));
+            else
+                result.push_back(denormalize(generatePath(random)));
+        }
+        std::shuffle(result.begin(), result.end(), random);
+        return result;
+    }
+
+    // Reproduces lookup through std::map used before VFS::FileIndex
+    File* findInMap(const std::map<std::string, File*>& files, std::string_view name)
+    {
+        std::string normalized(name);
+        std::transform(normalized.begin(), normalized.end(), normalized.begin(),
+            [](char v) { return v == '\\' ? '/' : Misc::StringUtils::toLower(v); });
+        const auto it = files.find(normalized);
+        if (it == files.end())
+            return nullptr;
+        return it->second;
+    }
+
+    template <int hitPercentage>
+    void findInStdMap(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const std::map<std::string, File*> files = generateFiles(state.range(0), random);
+        const std::vector<std::string> queries = generateQueries(files, hitPercentage, random);
+        std::size_t n = 0;
+
+        for (auto _ : state)
+        {
+            File* const result = findInMap(files, queries[n++ % queries.size()]);
+            benchmark::DoNotOptimize(result);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    template <int hitPercentage>
+    void findInFileIndex(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        std::map<std::string, File*> files = generateFiles(state.range(0), random);
+        const std::vector<std::string> queries = generateQueries(files, hitPercentage, random);
+        FileIndex index(false);
+        index.assign(std::move(files));
+        std::size_t n = 0;
+
+        for (auto _ : state)
+        {
+            File* const result = index.find(queries[n++ % queries.size()]);
+            benchmark::DoNotOptimize(result);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void iterateStdMapDirectory(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const std::map<std::string, File*> files = generateFiles(state.range(0), random);
+        std::size_t n = 0;
+        std::size_t items = 0;
+
+        for (auto _ : state)
+        {
+            std::string prefix = directories[n++ % std::size(directories)];
+            const auto first = files.lower_bound(prefix);
+            ++prefix.back();
+            const auto last = files.lower_bound(prefix);
+            for (auto it = first; it != last; ++it, ++items)
+                benchmark::DoNotOptimize(it->first.size());
+        }
+
+        state.SetItemsProcessed(items);
+    }
+
+    void iterateFileIndexDirectory(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        FileIndex index(false);
+        index.assign(generateFiles(state.range(0), random));
+        std::size_t n = 0;
+        std::size_t items = 0;
+
+        for (auto _ : state)
+        {
+            const auto [first, last] = index.findPrefix(directories[n++ % std::size(directories)]);
+            for (auto it = first; it != last; ++it, ++items)
+                benchmark::DoNotOptimize(it->first.size());
+        }
+
+        state.SetItemsProcessed(items);
+    }
+
+    void buildFileIndex(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const std::map<std::string, File*> files = generateFiles(state.range(0), random);
+
+        for (auto _ : state)
+        {
+            FileIndex index(false);
+            index.assign(std::map<std::string, File*>(files));
+            benchmark::DoNotOptimize(index.size());
+        }
+    }
+}
+
+BENCHMARK(findInStdMap<100>)->Range(1 << 10, 1 << 19);
+BENCHMARK(findInFileIndex<100>)->Range(1 << 10, 1 << 19);
+BENCHMARK(findInStdMap<50>)->Range(1 << 10, 1 << 19);
+BENCHMARK(findInFileIndex<50>)->Range(1 << 10, 1 << 19);
+BENCHMARK(iterateStdMapDirectory)->Range(1 << 10, 1 << 19);
+BENCHMARK(iterateFileIndexDirectory)->Range(1 << 10, 1 << 19);
+BENCHMARK(buildFileIndex)->Range(1 << 10, 1 << 19);
+
+BENCHMARK_MAIN();
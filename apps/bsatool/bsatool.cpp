@@ -1,7 +1,9 @@
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <thread>
 #include <vector>
 
 #include <boost/program_options.hpp>
@@ -240,33 +242,46 @@ int extract(std::unique_ptr<File>& bsa, Arguments& info)
 template <typename File>
 int extractAll(std::unique_ptr<File>& bsa, Arguments& info)
 {
-    for (const auto& file : bsa->getList())
-    {
-        std::string extractPath(file.name());
-        Misc::StringUtils::replaceAll(extractPath, "\\", "/");
+    // Decompress files concurrently but limit the number of them kept in memory
+    constexpr std::size_t chunkSize = 256;
+    const std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
 
-        // Get the target path (the path the file will be extracted to)
-        auto target = info.outdir;
-        target /= Misc::StringUtils::stringToU8String(extractPath);
+    const auto& list = bsa->getList();
+    std::vector<const Bsa::BSAFile::FileStruct*> chunk;
+    for (auto it = list.begin(); it != list.end();)
+    {
+        chunk.clear();
+        for (; it != list.end() && chunk.size() < chunkSize; ++it)
+            chunk.push_back(&*it);
 
-        // Create the directory hierarchy
-        std::filesystem::create_directories(target.parent_path());
+        const std::vector<Files::IStreamPtr> streams = bsa->getFiles(chunk, threads);
 
-        std::filesystem::file_status s = std::filesystem::status(target.parent_path());
-        if (!std::filesystem::is_directory(s))
+        for (std::size_t i = 0; i < chunk.size(); ++i)
         {
-            std::cout << "ERROR: " << target.parent_path() << " is not a directory." << std::endl;
-            return 3;
-        }
+            std::string extractPath(chunk[i]->name());
+            Misc::StringUtils::replaceAll(extractPath, "\\", "/");
+
+            // Get the target path (the path the file will be extracted to)
+            auto target = info.outdir;
+            target /= Misc::StringUtils::stringToU8String(extractPath);
 
-        // Get a stream for the file to extract
-        Files::IStreamPtr data = bsa->getFile(&file);
-        std::ofstream out(target, std::ios::binary);
+            // Create the directory hierarchy
+            std::filesystem::create_directories(target.parent_path());
 
-        // Write the file to disk
-        std::cout << "Extracting " << Files::pathToUnicodeString(target) << std::endl;
-        out << data->rdbuf();
-        out.close();
+            std::filesystem::file_status s = std::filesystem::status(target.parent_path());
+            if (!std::filesystem::is_directory(s))
+            {
+                std::cout << "ERROR: " << target.parent_path() << " is not a directory." << std::endl;
+                return 3;
+            }
+
+            std::ofstream out(target, std::ios::binary);
+
+            // Write the file to disk
+            std::cout << "Extracting " << Files::pathToUnicodeString(target) << std::endl;
+            out << streams[i]->rdbuf();
+            out.close();
+        }
     }
 
     return 0;
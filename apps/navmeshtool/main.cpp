@@ -10,6 +10,7 @@
 #include <components/detournavigator/settings.hpp>
 #include <components/esm3/readerscache.hpp>
 #include <components/esm3/variant.hpp>
+#include <components/esmloader/cache.hpp>
 #include <components/esmloader/esmdata.hpp>
 #include <components/esmloader/load.hpp>
 #include <components/fallback/fallback.hpp>
@@ -127,6 +128,9 @@ namespace NavMeshTool
             addOption("write-binary-log", bpo::value<bool>()->implicit_value(true)->default_value(false),
                 "write progress in binary messages to be consumed by the launcher");
 
+            addOption("esm-data-cache", bpo::value<bool>()->implicit_value(true)->default_value(false),
+                "reuse parsed content files data from the cache in the user data directory when they are unchanged");
+
             Files::ConfigurationManager::addCommonOptions(result);
 
             return result;
@@ -187,6 +191,7 @@ namespace NavMeshTool
             const bool processInteriorCells = variables["process-interior-cells"].as<bool>();
             const bool removeUnusedTiles = variables["remove-unused-tiles"].as<bool>();
             const bool writeBinaryLog = variables["write-binary-log"].as<bool>();
+            const bool esmDataCache = variables["esm-data-cache"].as<bool>();
 
 #ifdef WIN32
             if (writeBinaryLog)
@@ -222,8 +227,11 @@ namespace NavMeshTool
             query.mLoadGameSettings = true;
             query.mLoadLands = true;
             query.mLoadStatics = true;
-            const EsmLoader::EsmData esmData
-                = EsmLoader::loadEsmData(query, contentFiles, fileCollections, readers, &encoder);
+            const EsmLoader::EsmData esmData = esmDataCache
+                ? EsmLoader::loadCachedEsmData(config.getUserDataPath() / "navmeshtool-esmdata.cache", query,
+                    contentFiles, fileCollections, readers, &encoder, nullptr, threadsNumber)
+                : EsmLoader::loadEsmData(
+                    query, contentFiles, fileCollections, readers, &encoder, nullptr, threadsNumber);
 
             Resource::ImageManager imageManager(&vfs);
             Resource::NifFileManager nifFileManager(&vfs);
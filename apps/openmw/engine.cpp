@@ -323,6 +323,7 @@ bool OMW::Engine::frame(float frametime)
         mMechanicsManager->reportStats(frameNumber, *stats);
         mWorld->reportStats(frameNumber, *stats);
         mLuaManager->reportStats(frameNumber, *stats);
+        mScriptManager->reportStats(frameNumber, *stats);
     }
 
     mViewer->eventTraversal();
@@ -691,7 +692,7 @@ void OMW::Engine::prepareEngine()
     mL10nManager->setPreferredLocales(Settings::Manager::getStringArray("preferred locales", "General"));
     mEnvironment.setL10nManager(*mL10nManager);
 
-    mLuaManager = std::make_unique<MWLua::LuaManager>(mVFS.get(), mResDir / "lua_libs");
+    mLuaManager = std::make_unique<MWLua::LuaManager>(mVFS.get(), mResDir / "lua_libs", mWorkQueue.get());
     mEnvironment.setLuaManager(*mLuaManager);
 
     // starts a separate lua thread if "lua num threads" > 0
@@ -796,7 +797,7 @@ void OMW::Engine::prepareEngine()
     mEnvironment.setScriptManager(*mScriptManager);
 
     // Create game mechanics system
-    mMechanicsManager = std::make_unique<MWMechanics::MechanicsManager>();
+    mMechanicsManager = std::make_unique<MWMechanics::MechanicsManager>(mWorkQueue.get());
     mEnvironment.setMechanicsManager(*mMechanicsManager);
 
     // Create dialog system
@@ -959,11 +960,13 @@ void OMW::Engine::go()
     }
 
     mLuaWorker->join();
+    mStateManager->finishSave(true);
 
     // Save user settings
     Settings::Manager::saveUser(mCfgMgr.getUserConfigPath() / "settings.cfg");
     Settings::ShaderManager::get().save();
     mLuaManager->savePermanentStorage(mCfgMgr.getUserConfigPath());
+    mLuaManager->writeHandlersProfile(mCfgMgr.getUserConfigPath() / "luahandlers.folded");
 
     Log(Debug::Info) << "Quitting peacefully.";
 }
@@ -38,6 +38,11 @@ namespace Loading
     class Listener;
 }
 
+namespace MWMechanics
+{
+    class PathgridSearchQueue;
+}
+
 namespace MWBase
 {
     /// \brief Interface for game mechanics manager (implemented in MWMechanics)
@@ -284,6 +289,9 @@ namespace MWBase
         virtual float getAngleToPlayer(const MWWorld::Ptr& ptr) const = 0;
         virtual MWMechanics::GreetingState getGreetingState(const MWWorld::Ptr& ptr) const = 0;
         virtual bool isTurningToPlayer(const MWWorld::Ptr& ptr) const = 0;
+
+        /// Pathgrid searches done within a limited budget per frame, results are available on the next frames
+        virtual MWMechanics::PathgridSearchQueue& getPathgridSearchQueue() = 0;
     };
 }
 
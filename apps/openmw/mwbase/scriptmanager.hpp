@@ -3,6 +3,11 @@
 
 #include <string_view>
 
+namespace osg
+{
+    class Stats;
+}
+
 namespace Interpreter
 {
     class Context;
@@ -59,6 +64,9 @@ namespace MWBase
         virtual MWScript::GlobalScripts& getGlobalScripts() = 0;
 
         virtual const Compiler::Extensions& getExtensions() const = 0;
+
+        virtual void reportStats(unsigned int frameNumber, osg::Stats& stats) = 0;
+        ///< Report script execution stats collected since the previous call (only if script profiler is enabled).
     };
 }
 
@@ -488,6 +488,9 @@ namespace MWBase
         virtual bool getLOS(const MWWorld::ConstPtr& actor, const MWWorld::ConstPtr& targetActor) = 0;
         ///< get Line of Sight (morrowind stupid implementation)
 
+        virtual void requestLOS(const MWWorld::ConstPtr& actor, const MWWorld::ConstPtr& targetActor) = 0;
+        ///< check Line of Sight in background to make getLOS result ready for the next frame
+
         virtual float getDistToNearestRayHit(
             const osg::Vec3f& from, const osg::Vec3f& dir, float maxDist, bool includeWater = false)
             = 0;
@@ -645,6 +648,11 @@ namespace MWBase
         /// Return terrain height at \a worldPos position.
         virtual float getTerrainHeightAt(const osg::Vec3f& worldPos) const = 0;
 
+        /// Same as getTerrainHeightAt for multiple positions. Positions within the same cell should go one after
+        /// another.
+        virtual void getTerrainHeightsAt(
+            std::span<const osg::Vec3f> worldPositions, std::span<float> heights) const = 0;
+
         /// Return physical or rendering half extents of the given actor.
         virtual osg::Vec3f getHalfExtents(const MWWorld::ConstPtr& actor, bool rendering = false) const = 0;
 
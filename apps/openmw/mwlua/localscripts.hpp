@@ -24,6 +24,7 @@ namespace MWLua
 
         MWBase::LuaManager::ActorControls* getActorControls() { return &mData.mControls; }
         const MWWorld::Ptr& getPtr() const { return mData.ptr(); }
+        const LuaUtil::LuaState& getLuaState() const { return mLua; }
 
         struct SelfObject : public LObject
         {
@@ -1,6 +1,11 @@
 #include "luamanagerimp.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
 
 #include <osg/Stats>
 
@@ -22,6 +27,8 @@
 #include <components/lua_ui/content.hpp>
 #include <components/lua_ui/util.hpp>
 
+#include <components/sceneutil/workqueue.hpp>
+
 #include "../mwbase/windowmanager.hpp"
 
 #include "../mwrender/postprocessor.hpp"
@@ -47,22 +54,48 @@ namespace MWLua
         return { .mInstructionLimit = Settings::Manager::getUInt64("instruction limit per call", "Lua"),
             .mMemoryLimit = Settings::Manager::getUInt64("memory limit", "Lua"),
             .mSmallAllocMaxSize = Settings::Manager::getUInt64("small alloc max size", "Lua"),
-            .mLogMemoryUsage = Settings::Manager::getBool("log memory usage", "Lua") };
+            .mLogMemoryUsage = Settings::Manager::getBool("log memory usage", "Lua"),
+            .mProfileHandlers = Settings::Manager::getBool("lua handlers profiler", "Lua") };
+    }
+
+    thread_local LuaManager::LocalState* LuaManager::sCurrentLocalState = nullptr;
+
+    LuaManager::LocalState::LocalState(const VFS::Manager* vfs, const LuaUtil::ScriptsConfiguration* conf,
+        const LuaUtil::LuaStateSettings& settings)
+        : mLua(vfs, conf, settings)
+    {
     }
 
-    LuaManager::LuaManager(const VFS::Manager* vfs, const std::filesystem::path& libsDir)
+    LuaManager::LuaManager(
+        const VFS::Manager* vfs, const std::filesystem::path& libsDir, SceneUtil::WorkQueue* workQueue)
         : mLua(vfs, &mConfiguration, createLuaStateSettings())
         , mUiResourceManager(vfs)
+        , mWorkQueue(workQueue)
     {
         Log(Debug::Info) << "Lua version: " << LuaUtil::getLuaVersion();
         mLua.addInternalLibSearchPath(libsDir);
 
+        const int localStateCount = Settings::Manager::getInt("lua parallel local states", "Lua");
+        if (localStateCount > 0)
+        {
+            Log(Debug::Info) << "Local scripts of non-player objects are distributed among " << localStateCount
+                             << " additional Lua states";
+            LuaUtil::LuaStateSettings settings = mLua.getSettings();
+            settings.mProfileHandlers = false; // only the main state is profiled
+            for (int i = 0; i < localStateCount; ++i)
+            {
+                mLocalStates.push_back(std::make_unique<LocalState>(vfs, &mConfiguration, settings));
+                mLocalStates.back()->mLua.addInternalLibSearchPath(libsDir);
+            }
+        }
+
         mGlobalSerializer = createUserdataSerializer(false);
         mLocalSerializer = createUserdataSerializer(true);
         mGlobalLoader = createUserdataSerializer(false, &mContentFileMapping);
         mLocalLoader = createUserdataSerializer(true, &mContentFileMapping);
 
         mGlobalScripts.setSerializer(mGlobalSerializer.get());
+        mGlobalScripts.setTimers(&mTimers);
     }
 
     void LuaManager::initConfiguration()
@@ -115,10 +148,74 @@ namespace MWLua
         mPostprocessingPackage = initPostprocessingPackage(localContext);
         mDebugPackage = initDebugPackage(localContext);
 
+        for (const std::unique_ptr<LocalState>& state : mLocalStates)
+            initLocalState(*state);
+
         initConfiguration();
         mInitialized = true;
     }
 
+    void LuaManager::initLocalState(LocalState& state)
+    {
+        Context context;
+        context.mIsGlobal = false;
+        context.mLuaManager = this;
+        context.mLua = &state.mLua;
+        context.mWorldView = &mWorldView;
+        context.mLocalEventQueue = &state.mLocalEvents;
+        context.mGlobalEventQueue = &state.mGlobalEvents;
+        context.mSerializer = mLocalSerializer.get();
+
+        initObjectBindingsForLocalScripts(context);
+        initCellBindingsForLocalScripts(context);
+        LocalScripts::initializeSelfPackage(context);
+
+        // Storage is not available here: it belongs to the main state and can be changed by global scripts.
+        state.mLua.addCommonPackage("openmw.async",
+            LuaUtil::getAsyncPackageInitializer(
+                state.mLua.sol(), [this] { return mWorldView.getSimulationTime(); },
+                [this] { return mWorldView.getGameTime(); }));
+        state.mLua.addCommonPackage("openmw.util", LuaUtil::initUtilPackage(state.mLua.sol()));
+        state.mLua.addCommonPackage("openmw.core", initCorePackage(context));
+        state.mLua.addCommonPackage("openmw.types", initTypesPackage(context));
+        state.mNearbyPackage = initNearbyPackage(context);
+    }
+
+    LuaManager::LocalState* LuaManager::getLocalState(const MWWorld::Ptr& ptr)
+    {
+        // Player scripts use UI, input and camera, so they always stay in the main state
+        if (mLocalStates.empty() || getLiveCellRefType(ptr.mRef) == ESM::REC_INTERNAL_PLAYER)
+            return nullptr;
+        return mLocalStates[getId(ptr).mIndex % mLocalStates.size()].get();
+    }
+
+    LuaManager::LocalState* LuaManager::findLocalState(const LocalScripts& scripts)
+    {
+        for (const std::unique_ptr<LocalState>& state : mLocalStates)
+            if (&state->mLua == &scripts.getLuaState())
+                return state.get();
+        return nullptr;
+    }
+
+    template <class Function>
+    void LuaManager::updateLocalStates(Function&& function)
+    {
+        SceneUtil::parallelFor(mWorkQueue, mLocalStates.size(), [&](std::size_t i) {
+            LocalState& state = *mLocalStates[i];
+            sCurrentLocalState = &state;
+            try
+            {
+                function(state);
+            }
+            catch (...)
+            {
+                sCurrentLocalState = nullptr;
+                throw;
+            }
+            sCurrentLocalState = nullptr;
+        });
+    }
+
     void LuaManager::loadPermanentStorage(const std::filesystem::path& userConfigPath)
     {
         const auto globalPath = userConfigPath / "global_storage.bin";
@@ -158,27 +255,49 @@ namespace MWLua
 
         mWorldView.update();
 
-        std::erase_if(mActiveLocalScripts,
-            [](const LocalScripts* l) { return l->getPtr().isEmpty() || l->getPtr().getRefData().isDeleted(); });
+        for (auto it = mActiveLocalScripts.begin(); it != mActiveLocalScripts.end();)
+        {
+            LocalScripts* scripts = *it;
+            if (scripts->getPtr().isEmpty() || scripts->getPtr().getRefData().isDeleted())
+            {
+                scripts->setTimersActive(false);
+                it = mActiveLocalScripts.erase(it);
+            }
+            else
+                ++it;
+        }
+
+        // Local scripts of additional states are processed by updateLocalStates
+        mActiveMainLocalScripts.clear();
+        for (const std::unique_ptr<LocalState>& state : mLocalStates)
+            state->mActiveScripts.clear();
+        for (LocalScripts* scripts : mActiveLocalScripts)
+        {
+            if (LocalState* state = findLocalState(*scripts))
+                state->mActiveScripts.push_back(scripts);
+            else
+                mActiveMainLocalScripts.push_back(scripts);
+        }
 
         mGlobalScripts.statsNextFrame();
         for (LocalScripts* scripts : mActiveLocalScripts)
             scripts->statsNextFrame();
+        if (LuaUtil::HandlersProfiler* profiler = mLua.getHandlersProfiler())
+            profiler->nextFrame();
 
         std::vector<GlobalEvent> globalEvents = std::move(mGlobalEvents);
         std::vector<LocalEvent> localEvents = std::move(mLocalEvents);
         mGlobalEvents = std::vector<GlobalEvent>();
         mLocalEvents = std::vector<LocalEvent>();
 
-        if (!mWorldView.isPaused())
-        { // Update time and process timers
-            double simulationTime = mWorldView.getSimulationTime() + frameDuration;
+        const bool paused = mWorldView.isPaused();
+        double simulationTime = mWorldView.getSimulationTime();
+        const double gameTime = mWorldView.getGameTime();
+        if (!paused)
+        { // Update time and process timers of global scripts and local scripts in mLua
+            simulationTime += frameDuration;
             mWorldView.setSimulationTime(simulationTime);
-            double gameTime = mWorldView.getGameTime();
-
-            mGlobalScripts.processTimers(simulationTime, gameTime);
-            for (LocalScripts* scripts : mActiveLocalScripts)
-                scripts->processTimers(simulationTime, gameTime);
+            mTimers.processTimers(simulationTime, gameTime);
         }
 
         // Receive events
@@ -188,13 +307,25 @@ namespace MWLua
         {
             LObject obj(e.mDest);
             LocalScripts* scripts = obj.isValid() ? obj.ptr().getRefData().getLuaScripts() : nullptr;
-            if (scripts)
-                scripts->receiveEvent(e.mEventName, e.mEventData);
-            else
+            if (!scripts)
                 Log(Debug::Debug) << "Ignored event " << e.mEventName << " to L" << idToString(e.mDest)
                                   << ". Object not found or has no attached scripts";
+            else if (LocalState* state = findLocalState(*scripts))
+                state->mReceivedEvents.emplace_back(scripts, std::move(e));
+            else
+                scripts->receiveEvent(e.mEventName, e.mEventData);
         }
 
+        updateLocalStates([&](LocalState& state) {
+            if (gcStepCount > 0)
+                lua_gc(state.mLua.sol(), LUA_GCSTEP, gcStepCount);
+            if (!paused)
+                state.mTimers.processTimers(simulationTime, gameTime);
+            for (auto& [scripts, e] : state.mReceivedEvents)
+                scripts->receiveEvent(e.mEventName, e.mEventData);
+            state.mReceivedEvents.clear();
+        });
+
         // Run queued callbacks
         for (CallbackWithData& c : mQueuedCallbacks)
             c.mCallback.tryCall(c.mArg);
@@ -212,17 +343,43 @@ namespace MWLua
                 continue;
             }
             LocalScripts* scripts = obj.ptr().getRefData().getLuaScripts();
-            if (scripts)
+            if (!scripts)
+                continue;
+            if (LocalState* state = findLocalState(*scripts))
+                state->mEngineEvents.emplace_back(scripts, e.mEvent);
+            else
                 scripts->receiveEngineEvent(e.mEvent);
         }
         mLocalEngineEvents.clear();
 
-        if (!mWorldView.isPaused())
+        if (!paused)
         {
-            for (LocalScripts* scripts : mActiveLocalScripts)
+            for (LocalScripts* scripts : mActiveMainLocalScripts)
                 scripts->update(frameDuration);
         }
 
+        updateLocalStates([&](LocalState& state) {
+            for (const auto& [scripts, e] : state.mEngineEvents)
+                scripts->receiveEngineEvent(e);
+            state.mEngineEvents.clear();
+            if (!paused)
+            {
+                for (LocalScripts* scripts : state.mActiveScripts)
+                    scripts->update(frameDuration);
+            }
+        });
+
+        // Changes made by scripts in additional states are merged in a fixed order
+        for (const std::unique_ptr<LocalState>& state : mLocalStates)
+        {
+            std::move(state->mGlobalEvents.begin(), state->mGlobalEvents.end(), std::back_inserter(mGlobalEvents));
+            std::move(state->mLocalEvents.begin(), state->mLocalEvents.end(), std::back_inserter(mLocalEvents));
+            std::move(state->mActionQueue.begin(), state->mActionQueue.end(), std::back_inserter(mActionQueue));
+            state->mGlobalEvents.clear();
+            state->mLocalEvents.clear();
+            state->mActionQueue.clear();
+        }
+
         // Engine handlers in global scripts
         if (mPlayerChanged)
         {
@@ -298,7 +455,10 @@ namespace MWLua
         mUiResourceManager.clear();
         MWBase::Environment::get().getWindowManager()->setConsoleMode("");
         MWBase::Environment::get().getWorld()->getPostProcessor()->disableDynamicShaders();
+        for (LocalScripts* scripts : mActiveLocalScripts)
+            scripts->setTimersActive(false);
         mActiveLocalScripts.clear();
+        mActiveMainLocalScripts.clear();
         mLocalEvents.clear();
         mGlobalEvents.clear();
         mInputEvents.clear();
@@ -319,6 +479,15 @@ namespace MWLua
         mPlayerStorage.clearTemporaryAndRemoveCallbacks();
         for (int i = 0; i < 5; ++i)
             lua_gc(mLua.sol(), LUA_GCCOLLECT, 0);
+        for (const std::unique_ptr<LocalState>& state : mLocalStates)
+        {
+            state->mGlobalEvents.clear();
+            state->mLocalEvents.clear();
+            state->mActionQueue.clear();
+            state->mActiveScripts.clear();
+            for (int i = 0; i < 5; ++i)
+                lua_gc(state->mLua.sol(), LUA_GCCOLLECT, 0);
+        }
     }
 
     void LuaManager::setupPlayer(const MWWorld::Ptr& ptr)
@@ -336,6 +505,7 @@ namespace MWLua
             localScripts->addAutoStartedScripts();
         }
         mActiveLocalScripts.insert(localScripts);
+        localScripts->setTimersActive(true);
         mLocalEngineEvents.push_back({ getId(ptr), LocalScripts::OnActive{} });
         mPlayerChanged = true;
     }
@@ -373,6 +543,7 @@ namespace MWLua
         if (localScripts)
         {
             mActiveLocalScripts.insert(localScripts);
+            localScripts->setTimersActive(true);
             mLocalEngineEvents.push_back({ getId(ptr), LocalScripts::OnActive{} });
         }
 
@@ -387,6 +558,7 @@ namespace MWLua
         if (localScripts)
         {
             mActiveLocalScripts.erase(localScripts);
+            localScripts->setTimersActive(false);
             if (!MWBase::Environment::get().getWorldModel()->getPtr(getId(ptr)).isEmpty())
                 mLocalEngineEvents.push_back({ getId(ptr), LocalScripts::OnInactive{} });
         }
@@ -419,7 +591,10 @@ namespace MWLua
             localScripts = createLocalScripts(ptr);
             localScripts->addAutoStartedScripts();
             if (ptr.isInCell() && MWBase::Environment::get().getWorldScene()->isCellActive(*ptr.getCell()))
+            {
                 mActiveLocalScripts.insert(localScripts);
+                localScripts->setTimersActive(true);
+            }
         }
         localScripts->addCustomScript(scriptId, initData);
     }
@@ -430,6 +605,7 @@ namespace MWLua
         assert(mInitialized);
         std::shared_ptr<LocalScripts> scripts;
         const uint32_t type = getLiveCellRefType(ptr.mRef);
+        LocalState* const state = getLocalState(ptr);
         if (type == ESM::REC_STAT)
             throw std::runtime_error("Lua scripts on static objects are not allowed");
         else if (type == ESM::REC_INTERNAL_PLAYER)
@@ -445,14 +621,18 @@ namespace MWLua
         }
         else
         {
-            scripts = std::make_shared<LocalScripts>(&mLua, LObject(getId(ptr)));
+            scripts = std::make_shared<LocalScripts>(state != nullptr ? &state->mLua : &mLua, LObject(getId(ptr)));
             if (!autoStartConf.has_value())
                 autoStartConf = mConfiguration.getLocalConf(type, ptr.getCellRef().getRefId(), getId(ptr));
             scripts->setAutoStartConf(std::move(*autoStartConf));
-            scripts->addPackage("openmw.storage", mLocalStoragePackage);
+            if (state == nullptr)
+                scripts->addPackage("openmw.storage", mLocalStoragePackage);
         }
-        scripts->addPackage("openmw.nearby", mNearbyPackage);
+        scripts->addPackage("openmw.nearby", state != nullptr ? state->mNearbyPackage : mNearbyPackage);
         scripts->setSerializer(mLocalSerializer.get());
+        // Timers are processed only while the object is in mActiveLocalScripts
+        scripts->setTimers(state != nullptr ? &state->mTimers : &mTimers);
+        scripts->setTimersActive(false);
 
         MWWorld::RefData& refData = ptr.getRefData();
         refData.setLuaScripts(std::move(scripts));
@@ -524,6 +704,8 @@ namespace MWLua
         MWBase::Environment::get().getL10nManager()->dropCache();
         mUiResourceManager.clear();
         mLua.dropScriptCache();
+        for (const std::unique_ptr<LocalState>& state : mLocalStates)
+            state->mLua.dropScriptCache();
         initConfiguration();
 
         { // Reload global scripts
@@ -614,12 +796,45 @@ namespace MWLua
 
     void LuaManager::addAction(std::function<void()> action, std::string_view name)
     {
-        mActionQueue.push_back(std::make_unique<FunctionAction>(&mLua, std::move(action), name));
+        LuaUtil::LuaState* lua = sCurrentLocalState != nullptr ? &sCurrentLocalState->mLua : &mLua;
+        addAction(std::make_unique<FunctionAction>(lua, std::move(action), name));
+    }
+
+    void LuaManager::addAction(std::unique_ptr<Action>&& action)
+    {
+        if (sCurrentLocalState != nullptr)
+            sCurrentLocalState->mActionQueue.push_back(std::move(action));
+        else
+            mActionQueue.push_back(std::move(action));
     }
 
     void LuaManager::reportStats(unsigned int frameNumber, osg::Stats& stats) const
     {
-        stats.setAttribute(frameNumber, "Lua UsedMemory", mLua.getTotalMemoryUsage());
+        uint64_t usedMemory = mLua.getTotalMemoryUsage();
+        for (const std::unique_ptr<LocalState>& state : mLocalStates)
+            usedMemory += state->mLua.getTotalMemoryUsage();
+        stats.setAttribute(frameNumber, "Lua UsedMemory", usedMemory);
+        if (const LuaUtil::HandlersProfiler* profiler = mLua.getHandlersProfiler())
+        {
+            stats.setAttribute(frameNumber, "Lua Handler Calls", profiler->getFrameCalls());
+            stats.setAttribute(frameNumber, "Lua Handler Time",
+                std::chrono::duration<double, std::milli>(profiler->getFrameTime()).count());
+        }
+    }
+
+    void LuaManager::writeHandlersProfile(const std::filesystem::path& path) const
+    {
+        const LuaUtil::HandlersProfiler* profiler = mLua.getHandlersProfiler();
+        if (profiler == nullptr)
+            return;
+        std::ofstream stream(path);
+        if (!stream)
+        {
+            Log(Debug::Error) << "Failed to open " << path << " to write Lua handlers profile";
+            return;
+        }
+        profiler->writeCollapsedStacks(mConfiguration, stream);
+        Log(Debug::Info) << "Lua handlers profile is written to " << path;
     }
 
     std::string LuaManager::formatResourceUsageStats() const
@@ -645,19 +860,31 @@ namespace MWLua
                 out << (bytes / (1024 * 1024 * 1024)) << " GB";
         };
 
+        // Scripts of non-player objects can be distributed among additional states
+        auto sumOverStates = [&](auto&& getValue) {
+            int64_t result = getValue(mLua);
+            for (const std::unique_ptr<LocalState>& state : mLocalStates)
+                result += getValue(state->mLua);
+            return result;
+        };
+        const int64_t totalMemoryUsage
+            = sumOverStates([](const LuaUtil::LuaState& lua) { return lua.getTotalMemoryUsage(); });
+        const int64_t smallAllocMemoryUsage
+            = sumOverStates([](const LuaUtil::LuaState& lua) { return lua.getSmallAllocMemoryUsage(); });
+
         static const uint64_t smallAllocSize = Settings::Manager::getUInt64("small alloc max size", "Lua");
         out << "Total memory usage:";
-        outMemSize(mLua.getTotalMemoryUsage());
+        outMemSize(totalMemoryUsage);
         out << "\n";
         out << "LuaUtil::ScriptsContainer count: " << LuaUtil::ScriptsContainer::getInstanceCount() << "\n";
         out << "\n";
         out << "small alloc max size = " << smallAllocSize << " (section [Lua] in settings.cfg)\n";
         out << "Smaller values give more information for the profiler, but increase performance overhead.\n";
         out << "  Memory allocations <= " << smallAllocSize << " bytes:";
-        outMemSize(mLua.getSmallAllocMemoryUsage());
+        outMemSize(smallAllocMemoryUsage);
         out << " (not tracked)\n";
         out << "  Memory allocations >  " << smallAllocSize << " bytes:";
-        outMemSize(mLua.getTotalMemoryUsage() - mLua.getSmallAllocMemoryUsage());
+        outMemSize(totalMemoryUsage - smallAllocMemoryUsage);
         out << " (see the table below)\n\n";
 
         using Stats = LuaUtil::ScriptsContainer::ScriptStats;
@@ -717,7 +944,9 @@ namespace MWLua
             out << std::right;
             out << std::setw(valueW) << static_cast<int64_t>(activeStats[i].mAvgInstructionCount);
             outMemSize(activeStats[i].mMemoryUsage);
-            outMemSize(mLua.getMemoryUsageByScriptIndex(i) - activeStats[i].mMemoryUsage);
+            const int64_t memoryUsage = sumOverStates(
+                [i](const LuaUtil::LuaState& lua) { return lua.getMemoryUsageByScriptIndex(i); });
+            outMemSize(memoryUsage - activeStats[i].mMemoryUsage);
 
             if (isGlobal)
                 out << std::setw(valueW * 2) << "NA (global script)";
@@ -736,6 +965,49 @@ namespace MWLua
             out << "\n";
         }
 
+        if (const LuaUtil::HandlersProfiler* profiler = mLua.getHandlersProfiler())
+        {
+            constexpr std::size_t maxHandlers = 20;
+            const std::vector<LuaUtil::HandlersProfiler::HandlerStats> handlerStats = profiler->getStats();
+
+            out << "\n";
+            out << std::left;
+            out << " " << std::setw(nameW + 2) << "*** Time per handler";
+            out << std::right;
+            out << std::setw(valueW) << "avg ms";
+            out << std::setw(valueW) << "ms";
+            out << std::setw(valueW) << "calls";
+            out << std::setw(valueW) << "total ms";
+            out << "\n";
+            out << std::left << " " << std::setw(nameW + 2) << "[name]" << std::right;
+            out << std::setw(valueW) << "";
+            out << std::setw(valueW * 2) << "[last frame]";
+            out << "\n";
+
+            for (std::size_t i = 0; i < std::min(handlerStats.size(), maxHandlers); ++i)
+            {
+                const LuaUtil::HandlersProfiler::HandlerStats& v = handlerStats[i];
+                std::string name = mConfiguration[v.mScriptId].mScriptPath;
+                name += ' ';
+                name += LuaUtil::getHandlerTypeName(v.mType);
+                if (!v.mName.empty())
+                {
+                    name += ':';
+                    name += v.mName;
+                }
+                out << std::left;
+                out << " " << std::setw(nameW) << name;
+                if (name.size() > nameW)
+                    out << "\n " << std::setw(nameW) << ""; // if name is too long, break line
+                out << std::right << std::fixed << std::setprecision(3);
+                out << std::setw(valueW) << v.mAvgFrameTime * 1000;
+                out << std::setw(valueW) << std::chrono::duration<double, std::milli>(v.mFrameTime).count();
+                out << std::setw(valueW) << v.mFrameCalls;
+                out << std::setw(valueW) << std::chrono::duration<double, std::milli>(v.mTotalTime).count();
+                out << "\n";
+            }
+        }
+
         return out.str();
     }
 }
@@ -20,13 +20,18 @@
 #include "object.hpp"
 #include "worldview.hpp"
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace MWLua
 {
 
     class LuaManager : public MWBase::LuaManager
     {
     public:
-        LuaManager(const VFS::Manager* vfs, const std::filesystem::path& libsDir);
+        LuaManager(const VFS::Manager* vfs, const std::filesystem::path& libsDir, SceneUtil::WorkQueue* workQueue);
 
         // Called by engine.cpp when the environment is fully initialized.
         void init();
@@ -82,7 +87,7 @@ namespace MWLua
         };
 
         void addAction(std::function<void()> action, std::string_view name = "");
-        void addAction(std::unique_ptr<Action>&& action) { mActionQueue.push_back(std::move(action)); }
+        void addAction(std::unique_ptr<Action>&& action);
         void addTeleportPlayerAction(std::unique_ptr<Action>&& action) { mTeleportPlayerAction = std::move(action); }
 
         // Saving
@@ -123,8 +128,39 @@ namespace MWLua
         void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
         std::string formatResourceUsageStats() const override;
 
+        // Writes time spent in Lua handlers in the collapsed stack format. Does nothing if
+        // the handlers profiler is disabled.
+        void writeHandlersProfile(const std::filesystem::path& path) const;
+
     private:
+        // Additional Lua state with local scripts of a part of non-player objects. All such states are updated in
+        // parallel, so the scripts can only read the game world. Events and actions produced by them are queued
+        // separately and merged in the order of the states when the update is finished.
+        struct LocalState
+        {
+            LocalState(const VFS::Manager* vfs, const LuaUtil::ScriptsConfiguration* conf,
+                const LuaUtil::LuaStateSettings& settings);
+
+            LuaUtil::LuaState mLua;
+            LuaUtil::ScriptsTimers mTimers;
+            sol::table mNearbyPackage;
+
+            GlobalEventQueue mGlobalEvents;
+            LocalEventQueue mLocalEvents;
+            std::vector<std::unique_ptr<Action>> mActionQueue;
+
+            // Filled before every update
+            std::vector<LocalScripts*> mActiveScripts;
+            std::vector<std::pair<LocalScripts*, LocalEvent>> mReceivedEvents;
+            std::vector<std::pair<LocalScripts*, LocalScripts::EngineEvent>> mEngineEvents;
+        };
+
         void initConfiguration();
+        void initLocalState(LocalState& state);
+        LocalState* getLocalState(const MWWorld::Ptr& ptr);
+        LocalState* findLocalState(const LocalScripts& scripts);
+        template <class Function>
+        void updateLocalStates(Function&& function);
         LocalScripts* createLocalScripts(const MWWorld::Ptr& ptr,
             std::optional<LuaUtil::ScriptIdsWithInitializationData> autoStartConf = std::nullopt);
 
@@ -143,8 +179,15 @@ namespace MWLua
         sol::table mPostprocessingPackage;
         sol::table mDebugPackage;
 
+        LuaUtil::ScriptsTimers mTimers; // timers of all containers in mLua
         GlobalScripts mGlobalScripts{ &mLua };
         std::set<LocalScripts*> mActiveLocalScripts;
+        std::vector<LocalScripts*> mActiveMainLocalScripts; // the part of mActiveLocalScripts in mLua
+
+        SceneUtil::WorkQueue* mWorkQueue;
+        std::vector<std::unique_ptr<LocalState>> mLocalStates;
+        // The state which is updated by the current thread; its scripts queue actions there.
+        static thread_local LocalState* sCurrentLocalState;
         WorldView mWorldView;
 
         bool mPlayerChanged = false;
@@ -1,5 +1,6 @@
 #include "actors.hpp"
 
+#include <algorithm>
 #include <optional>
 
 #include <components/esm3/esmreader.hpp>
@@ -10,6 +11,7 @@
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/rng.hpp>
 #include <components/sceneutil/positionattitudetransform.hpp>
+#include <components/sceneutil/workqueue.hpp>
 #include <components/settings/settings.hpp>
 
 #include <components/esm3/loadcrea.hpp>
@@ -54,6 +56,11 @@
 
 namespace
 {
+    constexpr float actorsGridCellSize = 1024;
+
+    // Limits the time spent on pathgrid searches for wandering actors per frame. A search over a large interior
+    // pathgrid usually expands less than a few hundred points.
+    constexpr std::size_t maxPathgridSearchExpansionsPerFrame = 1000;
 
     bool isConscious(const MWWorld::Ptr& ptr)
     {
@@ -1164,8 +1171,10 @@ namespace MWMechanics
         }
     }
 
-    Actors::Actors()
-        : mSmoothMovement(Settings::Manager::getBool("smooth movement", "Game"))
+    Actors::Actors(SceneUtil::WorkQueue* workQueue)
+        : mActorsGrid(actorsGridCellSize)
+        , mWorkQueue(workQueue)
+        , mSmoothMovement(Settings::Manager::getBool("smooth movement", "Game"))
     {
         mTimerDisposeSummonsCorpses
             = 0.2f; // We should add a delay between summoned creature death and its corpse despawning
@@ -1173,6 +1182,90 @@ namespace MWMechanics
         updateProcessingRange();
     }
 
+    void Actors::updateActorsGrid() const
+    {
+        if (!mActorsGridOutdated)
+            return;
+        mActorsGrid.clear();
+        mActorsTable.mActors.clear();
+        mActorsTable.mPositions.clear();
+        for (const Actor& actor : mActors)
+        {
+            const osg::Vec3f position = actor.getPtr().getRefData().getPosition().asVec3();
+            mActorsGrid.add(position, mActorsTable.mActors.size());
+            mActorsTable.mActors.push_back(&actor);
+            mActorsTable.mPositions.push_back(position);
+        }
+        mActorsGrid.build();
+        mActorsGridOutdated = false;
+    }
+
+    void Actors::rateCombatTargets(const MWWorld::Ptr& player, const osg::Vec3f& playerPos)
+    {
+        // Targets are found on the main thread because it may require to search the world
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < mActorsTable.mActors.size(); ++i)
+        {
+            const MWWorld::Ptr& ptr = mActorsTable.mActors[i]->getPtr();
+            if (ptr == player || !isConscious(ptr)
+                || (playerPos - mActorsTable.mPositions[i]).length2() > mActorsProcessingRange * mActorsProcessingRange)
+                continue;
+            const AiSequence& sequence = ptr.getClass().getCreatureStats(ptr).getAiSequence();
+            if (!sequence.hasCombatTargetsToRate())
+                continue;
+            if (count == mCombatTargetRatings.size())
+                mCombatTargetRatings.emplace_back();
+            mCombatTargetRatings[count].first = mActorsTable.mActors[i];
+            sequence.getCombatTargets(mCombatTargetRatings[count].second);
+            ++count;
+        }
+        mCombatTargetRatings.resize(count);
+        mUsedCombatTargetRatings = 0;
+
+        SceneUtil::parallelFor(mWorkQueue, count, [&](std::size_t i) {
+            MWMechanics::rateCombatTargets(mCombatTargetRatings[i].first->getPtr(), mCombatTargetRatings[i].second);
+        });
+    }
+
+    const CombatTargetRatings* Actors::getCombatTargetRatings(const Actor& actor)
+    {
+        if (mUsedCombatTargetRatings >= mCombatTargetRatings.size()
+            || mCombatTargetRatings[mUsedCombatTargetRatings].first != &actor)
+            return nullptr;
+        return &mCombatTargetRatings[mUsedCombatTargetRatings++].second;
+    }
+
+    osg::Vec3f Actors::getActorPosition(const Actor& actor, std::size_t index) const
+    {
+        // Actors list may be changed during the update, then the table doesn't match it until the next rebuild
+        if (!mActorsGridOutdated && index < mActorsTable.mActors.size() && mActorsTable.mActors[index] == &actor)
+            return mActorsTable.mPositions[index];
+        return actor.getPtr().getRefData().getPosition().asVec3();
+    }
+
+    template <class Function>
+    void Actors::forEachActorInRange(const osg::Vec3f& position, float radius, Function&& function) const
+    {
+        updateActorsGrid();
+        // Actors might have moved since the grid is updated, so the actual position is used to check the distance.
+        // Found actors are sorted to preserve the order in which they are processed without the grid.
+        const float radius2 = radius * radius;
+        std::vector<std::size_t> found;
+        mActorsGrid.forEachInSquare(position, radius, [&](std::size_t index, const osg::Vec3f& /*gridPosition*/) {
+            if ((mActorsTable.mActors[index]->getPtr().getRefData().getPosition().asVec3() - position).length2()
+                <= radius2)
+                found.push_back(index);
+        });
+        std::sort(found.begin(), found.end());
+        // The function may query actors again and rebuild the grid, so indices are resolved before calling it.
+        std::vector<const Actor*> actors;
+        actors.reserve(found.size());
+        for (std::size_t index : found)
+            actors.push_back(mActorsTable.mActors[index]);
+        for (const Actor* actor : actors)
+            function(*actor);
+    }
+
     float Actors::getProcessingRange() const
     {
         return mActorsProcessingRange;
@@ -1198,6 +1291,7 @@ namespace MWMechanics
             return;
         const auto it = mActors.emplace(mActors.end(), ptr, anim);
         mIndex.emplace(ptr.mRef, it);
+        mActorsGridOutdated = true;
 
         if (updateImmediately)
             it->getCharacterController().update(0);
@@ -1249,6 +1343,7 @@ namespace MWMechanics
                 removeTemporaryEffects(iter->second->getPtr());
             mActors.erase(iter->second);
             mIndex.erase(iter);
+            mActorsGridOutdated = true;
         }
     }
 
@@ -1294,7 +1389,10 @@ namespace MWMechanics
     {
         const auto iter = mIndex.find(old.mRef);
         if (iter != mIndex.end())
+        {
             iter->second->updatePtr(ptr);
+            mActorsGridOutdated = true;
+        }
     }
 
     void Actors::dropActors(const MWWorld::CellStore* cellStore, const MWWorld::Ptr& ignore)
@@ -1306,6 +1404,7 @@ namespace MWMechanics
                 removeTemporaryEffects(iter->getPtr());
                 mIndex.erase(iter->getPtr().mRef);
                 iter = mActors.erase(iter);
+                mActorsGridOutdated = true;
             }
             else
                 ++iter;
@@ -1431,12 +1530,11 @@ namespace MWMechanics
             osg::Vec2f movementCorrection(0, 0);
             float angleToApproachingActor = 0;
 
-            // Iterate through all other actors and predict collisions.
-            for (const Actor& otherActor : mActors)
-            {
+            // Iterate through other actors close enough and predict collisions.
+            forEachActorInRange(basePos, maxDistToCheck, [&](const Actor& otherActor) {
                 const MWWorld::Ptr& otherPtr = otherActor.getPtr();
                 if (otherPtr == ptr || otherPtr == currentTarget)
-                    continue;
+                    return;
 
                 const osg::Vec3f otherHalfExtents = world->getHalfExtents(otherPtr);
                 const osg::Vec3f deltaPos = otherPtr.getRefData().getPosition().asVec3() - basePos;
@@ -1445,11 +1543,11 @@ namespace MWMechanics
 
                 // Ignore actors which are not close enough or come from behind.
                 if (dist > maxDistToCheck || relPos.y() < 0)
-                    continue;
+                    return;
 
                 // Don't check for a collision if vertical distance is greater then the actor's height.
                 if (deltaPos.z() > halfExtents.z() * 2 || deltaPos.z() < -otherHalfExtents.z() * 2)
-                    continue;
+                    return;
 
                 const osg::Vec3f speed = otherPtr.getClass().getMovementSettings(otherPtr).asVec3()
                     * otherPtr.getClass().getMaxSpeed(otherPtr);
@@ -1465,17 +1563,17 @@ namespace MWMechanics
                 const float v2 = relSpeed.length2();
                 const float Dh = vr * vr - v2 * (relPos.length2() - collisionDist * collisionDist);
                 if (Dh <= 0 || v2 == 0)
-                    continue; // No solution; distance is always >= collisionDist.
+                    return; // No solution; distance is always >= collisionDist.
                 const float t = (-vr - std::sqrt(Dh)) / v2;
 
                 if (t < 0 || t > timeToCollision)
-                    continue;
+                    return;
 
                 // Check visibility and awareness last as it's expensive.
                 if (!MWBase::Environment::get().getWorld()->getLOS(otherPtr, ptr))
-                    continue;
+                    return;
                 if (!MWBase::Environment::get().getMechanicsManager()->awarenessCheck(otherPtr, ptr))
-                    continue;
+                    return;
 
                 timeToCollision = t;
                 angleToApproachingActor = std::atan2(deltaPos.x(), deltaPos.y());
@@ -1489,7 +1587,7 @@ namespace MWMechanics
                 if (otherPtr.getClass().getCreatureStats(otherPtr).isDead())
                     // In case of dead body still try to go around (it looks natural), but reduce the correction twice.
                     movementCorrection.y() *= 0.5f;
-            }
+            });
 
             if (timeToCollision < timeToCheck)
             {
@@ -1527,6 +1625,10 @@ namespace MWMechanics
             if (mTimerUpdateEquippedLight >= updateEquippedLightInterval)
                 mTimerUpdateEquippedLight = 0;
 
+            // Actors have moved since the previous frame
+            mActorsGridOutdated = true;
+            updateActorsGrid();
+
             // show torches only when there are darkness and no precipitations
             MWBase::World* const world = MWBase::Environment::get().getWorld();
             const bool showTorches = world->useTorches();
@@ -1540,6 +1642,11 @@ namespace MWMechanics
                 cachedAllies; // will be filled as engageCombat iterates
 
             const bool aiActive = MWBase::Environment::get().getMechanicsManager()->isAIActive();
+            if (aiActive)
+                rateCombatTargets(player, playerPos);
+            else
+                mCombatTargetRatings.clear();
+
             const int attackedByPlayerId = player.getClass().getCreatureStats(player).getHitAttemptActorId();
             if (attackedByPlayerId != -1)
             {
@@ -1551,6 +1658,7 @@ namespace MWMechanics
             const bool godmode = MWBase::Environment::get().getWorld()->getGodModeState();
 
             // AI and magic effects update
+            std::size_t actorIndex = 0;
             for (Actor& actor : mActors)
             {
                 const bool isPlayer = actor.getPtr() == player;
@@ -1558,9 +1666,10 @@ namespace MWMechanics
                 MWBase::LuaManager::ActorControls* luaControls
                     = MWBase::Environment::get().getLuaManager()->getActorControls(actor.getPtr());
 
-                const float distSqr = (playerPos - actor.getPtr().getRefData().getPosition().asVec3()).length2();
+                const float distSqr = (playerPos - getActorPosition(actor, actorIndex++)).length2();
                 // AI processing is only done within given distance to the player.
                 const bool inProcessingRange = distSqr <= mActorsProcessingRange * mActorsProcessingRange;
+                const CombatTargetRatings* const combatTargetRatings = getCombatTargetRatings(actor);
 
                 // If dead or no longer in combat, no longer store any actors who attempted to hit us. Also remove for
                 // the player.
@@ -1609,15 +1718,17 @@ namespace MWMechanics
                     {
                         if (engageCombatTimerStatus == Misc::TimerStatus::Elapsed)
                         {
-                            if (!isPlayer)
+                            if (!isPlayer) // player is not AI-controlled
+                            {
                                 adjustCommandedActor(actor.getPtr());
 
-                            for (const Actor& otherActor : mActors)
-                            {
-                                if (otherActor.getPtr() == actor.getPtr() || isPlayer) // player is not AI-controlled
-                                    continue;
-                                engageCombat(
-                                    actor.getPtr(), otherActor.getPtr(), cachedAllies, otherActor.getPtr() == player);
+                                // engageCombat ignores actors outside of processing range
+                                const osg::Vec3f position = actor.getPtr().getRefData().getPosition().asVec3();
+                                forEachActorInRange(position, mActorsProcessingRange, [&](const Actor& otherActor) {
+                                    if (otherActor.getPtr() != actor.getPtr())
+                                        engageCombat(actor.getPtr(), otherActor.getPtr(), cachedAllies,
+                                            otherActor.getPtr() == player);
+                                });
                             }
                         }
                         if (mTimerUpdateHeadTrack == 0)
@@ -1631,7 +1742,8 @@ namespace MWMechanics
                             CreatureStats& stats = actor.getPtr().getClass().getCreatureStats(actor.getPtr());
                             if (isConscious(actor.getPtr()) && !(luaControls && luaControls->mDisableAI))
                             {
-                                stats.getAiSequence().execute(actor.getPtr(), ctrl, duration);
+                                stats.getAiSequence().execute(
+                                    actor.getPtr(), ctrl, duration, /*outOfRange*/ false, combatTargetRatings);
                                 updateGreetingState(actor.getPtr(), actor, mTimerUpdateHello > 0);
                                 playIdleDialogue(actor.getPtr());
                                 updateMovementSpeed(actor.getPtr());
@@ -1659,6 +1771,8 @@ namespace MWMechanics
                 }
             }
 
+            mPathgridSearchQueue.update(maxPathgridSearchExpansionsPerFrame);
+
             static const bool avoidCollisions = Settings::Manager::getBool("NPCs avoid collisions", "Game");
             if (avoidCollisions)
                 predictAndAvoidCollisions(duration);
@@ -1670,9 +1784,10 @@ namespace MWMechanics
 
             // Animation/movement update
             CharacterController* playerCharacter = nullptr;
+            actorIndex = 0;
             for (Actor& actor : mActors)
             {
-                const float dist = (playerPos - actor.getPtr().getRefData().getPosition().asVec3()).length();
+                const float dist = (playerPos - getActorPosition(actor, actorIndex++)).length();
                 const bool isPlayer = actor.getPtr() == player;
                 CreatureStats& stats = actor.getPtr().getClass().getCreatureStats(actor.getPtr());
                 // Actors with active AI should be able to move.
@@ -2071,22 +2186,20 @@ namespace MWMechanics
 
     void Actors::getObjectsInRange(const osg::Vec3f& position, float radius, std::vector<MWWorld::Ptr>& out) const
     {
-        for (const Actor& actor : mActors)
-        {
-            if ((actor.getPtr().getRefData().getPosition().asVec3() - position).length2() <= radius * radius)
-                out.push_back(actor.getPtr());
-        }
+        forEachActorInRange(position, radius, [&](const Actor& actor) { out.push_back(actor.getPtr()); });
     }
 
     bool Actors::isAnyObjectInRange(const osg::Vec3f& position, float radius) const
     {
-        for (const Actor& actor : mActors)
-        {
-            if ((actor.getPtr().getRefData().getPosition().asVec3() - position).length2() <= radius * radius)
-                return true;
-        }
-
-        return false;
+        updateActorsGrid();
+        bool result = false;
+        mActorsGrid.forEachInSquare(position, radius, [&](std::size_t index, const osg::Vec3f& /*gridPosition*/) {
+            if (!result
+                && (mActorsTable.mActors[index]->getPtr().getRefData().getPosition().asVec3() - position).length2()
+                    <= radius * radius)
+                result = true;
+        });
+        return result;
     }
 
     std::vector<MWWorld::Ptr> Actors::getActorsSidingWith(const MWWorld::Ptr& actorPtr, bool excludeInfighting) const
@@ -2311,6 +2424,7 @@ namespace MWMechanics
     {
         mIndex.clear();
         mActors.clear();
+        mActorsGridOutdated = true;
         mDeathCount.clear();
     }
 
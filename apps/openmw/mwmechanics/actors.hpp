@@ -7,7 +7,10 @@
 #include <string>
 #include <vector>
 
+#include <components/misc/spatialgrid.hpp>
+
 #include "actor.hpp"
+#include "pathgridsearch.hpp"
 
 namespace ESM
 {
@@ -25,6 +28,11 @@ namespace Loading
     class Listener;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace MWWorld
 {
     class Ptr;
@@ -40,7 +48,7 @@ namespace MWMechanics
     class Actors
     {
     public:
-        Actors();
+        explicit Actors(SceneUtil::WorkQueue* workQueue);
 
         std::list<Actor>::const_iterator begin() const { return mActors.begin(); }
         std::list<Actor>::const_iterator end() const { return mActors.end(); }
@@ -169,6 +177,8 @@ namespace MWMechanics
         GreetingState getGreetingState(const MWWorld::Ptr& ptr) const;
         bool isTurningToPlayer(const MWWorld::Ptr& ptr) const;
 
+        PathgridSearchQueue& getPathgridSearchQueue() { return mPathgridSearchQueue; }
+
     private:
         enum class MusicType
         {
@@ -180,6 +190,25 @@ namespace MWMechanics
         std::map<ESM::RefId, int> mDeathCount;
         std::list<Actor> mActors;
         std::map<const MWWorld::LiveCellRefBase*, std::list<Actor>::iterator> mIndex;
+        // Hot per frame data of mActors packed into contiguous arrays in the same order. mActors remains the owner
+        // because it keeps pointers to other actors valid when actors are added or removed during the update.
+        struct ActorsTable
+        {
+            std::vector<const Actor*> mActors;
+            std::vector<osg::Vec3f> mPositions;
+        };
+
+        // Updated once per frame or after actors list is changed, grid values are mActorsTable indices.
+        mutable ActorsTable mActorsTable;
+        mutable Misc::SpatialGrid<std::size_t> mActorsGrid;
+        mutable bool mActorsGridOutdated = true;
+        // Used to run AI decisions not changing any state in parallel
+        SceneUtil::WorkQueue* mWorkQueue;
+        // Ratings of combat targets for actors in mActors order computed before the AI update
+        std::vector<std::pair<const Actor*, CombatTargetRatings>> mCombatTargetRatings;
+        std::size_t mUsedCombatTargetRatings = 0;
+        // Pathgrid searches requested by AI packages, continued after the AI update within a limited budget
+        PathgridSearchQueue mPathgridSearchQueue;
         float mTimerDisposeSummonsCorpses;
         float mTimerUpdateHeadTrack = 0;
         float mTimerUpdateEquippedLight = 0;
@@ -204,6 +233,20 @@ namespace MWMechanics
 
         void predictAndAvoidCollisions(float duration) const;
 
+        void updateActorsGrid() const;
+
+        void rateCombatTargets(const MWWorld::Ptr& player, const osg::Vec3f& playerPos);
+
+        /// Returns combat targets ratings computed by rateCombatTargets for the next actor in mActors order.
+        const CombatTargetRatings* getCombatTargetRatings(const Actor& actor);
+
+        /// Returns position of the actor with the given index in mActors from mActorsTable if it's up to date.
+        osg::Vec3f getActorPosition(const Actor& actor, std::size_t index) const;
+
+        /// Calls function(const Actor&) for each actor not further than radius from the position in mActors order.
+        template <class Function>
+        void forEachActorInRange(const osg::Vec3f& position, float radius, Function&& function) const;
+
         /** Start combat between two actors
             @Notes: If againstPlayer = true then actor2 should be the Player.
                     If one of the combatants is creature it should be actor1.
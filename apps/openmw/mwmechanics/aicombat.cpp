@@ -338,7 +338,12 @@ namespace MWMechanics
             storage.mUpdateLOSTimer = LOS_UPDATE_DURATION;
         }
         else
+        {
             storage.mUpdateLOSTimer -= duration;
+            // Let physics threads check it during this frame simulation
+            if (storage.mUpdateLOSTimer <= 0.f)
+                MWBase::Environment::get().getWorld()->requestLOS(actor, target);
+        }
     }
 
     void MWMechanics::AiCombat::updateFleeing(
@@ -20,6 +20,27 @@
 
 namespace MWMechanics
 {
+    namespace
+    {
+        float getCombatTargetRating(const CombatTargetRatings* ratings, const AiPackage& package,
+            const MWWorld::Ptr& actor, const MWWorld::Ptr& target)
+        {
+            if (ratings != nullptr)
+            {
+                const auto it = std::find_if(ratings->begin(), ratings->end(),
+                    [&](const CombatTargetRating& v) { return v.mPackage == &package && v.mTarget == target; });
+                if (it != ratings->end())
+                    return it->mRating;
+            }
+            return MWMechanics::getBestActionRating(actor, target);
+        }
+    }
+
+    void rateCombatTargets(const MWWorld::Ptr& actor, CombatTargetRatings& ratings)
+    {
+        for (CombatTargetRating& v : ratings)
+            v.mRating = getBestActionRating(actor, v.mTarget);
+    }
 
     void AiSequence::copy(const AiSequence& sequence)
     {
@@ -225,8 +246,27 @@ namespace MWMechanics
         }
     }
 
-    void AiSequence::execute(
-        const MWWorld::Ptr& actor, CharacterController& characterController, float duration, bool outOfRange)
+    bool AiSequence::hasCombatTargetsToRate() const
+    {
+        return mPackages.size() > 1 && mPackages[0]->getTypeId() == AiPackageTypeId::Combat
+            && mPackages[1]->getTypeId() == AiPackageTypeId::Combat;
+    }
+
+    void AiSequence::getCombatTargets(CombatTargetRatings& ratings) const
+    {
+        ratings.clear();
+        for (const auto& package : mPackages)
+        {
+            if (package->getTypeId() != AiPackageTypeId::Combat)
+                break;
+            const MWWorld::Ptr target = package->getTarget();
+            if (!target.isEmpty())
+                ratings.push_back(CombatTargetRating{ package.get(), target });
+        }
+    }
+
+    void AiSequence::execute(const MWWorld::Ptr& actor, CharacterController& characterController, float duration,
+        bool outOfRange, const CombatTargetRatings* ratings)
     {
         if (actor == getPlayer())
         {
@@ -257,6 +297,7 @@ namespace MWMechanics
             osg::Vec3f vActorPos = actor.getRefData().getPosition().asVec3();
 
             float bestRating = 0.f;
+            const bool rateTargets = hasCombatTargetsToRate();
 
             for (auto it = mPackages.begin(); it != mPackages.end();)
             {
@@ -272,7 +313,8 @@ namespace MWMechanics
                 }
                 else
                 {
-                    float rating = MWMechanics::getBestActionRating(actor, target);
+                    // Rating doesn't matter when there is only one target
+                    const float rating = rateTargets ? getCombatTargetRating(ratings, **it, actor, target) : 0.f;
 
                     const ESM::Position& targetPos = target.getRefData().getPosition();
 
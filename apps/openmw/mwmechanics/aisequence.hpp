@@ -10,10 +10,7 @@
 
 #include <components/esm3/loadnpc.hpp>
 
-namespace MWWorld
-{
-    class Ptr;
-}
+#include "../mwworld/ptr.hpp"
 
 namespace ESM
 {
@@ -30,6 +27,19 @@ namespace MWMechanics
 
     using AiPackages = std::vector<std::shared_ptr<AiPackage>>;
 
+    struct CombatTargetRating
+    {
+        const AiPackage* mPackage;
+        MWWorld::Ptr mTarget;
+        float mRating = 0;
+    };
+
+    /// Ratings of combat packages targets computed in advance, see AiSequence::getCombatTargets
+    using CombatTargetRatings = std::vector<CombatTargetRating>;
+
+    /// Fills mRating for each target. Doesn't change any state, so may be called for different actors in parallel.
+    void rateCombatTargets(const MWWorld::Ptr& actor, CombatTargetRatings& ratings);
+
     /// \brief Sequence of AI-packages for a single actor
     /** The top-most AI package is run each frame. When completed, it is removed from the stack. **/
     class AiSequence
@@ -144,9 +154,16 @@ namespace MWMechanics
         /// Removes all pursue packages until first non-pursue or stack empty.
         void stopPursuit();
 
+        /// Returns true if the active package is a combat package and execute will choose between multiple targets.
+        bool hasCombatTargetsToRate() const;
+
+        /// Get targets of the combat packages execute chooses from to be rated by rateCombatTargets.
+        void getCombatTargets(CombatTargetRatings& ratings) const;
+
         /// Execute current package, switching if needed.
+        /// @param ratings Result of rateCombatTargets, packages missing there are rated by execute.
         void execute(const MWWorld::Ptr& actor, CharacterController& characterController, float duration,
-            bool outOfRange = false);
+            bool outOfRange = false, const CombatTargetRatings* ratings = nullptr);
 
         /// Simulate the passing of time using the currently active AI package
         void fastForward(const MWWorld::Ptr& actor);
@@ -597,15 +597,27 @@ namespace MWMechanics
     void AiWander::setPathToAnAllowedNode(
         const MWWorld::Ptr& actor, AiWanderStorage& storage, const ESM::Position& actorPos)
     {
-        auto& prng = MWBase::Environment::get().getWorld()->getPrng();
-        unsigned int randNode = Misc::Rng::rollDice(storage.mAllowedNodes.size(), prng);
+        // Continue the search started by the previous call unless the node is gone
+        if (!storage.mSearchedNode.has_value() || *storage.mSearchedNode >= storage.mAllowedNodes.size())
+        {
+            auto& prng = MWBase::Environment::get().getWorld()->getPrng();
+            storage.mSearchedNode = Misc::Rng::rollDice(storage.mAllowedNodes.size(), prng);
+            mPathFinder.clearPath();
+        }
+
+        const std::size_t randNode = *storage.mSearchedNode;
         const ESM::Pathgrid::Point& dest = storage.mAllowedNodes[randNode];
 
         const osg::Vec3f start = actorPos.asVec3();
 
         // don't take shortcuts for wandering
         const osg::Vec3f destVec3f = PathFinder::makeOsgVec3(dest);
-        mPathFinder.buildPathByPathgrid(start, destVec3f, actor.getCell(), getPathGridGraph(actor.getCell()));
+        if (!mPathFinder.buildPathByPathgridAsync(start, destVec3f, actor.getCell(),
+                getPathGridGraph(actor.getCell()),
+                MWBase::Environment::get().getMechanicsManager()->getPathgridSearchQueue()))
+            return;
+
+        storage.mSearchedNode.reset();
 
         if (mPathFinder.isPathConstructed())
         {
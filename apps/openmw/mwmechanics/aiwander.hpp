@@ -3,6 +3,7 @@
 
 #include "typedaipackage.hpp"
 
+#include <optional>
 #include <vector>
 
 #include "aitemporarybase.hpp"
@@ -59,6 +60,9 @@ namespace MWMechanics
         ESM::Pathgrid::Point mCurrentNode;
         bool mTrimCurrentNode;
 
+        // index of the allowed node the path is being searched to
+        std::optional<std::size_t> mSearchedNode;
+
         float mCheckIdlePositionTimer;
         int mStuckCount;
 
@@ -272,11 +272,12 @@ namespace MWMechanics
         invStore.autoEquip();
     }
 
-    MechanicsManager::MechanicsManager()
+    MechanicsManager::MechanicsManager(SceneUtil::WorkQueue* workQueue)
         : mUpdatePlayer(true)
         , mClassSelected(false)
         , mRaceSelected(false)
         , mAI(true)
+        , mActors(workQueue)
     {
         // buildPlayer no longer here, needs to be done explicitly after all subsystems are up and running
     }
@@ -1965,4 +1966,9 @@ namespace MWMechanics
     {
         return mActors.isTurningToPlayer(ptr);
     }
+
+    PathgridSearchQueue& MechanicsManager::getPathgridSearchQueue()
+    {
+        return mActors.getPathgridSearchQueue();
+    }
 }
@@ -16,6 +16,11 @@ namespace MWWorld
     class CellStore;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace MWMechanics
 {
     class MechanicsManager : public MWBase::MechanicsManager
@@ -38,7 +43,7 @@ namespace MWMechanics
         ///< build player according to stored class/race/birthsign information. Will
         /// default to the values of the ESM::NPC object, if no explicit information is given.
 
-        MechanicsManager();
+        explicit MechanicsManager(SceneUtil::WorkQueue* workQueue);
 
         void add(const MWWorld::Ptr& ptr) override;
         ///< Register an object for management
@@ -234,6 +239,8 @@ namespace MWMechanics
         GreetingState getGreetingState(const MWWorld::Ptr& ptr) const override;
         bool isTurningToPlayer(const MWWorld::Ptr& ptr) const override;
 
+        PathgridSearchQueue& getPathgridSearchQueue() override;
+
     private:
         bool canCommitCrimeAgainst(const MWWorld::Ptr& victim, const MWWorld::Ptr& attacker);
         bool canReportCrime(
@@ -2,6 +2,7 @@
 
 #include <iterator>
 #include <limits>
+#include <span>
 
 #include <osg/io_utils>
 
@@ -21,6 +22,7 @@
 
 #include "actorutil.hpp"
 #include "pathgrid.hpp"
+#include "pathgridsearch.hpp"
 
 namespace
 {
@@ -186,6 +188,25 @@ namespace MWMechanics
      */
     void PathFinder::buildPathByPathgridImpl(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
         const PathgridGraph& pathgridGraph, std::back_insert_iterator<std::deque<osg::Vec3f>> out)
+    {
+        const std::optional<PathgridNodes> nodes = findPathgridNodes(startPoint, endPoint, pathgridGraph, out);
+        if (!nodes.has_value())
+            return;
+
+        // AiWander has logic that depends on whether a path was created,
+        // deleting allowed nodes if not.  Hence a path needs to be created
+        // even if the start and the end points are the same.
+        if (nodes->mStart == nodes->mEnd)
+            addPathgridPath(startPoint, endPoint, pathgridGraph, *nodes,
+                pathgridGraph.getPathPoints(std::span(&nodes->mStart, 1)), out);
+        else
+            addPathgridPath(startPoint, endPoint, pathgridGraph, *nodes,
+                pathgridGraph.aStarSearch(nodes->mStart, nodes->mEnd), out);
+    }
+
+    std::optional<PathFinder::PathgridNodes> PathFinder::findPathgridNodes(const osg::Vec3f& startPoint,
+        const osg::Vec3f& endPoint, const PathgridGraph& pathgridGraph,
+        std::back_insert_iterator<std::deque<osg::Vec3f>> out) const
     {
         const auto pathgrid = pathgridGraph.getPathgrid();
 
@@ -193,7 +214,7 @@ namespace MWMechanics
         // Maybe there is no pathgrid for this cell.  Just go to destination and let
         // physics take care of any blockages.
         if (!pathgrid || pathgrid->mPoints.empty())
-            return;
+            return std::nullopt;
 
         // NOTE: getClosestPoint expects local coordinates
         Misc::CoordinateConverter converter(*mCell->getCell());
@@ -218,58 +239,52 @@ namespace MWMechanics
         if ((startToEndLength2 < startTo1stNodeLength2) || (startToEndLength2 < endTolastNodeLength2))
         {
             *out++ = endPoint;
-            return;
+            return std::nullopt;
         }
 
-        // AiWander has logic that depends on whether a path was created,
-        // deleting allowed nodes if not.  Hence a path needs to be created
-        // even if the start and the end points are the same.
-        // NOTE: aStarSearch will return an empty path if the start and end
-        //       nodes are the same
-        if (startNode == endNode.first)
-        {
-            ESM::Pathgrid::Point temp(pathgrid->mPoints[startNode]);
-            converter.toWorld(temp);
-            *out++ = makeOsgVec3(temp);
-        }
-        else
-        {
-            auto path = pathgridGraph.aStarSearch(startNode, endNode.first);
+        return PathgridNodes{ startNode, endNode.first, endNode.second };
+    }
+
+    void PathFinder::addPathgridPath(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
+        const PathgridGraph& pathgridGraph, const PathgridNodes& nodes, std::deque<ESM::Pathgrid::Point> path,
+        std::back_insert_iterator<std::deque<osg::Vec3f>> out) const
+    {
+        const auto pathgrid = pathgridGraph.getPathgrid();
+        Misc::CoordinateConverter converter(*mCell->getCell());
 
-            // If nearest path node is in opposite direction from second, remove it from path.
-            // Especially useful for wandering actors, if the nearest node is blocked for some reason.
-            if (path.size() > 1)
+        // If nearest path node is in opposite direction from second, remove it from path.
+        // Especially useful for wandering actors, if the nearest node is blocked for some reason.
+        if (path.size() > 1)
+        {
+            ESM::Pathgrid::Point secondNode = *(++path.begin());
+            osg::Vec3f firstNodeVec3f = makeOsgVec3(pathgrid->mPoints[nodes.mStart]);
+            osg::Vec3f secondNodeVec3f = makeOsgVec3(secondNode);
+            osg::Vec3f toSecondNodeVec3f = secondNodeVec3f - firstNodeVec3f;
+            osg::Vec3f toStartPointVec3f = converter.toLocalVec3(startPoint) - firstNodeVec3f;
+            if (toSecondNodeVec3f * toStartPointVec3f > 0)
             {
-                ESM::Pathgrid::Point secondNode = *(++path.begin());
-                osg::Vec3f firstNodeVec3f = makeOsgVec3(pathgrid->mPoints[startNode]);
-                osg::Vec3f secondNodeVec3f = makeOsgVec3(secondNode);
-                osg::Vec3f toSecondNodeVec3f = secondNodeVec3f - firstNodeVec3f;
-                osg::Vec3f toStartPointVec3f = startPointInLocalCoords - firstNodeVec3f;
-                if (toSecondNodeVec3f * toStartPointVec3f > 0)
-                {
-                    ESM::Pathgrid::Point temp(secondNode);
-                    converter.toWorld(temp);
-                    // Add Z offset since path node can overlap with other objects.
-                    // Also ignore doors in raytesting.
-                    const int mask = MWPhysics::CollisionType_World;
-                    bool isPathClear = !MWBase::Environment::get()
-                                            .getWorld()
-                                            ->getRayCasting()
-                                            ->castRay(osg::Vec3f(startPoint.x(), startPoint.y(), startPoint.z() + 16),
-                                                osg::Vec3f(temp.mX, temp.mY, temp.mZ + 16), mask)
-                                            .mHit;
-                    if (isPathClear)
-                        path.pop_front();
-                }
+                ESM::Pathgrid::Point temp(secondNode);
+                converter.toWorld(temp);
+                // Add Z offset since path node can overlap with other objects.
+                // Also ignore doors in raytesting.
+                const int mask = MWPhysics::CollisionType_World;
+                bool isPathClear = !MWBase::Environment::get()
+                                        .getWorld()
+                                        ->getRayCasting()
+                                        ->castRay(osg::Vec3f(startPoint.x(), startPoint.y(), startPoint.z() + 16),
+                                            osg::Vec3f(temp.mX, temp.mY, temp.mZ + 16), mask)
+                                        .mHit;
+                if (isPathClear)
+                    path.pop_front();
             }
-
-            // convert supplied path to world coordinates
-            std::transform(path.begin(), path.end(), out, [&](ESM::Pathgrid::Point& point) {
-                converter.toWorld(point);
-                return makeOsgVec3(point);
-            });
         }
 
+        // convert supplied path to world coordinates
+        std::transform(path.begin(), path.end(), out, [&](ESM::Pathgrid::Point& point) {
+            converter.toWorld(point);
+            return makeOsgVec3(point);
+        });
+
         // If endNode found is NOT the closest PathGrid point to the endPoint,
         // assume endPoint is not reachable from endNode. In which case,
         // path ends at endNode.
@@ -282,7 +297,7 @@ namespace MWMechanics
         // unreachable pathgrid point.
         //
         // The AI routines will have to deal with such situations.
-        if (endNode.second)
+        if (nodes.mEndIsClosest)
             *out++ = endPoint;
     }
 
@@ -377,6 +392,43 @@ namespace MWMechanics
         mConstructed = !mPath.empty();
     }
 
+    bool PathFinder::buildPathByPathgridAsync(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
+        const MWWorld::CellStore* cell, const PathgridGraph& pathgridGraph, PathgridSearchQueue& queue)
+    {
+        if (!mPathgridSearch.has_value())
+        {
+            mPath.clear();
+            mCell = cell;
+            mConstructed = false;
+
+            const std::optional<PathgridNodes> nodes
+                = findPathgridNodes(startPoint, endPoint, pathgridGraph, std::back_inserter(mPath));
+            if (!nodes.has_value() || nodes->mStart == nodes->mEnd)
+            {
+                if (nodes.has_value())
+                    addPathgridPath(startPoint, endPoint, pathgridGraph, *nodes,
+                        pathgridGraph.getPathPoints(std::span(&nodes->mStart, 1)), std::back_inserter(mPath));
+                mConstructed = !mPath.empty();
+                return true;
+            }
+
+            mPathgridSearch = PendingPathgridSearch{ startPoint, endPoint, cell, &pathgridGraph, *nodes,
+                pathgridGraph.requestAStarSearch(nodes->mStart, nodes->mEnd, queue) };
+        }
+
+        if (mPathgridSearch->mResult->mStatus == PathgridSearchStatus::InProgress)
+            return false;
+
+        const PendingPathgridSearch search = std::move(*mPathgridSearch);
+        mPathgridSearch.reset();
+        mPath.clear();
+        mCell = search.mCell;
+        addPathgridPath(search.mStartPoint, search.mEndPoint, *search.mGraph, search.mNodes,
+            search.mGraph->getPathPoints(search.mResult->mPath), std::back_inserter(mPath));
+        mConstructed = !mPath.empty();
+        return true;
+    }
+
     void PathFinder::buildPathByNavMesh(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
         const osg::Vec3f& endPoint, const DetourNavigator::AgentBounds& agentBounds, const DetourNavigator::Flags flags,
         const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType)
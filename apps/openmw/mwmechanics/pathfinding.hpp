@@ -4,6 +4,8 @@
 #include <cassert>
 #include <deque>
 #include <iterator>
+#include <memory>
+#include <optional>
 
 #include <components/detournavigator/areatype.hpp>
 #include <components/detournavigator/flags.hpp>
@@ -26,6 +28,8 @@ namespace DetourNavigator
 namespace MWMechanics
 {
     class PathgridGraph;
+    class PathgridSearchQueue;
+    struct PathgridSearchResult;
 
     template <class T>
     inline float distance(const T& lhs, const T& rhs)
@@ -98,6 +102,7 @@ namespace MWMechanics
             mConstructed = false;
             mPath.clear();
             mCell = nullptr;
+            mPathgridSearch.reset();
         }
 
         void buildStraightPath(const osg::Vec3f& endPoint);
@@ -105,6 +110,14 @@ namespace MWMechanics
         void buildPathByPathgrid(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
             const MWWorld::CellStore* cell, const PathgridGraph& pathgridGraph);
 
+        /// Same as buildPathByPathgrid but the pathgrid search is done by the queue over the next frames.
+        /// Returns false while the search is in progress, the caller should call it again later. Arguments of these
+        /// calls are ignored, the search started by the first call is continued until clearPath is called.
+        bool buildPathByPathgridAsync(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
+            const MWWorld::CellStore* cell, const PathgridGraph& pathgridGraph, PathgridSearchQueue& queue);
+
+        bool isPathgridSearchInProgress() const { return mPathgridSearch.has_value(); }
+
         void buildPathByNavMesh(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
             const osg::Vec3f& endPoint, const DetourNavigator::AgentBounds& agentBounds,
             const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance,
@@ -205,13 +218,40 @@ namespace MWMechanics
         }
 
     private:
+        struct PathgridNodes
+        {
+            int mStart;
+            int mEnd;
+            // end node is the closest one to the end point
+            bool mEndIsClosest;
+        };
+
+        struct PendingPathgridSearch
+        {
+            osg::Vec3f mStartPoint;
+            osg::Vec3f mEndPoint;
+            const MWWorld::CellStore* mCell;
+            const PathgridGraph* mGraph;
+            PathgridNodes mNodes;
+            std::shared_ptr<const PathgridSearchResult> mResult;
+        };
+
         bool mConstructed = false;
         std::deque<osg::Vec3f> mPath;
         const MWWorld::CellStore* mCell = nullptr;
+        std::optional<PendingPathgridSearch> mPathgridSearch;
 
         void buildPathByPathgridImpl(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
             const PathgridGraph& pathgridGraph, std::back_insert_iterator<std::deque<osg::Vec3f>> out);
 
+        // Returns nothing when the path does not need a pathgrid search, out contains the path then
+        std::optional<PathgridNodes> findPathgridNodes(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
+            const PathgridGraph& pathgridGraph, std::back_insert_iterator<std::deque<osg::Vec3f>> out) const;
+
+        void addPathgridPath(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
+            const PathgridGraph& pathgridGraph, const PathgridNodes& nodes, std::deque<ESM::Pathgrid::Point> path,
+            std::back_insert_iterator<std::deque<osg::Vec3f>> out) const;
+
         [[nodiscard]] DetourNavigator::Status buildPathByNavigatorImpl(const MWWorld::ConstPtr& actor,
             const osg::Vec3f& startPoint, const osg::Vec3f& endPoint, const DetourNavigator::AgentBounds& agentBounds,
             const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance,
@@ -2,9 +2,14 @@
 #define GAME_MWMECHANICS_PATHGRID_H
 
 #include <deque>
+#include <memory>
+#include <span>
+#include <vector>
 
 #include <components/esm3/loadpgrd.hpp>
 
+#include "pathgridsearch.hpp"
+
 namespace ESM
 {
     struct Cell;
@@ -38,26 +43,25 @@ namespace MWMechanics
         // the output list is in local (internal cells) or world (external
         // cells) coordinates
         //
-        // NOTE: if start equals end an empty path is returned
+        // NOTE: if start equals end a path with only the start point is returned
         std::deque<ESM::Pathgrid::Point> aStarSearch(const int start, const int end) const;
 
+        // Same as aStarSearch but the search is done by the queue, the result contains pathgrid point indexes.
+        // The result is ready immediately when the points are not connected or the path is cached.
+        std::shared_ptr<const PathgridSearchResult> requestAStarSearch(
+            const int start, const int end, PathgridSearchQueue& queue) const;
+
+        // converts pathgrid point indexes into points in local (internal cells) or world (external cells) coordinates
+        std::deque<ESM::Pathgrid::Point> getPathPoints(std::span<const int> path) const;
+
     private:
         const MWWorld::Cell* mCell;
         const ESM::Pathgrid* mPathgrid;
 
-        struct ConnectedPoint // edge
-        {
-            int index; // pathgrid point index of neighbour
-            float cost;
-        };
+        // outgoing edges for each pathgrid point
+        std::vector<std::vector<PathgridEdge>> mEdges;
 
-        struct Node // point
-        {
-            int componentId;
-            std::vector<ConnectedPoint> edges; // neighbours
-        };
-
-        // componentId is an integer indicating the groups of connected
+        // component id for each pathgrid point is an integer indicating the groups of connected
         // pathgrid points (all connected points will have the same value)
         //
         // In Seyda Neen there are 3:
@@ -66,9 +70,12 @@ namespace MWMechanics
         //   48, 49, 50, 51, 84, 85, 86, 87, 88, 89, 90 (ship & office)
         //   all other pathgrid points are the third set
         //
-        std::vector<Node> mGraph;
+        std::vector<int> mComponentIds;
         bool mIsGraphConstructed;
 
+        // paths between recently requested points
+        mutable PathgridPathCache mPathCache;
+
         // variables used to calculate connected components
         int mSCCId;
         int mSCCIndex;
@@ -0,0 +1,224 @@
+#include "pathgridsearch.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+
+namespace MWMechanics
+{
+    namespace
+    {
+        // See https://theory.stanford.edu/~amitp/GameProgramming/Heuristics.html
+        //
+        // One of the smallest cost in Seyda Neen is between points 77 & 78:
+        // pt      x     y
+        // 77 = 8026, 4480
+        // 78 = 7986, 4218
+        //
+        // Euclidean distance is about 262 (ignoring z) and Manhattan distance is 300
+        // (again ignoring z).  Using a value of about 300 for D seems like a reasonable
+        // starting point for experiments. If in doubt, just use value 1.
+        //
+        // The distance between 3 & 4 are pretty small, too.
+        // 3 = 5435, 223
+        // 4 = 5948, 193
+        //
+        // Approx. 514 Euclidean distance and 533 Manhattan distance.
+        //
+        float manhattan(const ESM::Pathgrid::Point& a, const ESM::Pathgrid::Point& b)
+        {
+            return 300.0f * (std::abs(a.mX - b.mX) + std::abs(a.mY - b.mY) + std::abs(a.mZ - b.mZ));
+        }
+    }
+
+    // Choose a heuristics - Note that these may not be the best for directed
+    // graphs with non-uniform edge costs.
+    //
+    //   distance:
+    //   - sqrt((curr.x - goal.x)^2 + (curr.y - goal.y)^2 + (curr.z - goal.z)^2)
+    //   - slower but more accurate
+    //
+    //   Manhattan:
+    //   - |curr.x - goal.x| + |curr.y - goal.y| + |curr.z - goal.z|
+    //   - faster but not the shortest path
+    float getPathgridCost(const ESM::Pathgrid::Point& a, const ESM::Pathgrid::Point& b)
+    {
+        // return distance(a, b);
+        return manhattan(a, b);
+    }
+
+    void PathgridSearch::start(
+        const ESM::Pathgrid::PointList& points, std::span<const std::vector<PathgridEdge>> edges, int start, int goal)
+    {
+        mPoints = &points;
+        mEdges = edges;
+        mGoal = goal;
+        mExpansions = 0;
+        mOpen.clear();
+
+        if (mStates.size() < edges.size())
+            mStates.resize(edges.size());
+
+        if (++mGeneration == 0)
+        {
+            for (PointState& state : mStates)
+                state.mGeneration = 0;
+            mGeneration = 1;
+        }
+
+        const auto isValid = [&](int index) { return index >= 0 && static_cast<std::size_t>(index) < edges.size(); };
+        if (!isValid(start) || !isValid(goal) || points.size() < edges.size())
+        {
+            mStatus = PathgridSearchStatus::NotFound;
+            return;
+        }
+
+        mStatus = PathgridSearchStatus::InProgress;
+        open(start, -1, 0);
+    }
+
+    PathgridSearchStatus PathgridSearch::advance(std::size_t maxExpansions)
+    {
+        std::size_t expansions = 0;
+        while (mStatus == PathgridSearchStatus::InProgress && expansions < maxExpansions)
+        {
+            if (mOpen.empty())
+            {
+                mStatus = PathgridSearchStatus::NotFound;
+                break;
+            }
+
+            std::pop_heap(mOpen.begin(), mOpen.end(), std::greater<>());
+            const int current = mOpen.back().second;
+            mOpen.pop_back();
+
+            // The same point is pushed again when a cheaper path to it is found
+            if (mStates[current].mClosed)
+                continue;
+
+            if (current == mGoal)
+            {
+                mStatus = PathgridSearchStatus::Found;
+                break;
+            }
+
+            mStates[current].mClosed = true;
+            ++expansions;
+
+            const float currentCost = mStates[current].mCost;
+            for (const PathgridEdge& edge : mEdges[current])
+            {
+                const PointState& state = mStates[edge.mIndex];
+                const float cost = currentCost + edge.mCost;
+                if (state.mGeneration == mGeneration && (state.mClosed || state.mCost <= cost))
+                    continue;
+                open(edge.mIndex, current, cost);
+            }
+        }
+
+        mExpansions += expansions;
+        return mStatus;
+    }
+
+    void PathgridSearch::getPath(std::vector<int>& path) const
+    {
+        path.clear();
+        if (mStatus != PathgridSearchStatus::Found)
+            return;
+        for (int current = mGoal; current != -1; current = mStates[current].mParent)
+            path.push_back(current);
+        std::reverse(path.begin(), path.end());
+    }
+
+    void PathgridSearch::open(int index, int parent, float cost)
+    {
+        PointState& state = mStates[index];
+        state.mGeneration = mGeneration;
+        state.mClosed = false;
+        state.mParent = parent;
+        state.mCost = cost;
+        mOpen.emplace_back(cost + getPathgridCost((*mPoints)[index], (*mPoints)[mGoal]), index);
+        std::push_heap(mOpen.begin(), mOpen.end(), std::greater<>());
+    }
+
+    bool PathgridPathCache::get(int start, int goal, std::vector<int>& path)
+    {
+        const std::lock_guard lock(mMutex);
+        const auto it = std::find_if(mItems.begin(), mItems.end(),
+            [&](const Item& item) { return item.mStart == start && item.mGoal == goal; });
+        if (it == mItems.end())
+            return false;
+        it->mLastUse = ++mUses;
+        path = it->mPath;
+        return true;
+    }
+
+    void PathgridPathCache::put(int start, int goal, const std::vector<int>& path)
+    {
+        if (mCapacity == 0)
+            return;
+        const std::lock_guard lock(mMutex);
+        auto it = std::find_if(mItems.begin(), mItems.end(),
+            [&](const Item& item) { return item.mStart == start && item.mGoal == goal; });
+        if (it == mItems.end())
+        {
+            if (mItems.size() < mCapacity)
+                it = mItems.insert(mItems.end(), Item{ start, goal, 0, {} });
+            else
+            {
+                it = std::min_element(mItems.begin(), mItems.end(),
+                    [](const Item& l, const Item& r) { return l.mLastUse < r.mLastUse; });
+                it->mStart = start;
+                it->mGoal = goal;
+            }
+        }
+        it->mLastUse = ++mUses;
+        it->mPath = path;
+    }
+
+    std::shared_ptr<const PathgridSearchResult> PathgridSearchQueue::push(const ESM::Pathgrid::PointList& points,
+        std::span<const std::vector<PathgridEdge>> edges, PathgridPathCache* cache, int start, int goal)
+    {
+        auto result = std::make_shared<PathgridSearchResult>();
+        mItems.push_back(Item{ &points, edges, cache, start, goal, result });
+        return result;
+    }
+
+    std::size_t PathgridSearchQueue::update(std::size_t maxExpansions)
+    {
+        std::size_t expansions = 0;
+        while (!mItems.empty() && expansions < maxExpansions)
+        {
+            Item& item = mItems.front();
+
+            if (item.mResult.use_count() == 1)
+            {
+                mItems.pop_front();
+                mStarted = false;
+                continue;
+            }
+
+            if (!mStarted)
+            {
+                mSearch.start(*item.mPoints, item.mEdges, item.mStart, item.mGoal);
+                mStarted = true;
+            }
+
+            const std::size_t expanded = mSearch.getExpansions();
+            const PathgridSearchStatus status = mSearch.advance(maxExpansions - expansions);
+            expansions += mSearch.getExpansions() - expanded;
+
+            if (status == PathgridSearchStatus::InProgress)
+                break;
+
+            mSearch.getPath(item.mResult->mPath);
+            item.mResult->mStatus = status;
+            if (status == PathgridSearchStatus::Found && item.mCache != nullptr)
+                item.mCache->put(item.mStart, item.mGoal, item.mResult->mPath);
+
+            mItems.pop_front();
+            mStarted = false;
+        }
+        return expansions;
+    }
+}
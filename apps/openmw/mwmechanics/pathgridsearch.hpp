@@ -0,0 +1,148 @@
+#ifndef GAME_MWMECHANICS_PATHGRIDSEARCH_H
+#define GAME_MWMECHANICS_PATHGRIDSEARCH_H
+
+#include <components/esm3/loadpgrd.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace MWMechanics
+{
+    struct PathgridEdge
+    {
+        int mIndex; // pathgrid point index of neighbour
+        float mCost;
+    };
+
+    enum class PathgridSearchStatus
+    {
+        InProgress,
+        Found,
+        NotFound,
+    };
+
+    // Estimated cost to travel between pathgrid points, used as edge cost and as A* heuristic
+    float getPathgridCost(const ESM::Pathgrid::Point& a, const ESM::Pathgrid::Point& b);
+
+    /// A* search over pathgrid points which can be split into multiple steps. Buffers are kept between searches so
+    /// the same object should be used for many searches to avoid allocations.
+    class PathgridSearch
+    {
+    public:
+        /// Prepares search from start to goal. Points and edges must stay valid until the search is finished.
+        /// @param edges outgoing edges for each point
+        void start(const ESM::Pathgrid::PointList& points, std::span<const std::vector<PathgridEdge>> edges,
+            int start, int goal);
+
+        /// Expands at most maxExpansions points
+        PathgridSearchStatus advance(std::size_t maxExpansions);
+
+        PathgridSearchStatus getStatus() const { return mStatus; }
+
+        /// Number of points expanded since the start
+        std::size_t getExpansions() const { return mExpansions; }
+
+        /// Replaces path content with point indexes from start to goal when the status is Found
+        void getPath(std::vector<int>& path) const;
+
+    private:
+        struct PointState
+        {
+            std::uint32_t mGeneration = 0;
+            bool mClosed = false;
+            int mParent = -1;
+            float mCost = 0;
+        };
+
+        const ESM::Pathgrid::PointList* mPoints = nullptr;
+        std::span<const std::vector<PathgridEdge>> mEdges;
+        int mGoal = -1;
+        PathgridSearchStatus mStatus = PathgridSearchStatus::NotFound;
+        std::size_t mExpansions = 0;
+        // Point state is valid only when its generation matches the current one, avoids clearing all states for
+        // each search
+        std::uint32_t mGeneration = 0;
+        std::vector<PointState> mStates;
+        // Min heap of estimated total cost and point index, may contain already closed points
+        std::vector<std::pair<float, int>> mOpen;
+
+        void open(int index, int parent, float cost);
+    };
+
+    /// Keeps paths found by recent searches over a single pathgrid. Thread safe.
+    class PathgridPathCache
+    {
+    public:
+        explicit PathgridPathCache(std::size_t capacity)
+            : mCapacity(capacity)
+        {
+        }
+
+        /// Replaces path content with cached point indexes, returns false when there is no such path
+        bool get(int start, int goal, std::vector<int>& path);
+
+        /// Replaces the least recently used path when there is no space left
+        void put(int start, int goal, const std::vector<int>& path);
+
+    private:
+        struct Item
+        {
+            int mStart;
+            int mGoal;
+            std::uint64_t mLastUse;
+            std::vector<int> mPath;
+        };
+
+        const std::size_t mCapacity;
+        std::mutex mMutex;
+        std::uint64_t mUses = 0;
+        std::vector<Item> mItems;
+    };
+
+    struct PathgridSearchResult
+    {
+        PathgridSearchStatus mStatus = PathgridSearchStatus::InProgress;
+        // Point indexes from start to goal
+        std::vector<int> mPath;
+    };
+
+    /// Runs searches pushed by AI packages within a limited number of expanded points per update, so a few long
+    /// searches are spread over multiple frames. A search is dropped when no one holds its result anymore.
+    /// Not thread safe.
+    class PathgridSearchQueue
+    {
+    public:
+        /// Points, edges and cache must stay valid until the search is finished or dropped
+        std::shared_ptr<const PathgridSearchResult> push(const ESM::Pathgrid::PointList& points,
+            std::span<const std::vector<PathgridEdge>> edges, PathgridPathCache* cache, int start, int goal);
+
+        /// Continues searches in the order they were pushed
+        /// @return number of expanded points
+        std::size_t update(std::size_t maxExpansions);
+
+        std::size_t size() const { return mItems.size(); }
+
+    private:
+        struct Item
+        {
+            const ESM::Pathgrid::PointList* mPoints;
+            std::span<const std::vector<PathgridEdge>> mEdges;
+            PathgridPathCache* mCache;
+            int mStart;
+            int mGoal;
+            std::shared_ptr<PathgridSearchResult> mResult;
+        };
+
+        std::deque<Item> mItems;
+        PathgridSearch mSearch;
+        bool mStarted = false;
+    };
+}
+
+#endif
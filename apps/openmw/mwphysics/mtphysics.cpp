@@ -6,6 +6,7 @@
 #include <optional>
 #include <shared_mutex>
 #include <stdexcept>
+#include <utility>
 #include <variant>
 
 #include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
@@ -357,8 +358,12 @@ namespace MWPhysics
         , mFrameCounter(0)
         , mAdvanceSimulation(false)
         , mQuit(false)
-        , mNextJob(0)
+        , mJobs(mNumThreads)
         , mNextLOS(0)
+        , mLOSHits(0)
+        , mLOSMisses(0)
+        , mLOSBatched(0)
+        , mLOSMissTime(0)
         , mFrameNumber(0)
         , mTimer(osg::Timer::instance())
         , mPrevStepCount(1)
@@ -373,7 +378,7 @@ namespace MWPhysics
         if (mNumThreads >= 1)
         {
             for (unsigned i = 0; i < mNumThreads; ++i)
-                mThreads.emplace_back([&] { worker(); });
+                mThreads.emplace_back([this, i] { worker(i); });
         }
         else
         {
@@ -488,8 +493,9 @@ namespace MWPhysics
         mAdvanceSimulation = (mRemainingSteps != 0);
         ++mFrameCounter;
         mNumJobs = mSimulations->size();
+        addLOSRequests();
         mNextLOS.store(0, std::memory_order_relaxed);
-        mNextJob.store(0, std::memory_order_release);
+        mJobs.reset(mNumJobs);
 
         if (mAdvanceSimulation)
             mWorldFrameData = std::make_unique<WorldFrameData>();
@@ -499,7 +505,7 @@ namespace MWPhysics
 
         if (mNumThreads == 0)
         {
-            doSimulation();
+            doSimulation(0);
             syncWithMainThread();
             if (mAdvanceSimulation)
                 mBudget.update(mTimer->delta_s(timeStart, mTimer->tick()), numSteps, mBudgetCursor);
@@ -623,16 +629,46 @@ namespace MWPhysics
 
         auto req = LOSRequest(actor1, actor2);
         auto result = std::find(mLOSCache.begin(), mLOSCache.end(), req);
-        if (result == mLOSCache.end())
+        if (result == mLOSCache.end() || result->mPending)
         {
+            const osg::Timer_t start = mTimer->tick();
             req.mResult = hasLineOfSight(actor1.get(), actor2.get());
-            mLOSCache.push_back(req);
+            mLOSMissTime += mTimer->tick() - start;
+            mLOSMisses.fetch_add(1, std::memory_order_relaxed);
+            if (result == mLOSCache.end())
+                mLOSCache.push_back(req);
+            else
+                *result = req;
             return req.mResult;
         }
+        mLOSHits.fetch_add(1, std::memory_order_relaxed);
         result->mAge = 0;
         return result->mResult;
     }
 
+    void PhysicsTaskScheduler::requestLineOfSight(
+        const std::shared_ptr<Actor>& actor1, const std::shared_ptr<Actor>& actor2)
+    {
+        mLOSRequests.emplace_back(actor1, actor2);
+    }
+
+    void PhysicsTaskScheduler::addLOSRequests()
+    {
+        MaybeExclusiveLock lock(mLOSCacheMutex, mLockingPolicy);
+        for (LOSRequest& req : mLOSRequests)
+        {
+            auto result = std::find(mLOSCache.begin(), mLOSCache.end(), req);
+            if (result != mLOSCache.end())
+            {
+                result->mAge = 0;
+                continue;
+            }
+            req.mPending = true;
+            mLOSCache.push_back(req);
+        }
+        mLOSRequests.clear();
+    }
+
     void PhysicsTaskScheduler::refreshLOSCache()
     {
         MaybeSharedLock lock(mLOSCacheMutex, mLockingPolicy);
@@ -647,7 +683,14 @@ namespace MWPhysics
             if (req.mAge++ > mLOSCacheExpiry || !actorPtr1 || !actorPtr2)
                 req.mStale = true;
             else
+            {
                 req.mResult = hasLineOfSight(actorPtr1.get(), actorPtr2.get());
+                if (req.mPending)
+                {
+                    req.mPending = false;
+                    mLOSBatched.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
         }
     }
 
@@ -682,7 +725,7 @@ namespace MWPhysics
         }
     }
 
-    void PhysicsTaskScheduler::worker()
+    void PhysicsTaskScheduler::worker(std::size_t workerIndex)
     {
         std::size_t lastFrame = 0;
         std::shared_lock lock(mSimulationMutex);
@@ -694,7 +737,7 @@ namespace MWPhysics
                 lastFrame = mFrameCounter;
             }
 
-            doSimulation();
+            doSimulation(workerIndex);
         }
     }
 
@@ -724,16 +767,21 @@ namespace MWPhysics
         return !resultCallback.hasHit();
     }
 
-    void PhysicsTaskScheduler::doSimulation()
+    void PhysicsTaskScheduler::doSimulation(std::size_t workerIndex)
     {
         while (mRemainingSteps)
         {
             mPreStepBarrier->wait([this] { afterPreStep(); });
-            int job = 0;
             const Visitors::Move impl{ mPhysicsDt, mCollisionWorld, *mWorldFrameData };
             const Visitors::WithLockedPtr<Visitors::Move, MaybeLock> vis{ impl, mCollisionWorldMutex, mLockingPolicy };
-            while ((job = mNextJob.fetch_add(1, std::memory_order_relaxed)) < mNumJobs)
-                std::visit(vis, (*mSimulations)[job]);
+            while (true)
+            {
+                const auto [begin, end] = mJobs.take(workerIndex);
+                if (begin == end)
+                    break;
+                for (std::size_t job = begin; job < end; ++job)
+                    std::visit(vis, (*mSimulations)[job]);
+            }
 
             mPostStepBarrier->wait([this] { afterPostStep(); });
         }
@@ -744,6 +792,13 @@ namespace MWPhysics
 
     void PhysicsTaskScheduler::updateStats(osg::Timer_t frameStart, unsigned int frameNumber, osg::Stats& stats)
     {
+        if (stats.collectStats("resource"))
+        {
+            stats.setAttribute(frameNumber, "Physics LOS Hit", mLOSHits.exchange(0, std::memory_order_relaxed));
+            stats.setAttribute(frameNumber, "Physics LOS Miss", mLOSMisses.exchange(0, std::memory_order_relaxed));
+            stats.setAttribute(frameNumber, "Physics LOS Batched", mLOSBatched.exchange(0, std::memory_order_relaxed));
+            stats.setAttribute(frameNumber, "Physics LOS Time", mTimer->delta_m(0, std::exchange(mLOSMissTime, 0)));
+        }
         if (!stats.collectStats("engine"))
             return;
         if (mFrameNumber == frameNumber - 1)
@@ -802,7 +857,7 @@ namespace MWPhysics
             --mRemainingSteps;
             updateActorsPositions();
         }
-        mNextJob.store(0, std::memory_order_release);
+        mJobs.reset(mNumJobs);
     }
 
     void PhysicsTaskScheduler::afterPostSim()
@@ -13,6 +13,7 @@
 #include <osg/Timer>
 
 #include "components/misc/budgetmeasurement.hpp"
+#include "components/misc/workstealingranges.hpp"
 #include "physicssystem.hpp"
 #include "ptrholder.hpp"
 
@@ -65,17 +66,21 @@ namespace MWPhysics
         void removeCollisionObject(btCollisionObject* collisionObject);
         void updateSingleAabb(const std::shared_ptr<PtrHolder>& ptr, bool immediate = false);
         bool getLineOfSight(const std::shared_ptr<Actor>& actor1, const std::shared_ptr<Actor>& actor2);
+        /// @brief add line of sight check to the batch resolved by the worker threads during the next simulation
+        /// so getLineOfSight will not need a synchronous ray test for it since the next frame
+        void requestLineOfSight(const std::shared_ptr<Actor>& actor1, const std::shared_ptr<Actor>& actor2);
         void debugDraw();
         void* getUserPointer(const btCollisionObject* object) const;
         void releaseSharedStates(); // destroy all objects whose destructor can't be safely called from
                                     // ~PhysicsTaskScheduler()
 
     private:
-        void doSimulation();
-        void worker();
+        void doSimulation(std::size_t workerIndex);
+        void worker(std::size_t workerIndex);
         void updateActorsPositions();
         bool hasLineOfSight(const Actor* actor1, const Actor* actor2);
         void refreshLOSCache();
+        void addLOSRequests();
         void updateAabbs();
         void updatePtrAabb(const std::shared_ptr<PtrHolder>& ptr);
         void updateStats(osg::Timer_t frameStart, unsigned int frameNumber, osg::Stats& stats);
@@ -95,6 +100,7 @@ namespace MWPhysics
         btCollisionWorld* mCollisionWorld;
         MWRender::DebugDrawer* mDebugDrawer;
         std::vector<LOSRequest> mLOSCache;
+        std::vector<LOSRequest> mLOSRequests;
         std::set<std::weak_ptr<PtrHolder>, std::owner_less<std::weak_ptr<PtrHolder>>> mUpdateAabb;
 
         // TODO: use std::experimental::flex_barrier or std::barrier once it becomes a thing
@@ -110,8 +116,12 @@ namespace MWPhysics
         std::size_t mFrameCounter;
         bool mAdvanceSimulation;
         bool mQuit;
-        std::atomic<int> mNextJob;
+        Misc::WorkStealingRanges mJobs;
         std::atomic<int> mNextLOS;
+        std::atomic<std::size_t> mLOSHits;
+        std::atomic<std::size_t> mLOSMisses;
+        std::atomic<std::size_t> mLOSBatched;
+        osg::Timer_t mLOSMissTime;
         std::vector<std::thread> mThreads;
 
         std::size_t mWorkersFrameCounter = 0;
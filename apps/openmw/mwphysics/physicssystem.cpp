@@ -377,6 +377,19 @@ namespace MWPhysics
         return mTaskScheduler->getLineOfSight(it1->second, it2->second);
     }
 
+    void PhysicsSystem::requestLineOfSight(const MWWorld::ConstPtr& actor1, const MWWorld::ConstPtr& actor2)
+    {
+        if (actor1 == actor2)
+            return;
+
+        const auto it1 = mActors.find(actor1.mRef);
+        const auto it2 = mActors.find(actor2.mRef);
+        if (it1 == mActors.end() || it2 == mActors.end())
+            return;
+
+        mTaskScheduler->requestLineOfSight(it1->second, it2->second);
+    }
+
     bool PhysicsSystem::isOnGround(const MWWorld::Ptr& actor)
     {
         Actor* physactor = getActor(actor);
@@ -1026,6 +1039,7 @@ namespace MWPhysics
     LOSRequest::LOSRequest(const std::weak_ptr<Actor>& a1, const std::weak_ptr<Actor>& a2)
         : mResult(false)
         , mStale(false)
+        , mPending(false)
         , mAge(0)
     {
         // we use raw actor pointer pair to uniquely identify request
@@ -73,6 +73,7 @@ namespace MWPhysics
         std::array<const Actor*, 2> mRawActors;
         bool mResult;
         bool mStale;
+        bool mPending;
         int mAge;
     };
     bool operator==(const LOSRequest& lhs, const LOSRequest& rhs) noexcept;
@@ -230,6 +231,9 @@ namespace MWPhysics
         /// Return true if actor1 can see actor2.
         bool getLineOfSight(const MWWorld::ConstPtr& actor1, const MWWorld::ConstPtr& actor2) const override;
 
+        /// Check line of sight in background to have the result of getLineOfSight ready for the next frame.
+        void requestLineOfSight(const MWWorld::ConstPtr& actor1, const MWWorld::ConstPtr& actor2);
+
         bool isOnGround(const MWWorld::Ptr& actor);
 
         bool canMoveToWaterSurface(const MWWorld::ConstPtr& actor, const float waterlevel);
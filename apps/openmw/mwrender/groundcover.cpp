@@ -121,7 +121,7 @@ namespace MWRender
         osg::BoundingBox mBox;
     };
 
-    inline bool isInChunkBorders(ESM::CellRef& ref, osg::Vec2f& minBound, osg::Vec2f& maxBound)
+    inline bool isInChunkBorders(const MWWorld::IndexedCellRef& ref, osg::Vec2f& minBound, osg::Vec2f& maxBound)
     {
         osg::Vec2f size = maxBound - minBound;
         if (size.x() >= 1 && size.y() >= 1)
@@ -198,42 +198,34 @@ namespace MWRender
         {
             for (int cellY = startCell.y(); cellY < startCell.y() + size; ++cellY)
             {
-                ESM::Cell cell;
-                mGroundcoverStore.initCell(cell, cellX, cellY);
-                if (cell.mContextList.empty())
+                const std::shared_ptr<const MWWorld::IndexedCellRefs> cellRefs
+                    = mGroundcoverStore.getCellRefs(cellX, cellY, readers);
+                if (cellRefs == nullptr)
                     continue;
 
                 calculator.reset();
-                std::map<ESM::RefNum, ESM::CellRef> refs;
-                for (size_t i = 0; i < cell.mContextList.size(); ++i)
+                std::map<ESM::RefNum, const MWWorld::IndexedCellRef*> refs;
+                for (const MWWorld::IndexedCellRef& ref : *cellRefs)
                 {
-                    const std::size_t index = static_cast<std::size_t>(cell.mContextList[i].index);
-                    const ESM::ReadersCache::BusyItem reader = readers.get(index);
-                    cell.restore(*reader, i);
-                    ESM::CellRef ref;
-                    bool deleted = false;
-                    while (cell.getNextRef(*reader, ref, deleted))
+                    bool deleted = ref.mDeleted;
+                    if (!deleted && refs.find(ref.mRefNum) == refs.end() && !calculator.isInstanceEnabled())
+                        deleted = true;
+                    if (!deleted && !isInChunkBorders(ref, minBound, maxBound))
+                        deleted = true;
+
+                    if (deleted)
                     {
-                        if (!deleted && refs.find(ref.mRefNum) == refs.end() && !calculator.isInstanceEnabled())
-                            deleted = true;
-                        if (!deleted && !isInChunkBorders(ref, minBound, maxBound))
-                            deleted = true;
-
-                        if (deleted)
-                        {
-                            refs.erase(ref.mRefNum);
-                            continue;
-                        }
-                        refs[ref.mRefNum] = std::move(ref);
+                        refs.erase(ref.mRefNum);
+                        continue;
                     }
+                    refs[ref.mRefNum] = &ref;
                 }
 
-                for (auto& pair : refs)
+                for (const auto& [refNum, ref] : refs)
                 {
-                    ESM::CellRef& ref = pair.second;
-                    const std::string& model = mGroundcoverStore.getGroundcoverModel(ref.mRefID);
+                    const std::string& model = mGroundcoverStore.getGroundcoverModel(ref->mRefId);
                     if (!model.empty())
-                        instances[model].emplace_back(std::move(ref));
+                        instances[model].emplace_back(*ref);
                 }
             }
         }
@@ -5,6 +5,8 @@
 #include <components/resource/scenemanager.hpp>
 #include <components/terrain/quadtreeworld.hpp>
 
+#include "../mwworld/cellrefindex.hpp"
+
 namespace MWWorld
 {
     class ESMStore;
@@ -38,7 +40,7 @@ namespace MWRender
             ESM::Position mPos;
             float mScale;
 
-            GroundcoverEntry(const ESM::CellRef& ref)
+            GroundcoverEntry(const MWWorld::IndexedCellRef& ref)
                 : mPos(ref.mPos)
                 , mScale(ref.mScale)
             {
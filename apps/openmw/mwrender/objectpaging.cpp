@@ -41,6 +41,7 @@
 
 #include "vismask.hpp"
 
+#include <chrono>
 #include <condition_variable>
 
 namespace MWRender
@@ -474,10 +475,13 @@ namespace MWRender
         osg::Vec3f worldCenter = osg::Vec3f(center.x(), center.y(), 0) * ESM::Land::REAL_SIZE;
         osg::Vec3f relativeViewPoint = viewPoint - worldCenter;
 
-        std::map<ESM::RefNum, ESM::CellRef> refs;
+        const auto startTime = std::chrono::steady_clock::now();
+
+        std::map<ESM::RefNum, MWWorld::IndexedCellRef> refs;
         ESM::ReadersCache readers;
         const auto& world = MWBase::Environment::get().getWorld();
         const auto& store = world->getStore();
+        const MWWorld::CellRefIndex& cellRefIndex = store.getCellRefIndex();
 
         for (int cellX = startCell.x(); cellX < startCell.x() + size; ++cellX)
         {
@@ -486,54 +490,34 @@ namespace MWRender
                 const ESM::Cell* cell = store.get<ESM::Cell>().searchStatic(cellX, cellY);
                 if (!cell)
                     continue;
-                for (size_t i = 0; i < cell->mContextList.size(); ++i)
+                const std::shared_ptr<const MWWorld::IndexedCellRefs> cellRefs
+                    = cellRefIndex.get(cellX, cellY, *cell, readers);
+                for (const MWWorld::IndexedCellRef& ref : *cellRefs)
                 {
-                    try
-                    {
-                        const std::size_t index = static_cast<std::size_t>(cell->mContextList[i].index);
-                        const ESM::ReadersCache::BusyItem reader = readers.get(index);
-                        cell->restore(*reader, i);
-                        ESM::CellRef ref;
-                        ESM::MovedCellRef cMRef;
-                        bool deleted = false;
-                        bool moved = false;
-                        while (ESM::Cell::getNextRef(
-                            *reader, ref, deleted, cMRef, moved, ESM::Cell::GetNextRefMode::LoadOnlyNotMoved))
-                        {
-                            if (moved)
-                                continue;
-
-                            if (std::find(cell->mMovedRefs.begin(), cell->mMovedRefs.end(), ref.mRefNum)
-                                != cell->mMovedRefs.end())
-                                continue;
-
-                            int type = store.findStatic(ref.mRefID);
-                            if (!typeFilter(type, size >= 2))
-                                continue;
-                            if (deleted)
-                            {
-                                refs.erase(ref.mRefNum);
-                                continue;
-                            }
-                            refs[ref.mRefNum] = std::move(ref);
-                        }
-                    }
-                    catch (std::exception&)
+                    if (std::find(cell->mMovedRefs.begin(), cell->mMovedRefs.end(), ref.mRefNum)
+                        != cell->mMovedRefs.end())
+                        continue;
+
+                    if (!typeFilter(ref.mType, size >= 2))
+                        continue;
+                    if (ref.mDeleted)
                     {
+                        refs.erase(ref.mRefNum);
                         continue;
                     }
+                    refs[ref.mRefNum] = ref;
                 }
-                for (auto [ref, deleted] : cell->mLeasedRefs)
+                for (const auto& [ref, deleted] : cell->mLeasedRefs)
                 {
                     if (deleted)
                     {
                         refs.erase(ref.mRefNum);
                         continue;
                     }
-                    int type = store.findStatic(ref.mRefID);
-                    if (!typeFilter(type, size >= 2))
+                    MWWorld::IndexedCellRef indexedRef = cellRefIndex.makeRef(ref, false);
+                    if (!typeFilter(indexedRef.mType, size >= 2))
                         continue;
-                    refs[ref.mRefNum] = std::move(ref);
+                    refs[ref.mRefNum] = std::move(indexedRef);
                 }
             }
         }
@@ -549,7 +533,7 @@ namespace MWRender
         osg::Vec2f maxBound = (center + osg::Vec2f(size / 2.f, size / 2.f));
         struct InstanceList
         {
-            std::vector<const ESM::CellRef*> mInstances;
+            std::vector<const MWWorld::IndexedCellRef*> mInstances;
             AnalyzeVisitor::Result mAnalyzeResult;
             bool mNeedCompile = false;
         };
@@ -576,7 +560,7 @@ namespace MWRender
             minSize *= mMinSizeMergeFactor;
         for (const auto& pair : refs)
         {
-            const ESM::CellRef& ref = pair.second;
+            const MWWorld::IndexedCellRef& ref = pair.second;
 
             osg::Vec3f pos = ref.mPos.asVec3();
             if (size < 1.f)
@@ -598,11 +582,11 @@ namespace MWRender
                     continue;
             }
 
-            if (Misc::ResourceHelpers::isHiddenMarker(ref.mRefID))
+            if (Misc::ResourceHelpers::isHiddenMarker(ref.mRefId))
                 continue;
 
-            int type = store.findStatic(ref.mRefID);
-            std::string model = getModel(type, ref.mRefID, store);
+            const int type = ref.mType;
+            std::string model = getModel(type, ref.mRefId, store);
             if (model.empty())
                 continue;
             model = Misc::ResourceHelpers::correctMeshPath(model, mSceneManager->getVFS());
@@ -704,7 +688,7 @@ namespace MWRender
             unsigned int numinstances = 0;
             for (auto cref : pair.second.mInstances)
             {
-                const ESM::CellRef& ref = *cref;
+                const MWWorld::IndexedCellRef& ref = *cref;
                 osg::Vec3f pos = ref.mPos.asVec3();
 
                 if (!activeGrid && minSizeMerged != minSize
@@ -839,6 +823,8 @@ namespace MWRender
         }
         udc->addUserObject(templateRefs);
 
+        mChunkBuildTime += (std::chrono::steady_clock::now() - startTime).count();
+
         return group;
     }
 
@@ -994,6 +980,10 @@ namespace MWRender
     void ObjectPaging::reportStats(unsigned int frameNumber, osg::Stats* stats) const
     {
         stats->setAttribute(frameNumber, "Object Chunk", mCache->getCacheSize());
+        // Chunks are built by the work queue threads, so the time is not bound to a frame
+        const std::chrono::steady_clock::duration buildTime(mChunkBuildTime.exchange(0));
+        stats->setAttribute(
+            frameNumber, "Object Chunk Time", std::chrono::duration<double, std::milli>(buildTime).count());
     }
 
 }
@@ -5,6 +5,8 @@
 #include <components/resource/resourcemanager.hpp>
 #include <components/terrain/quadtreeworld.hpp>
 
+#include <atomic>
+#include <chrono>
 #include <mutex>
 
 namespace Resource
@@ -86,6 +88,9 @@ namespace MWRender
         typedef std::pair<std::string, unsigned char> LODNameCacheKey; // Key: mesh name, lod level
         typedef std::map<LODNameCacheKey, std::string> LODNameCache; // Cache: key, mesh name to use
         LODNameCache mLODNameCache;
+
+        // Time spent in createChunk since the last reportStats call
+        mutable std::atomic<std::chrono::steady_clock::rep> mChunkBuildTime{ 0 };
     };
 
     class RefnumMarker : public osg::Object
@@ -1470,6 +1470,11 @@ namespace MWRender
         return mTerrain->getHeightAt(pos);
     }
 
+    void RenderingManager::getTerrainHeightsAt(std::span<const osg::Vec3f> positions, std::span<float> heights)
+    {
+        mTerrain->getHeightsAt(positions, heights);
+    }
+
     void RenderingManager::overrideFieldOfView(float val)
     {
         if (mFieldOfViewOverridden != true || mFieldOfViewOverride != val)
@@ -16,6 +16,7 @@
 
 #include <deque>
 #include <memory>
+#include <span>
 
 namespace osg
 {
@@ -230,6 +231,7 @@ namespace MWRender
         void setViewDistance(float distance, bool delay = false);
 
         float getTerrainHeightAt(const osg::Vec3f& pos);
+        void getTerrainHeightsAt(std::span<const osg::Vec3f> positions, std::span<float> heights);
 
         // camera stuff
         Camera* getCamera() { return mCamera.get(); }
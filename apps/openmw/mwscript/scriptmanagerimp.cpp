@@ -3,8 +3,11 @@
 #include <algorithm>
 #include <cassert>
 #include <exception>
+#include <iomanip>
 #include <sstream>
 
+#include <osg/Stats>
+
 #include <components/debug/debuglog.hpp>
 
 #include <components/esm/refid.hpp>
@@ -12,6 +15,8 @@
 
 #include <components/misc/strings/lower.hpp>
 
+#include <components/settings/settings.hpp>
+
 #include <components/compiler/context.hpp>
 #include <components/compiler/exception.hpp>
 #include <components/compiler/quickfileparser.hpp>
@@ -31,6 +36,7 @@ namespace MWScript
         , mCompilerContext(compilerContext)
         , mParser(mErrorHandler, mCompilerContext)
         , mOpcodesInstalled(false)
+        , mProfilerEnabled(Settings::Manager::getBool("mwscript profiler", "Game"))
         , mGlobalScripts(store)
     {
         mErrorHandler.setWarningsMode(warningsMode);
@@ -40,6 +46,12 @@ namespace MWScript
         std::sort(mScriptBlacklist.begin(), mScriptBlacklist.end());
     }
 
+    ScriptManager::~ScriptManager()
+    {
+        if (mProfilerEnabled)
+            logProfile();
+    }
+
     bool ScriptManager::compile(const ESM::RefId& name)
     {
         mParser.reset();
@@ -118,7 +130,27 @@ namespace MWScript
                     mOpcodesInstalled = true;
                 }
 
-                mInterpreter.run(iter->second.mProgram, interpreterContext);
+                CompiledScript& script = iter->second;
+
+                if (!script.mDecoded.has_value())
+                    script.mDecoded = mInterpreter.decode(script.mProgram);
+
+                if (!mProfilerEnabled)
+                {
+                    mInterpreter.run(script.mProgram, *script.mDecoded, interpreterContext);
+                    return true;
+                }
+
+                // Time of nested runs is included into the time of the outer script
+                const auto start = std::chrono::steady_clock::now();
+                mInterpreter.run(script.mProgram, *script.mDecoded, interpreterContext);
+                const auto duration = std::chrono::steady_clock::now() - start;
+
+                ++script.mInvocations;
+                script.mTotalTime += duration;
+                ++mFrameInvocations;
+                mFrameTime += duration;
+
                 return true;
             }
             catch (const MissingImplicitRefError& e)
@@ -220,4 +252,42 @@ namespace MWScript
     {
         return *mCompilerContext.getExtensions();
     }
+
+    void ScriptManager::reportStats(unsigned int frameNumber, osg::Stats& stats)
+    {
+        if (!mProfilerEnabled)
+            return;
+
+        stats.setAttribute(frameNumber, "MWScript Runs", mFrameInvocations);
+        stats.setAttribute(frameNumber, "MWScript Time", std::chrono::duration<double, std::milli>(mFrameTime).count());
+
+        mFrameInvocations = 0;
+        mFrameTime = {};
+    }
+
+    void ScriptManager::logProfile() const
+    {
+        std::vector<std::pair<ESM::RefId, const CompiledScript*>> scripts;
+
+        for (const auto& [name, script] : mScripts)
+            if (script.mInvocations != 0)
+                scripts.emplace_back(name, &script);
+
+        std::sort(scripts.begin(), scripts.end(),
+            [](const auto& lhs, const auto& rhs) { return lhs.second->mTotalTime > rhs.second->mTotalTime; });
+
+        std::ostringstream stream;
+        stream << "MWScript profile (" << scripts.size() << " scripts):";
+
+        for (const auto& [name, script] : scripts)
+        {
+            const double total = std::chrono::duration<double, std::milli>(script->mTotalTime).count();
+            stream << "\n    " << std::left << std::setw(40) << name.getRefIdString() << std::right
+                   << " runs: " << std::setw(10) << script->mInvocations << " total: " << std::fixed
+                   << std::setprecision(3) << std::setw(12) << total << " ms"
+                   << " average: " << std::setw(10) << total * 1000 / script->mInvocations << " us";
+        }
+
+        Log(Debug::Info) << stream.str();
+    }
 }
@@ -1,7 +1,9 @@
 #ifndef GAME_SCRIPT_SCRIPTMANAGER_H
 #define GAME_SCRIPT_SCRIPTMANAGER_H
 
+#include <chrono>
 #include <map>
+#include <optional>
 #include <set>
 #include <string>
 
@@ -43,12 +45,16 @@ namespace MWScript
         Compiler::FileParser mParser;
         Interpreter::Interpreter mInterpreter;
         bool mOpcodesInstalled;
+        bool mProfilerEnabled;
 
         struct CompiledScript
         {
             Interpreter::Program mProgram;
+            std::optional<Interpreter::DecodedProgram> mDecoded;
             Compiler::Locals mLocals;
             std::set<ESM::RefId> mInactive;
+            std::size_t mInvocations = 0;
+            std::chrono::steady_clock::duration mTotalTime{};
 
             explicit CompiledScript(Interpreter::Program&& program, const Compiler::Locals& locals)
                 : mProgram(std::move(program))
@@ -61,11 +67,17 @@ namespace MWScript
         GlobalScripts mGlobalScripts;
         std::unordered_map<ESM::RefId, Compiler::Locals> mOtherLocals;
         std::vector<ESM::RefId> mScriptBlacklist;
+        std::size_t mFrameInvocations = 0;
+        std::chrono::steady_clock::duration mFrameTime{};
+
+        void logProfile() const;
 
     public:
         ScriptManager(const MWWorld::ESMStore& store, Compiler::Context& compilerContext, int warningsMode,
             const std::vector<ESM::RefId>& scriptBlacklist);
 
+        ~ScriptManager() override;
+
         void clear() override;
 
         bool run(const ESM::RefId& name, Interpreter::Context& interpreterContext) override;
@@ -85,6 +97,8 @@ namespace MWScript
         GlobalScripts& getGlobalScripts() override;
 
         const Compiler::Extensions& getExtensions() const override;
+
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) override;
     };
 }
 
@@ -8,6 +8,9 @@
 
 #include <osg/Vec3f>
 
+#include <algorithm>
+#include <vector>
+
 namespace MWSound
 {
     WaterSoundUpdater::WaterSoundUpdater(const WaterSoundUpdaterSettings& settings)
@@ -45,7 +48,8 @@ namespace MWSound
 
             const float step = mSettings.mNearWaterRadius * 2.0f / (mSettings.mNearWaterPoints - 1);
 
-            int underwaterPoints = 0;
+            std::vector<osg::Vec3f> points;
+            points.reserve(mSettings.mNearWaterPoints * mSettings.mNearWaterPoints);
 
             for (int x = 0; x < mSettings.mNearWaterPoints; x++)
             {
@@ -53,13 +57,15 @@ namespace MWSound
                 {
                     const float terrainX = pos.x() - mSettings.mNearWaterRadius + x * step;
                     const float terrainY = pos.y() - mSettings.mNearWaterRadius + y * step;
-                    const float height = world.getTerrainHeightAt(osg::Vec3f(terrainX, terrainY, 0.0f));
-
-                    if (height < 0)
-                        underwaterPoints++;
+                    points.emplace_back(terrainX, terrainY, 0.0f);
                 }
             }
 
+            std::vector<float> heights(points.size());
+            world.getTerrainHeightsAt(points, heights);
+
+            const auto underwaterPoints = std::count_if(heights.begin(), heights.end(), [](float v) { return v < 0; });
+
             return underwaterPoints * 2.0f / (mSettings.mNearWaterPoints * mSettings.mNearWaterPoints);
         }
 
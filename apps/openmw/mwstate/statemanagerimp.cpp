@@ -1,6 +1,7 @@
 #include "statemanagerimp.hpp"
 
 #include <filesystem>
+#include <fstream>
 
 #include <components/debug/debuglog.hpp>
 
@@ -44,6 +45,29 @@
 
 #include "quicksavemanager.hpp"
 
+namespace
+{
+    // Replaces the file atomically, so a failed or interrupted write doesn't trash the existing save file.
+    void writeSaveFile(const std::filesystem::path& path, const std::string& data)
+    {
+        std::filesystem::path tempPath = path;
+        tempPath += ".tmp";
+
+        std::ofstream stream(tempPath, std::ios::binary);
+        stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+        stream.close();
+
+        if (stream.fail())
+        {
+            std::error_code ec;
+            std::filesystem::remove(tempPath, ec);
+            throw std::runtime_error("Write operation failed (file stream)");
+        }
+
+        std::filesystem::rename(tempPath, path);
+    }
+}
+
 void MWState::StateManager::cleanup(bool force)
 {
     if (mState != State_NoGame || force)
@@ -98,6 +122,60 @@ MWState::StateManager::StateManager(const std::filesystem::path& saves, const st
 {
 }
 
+MWState::StateManager::~StateManager()
+{
+    // Other managers may be already destroyed, so only wait for the file to be written.
+    if (mSaveThread.joinable())
+        mSaveThread.join();
+    if (mSaveJob != nullptr && !mSaveJob->mError.empty())
+        Log(Debug::Error) << "Failed to save game: " << mSaveJob->mError;
+}
+
+void MWState::StateManager::finishSave(bool wait)
+{
+    if (mSaveJob == nullptr || (!wait && !mSaveJob->mDone))
+        return;
+
+    mSaveThread.join();
+    const std::unique_ptr<SaveJob> job = std::move(mSaveJob);
+
+    if (job->mError.empty())
+    {
+        Settings::Manager::setString(
+            "character", "Saves", Files::pathToUnicodeString(job->mPath.parent_path().filename()));
+
+        const auto finish = std::chrono::steady_clock::now();
+
+        Log(Debug::Info) << '\'' << job->mDescription << "' is saved in "
+                         << std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(finish - job->mStart)
+                                .count()
+                         << "ms";
+        return;
+    }
+
+    std::stringstream error;
+    error << "Failed to save game: " << job->mError;
+
+    Log(Debug::Error) << error.str();
+
+    std::vector<std::string> buttons;
+    buttons.emplace_back("#{sOk}");
+    MWBase::Environment::get().getWindowManager()->interactiveMessageBox(error.str(), buttons);
+
+    // If no file was written, clean up the slot
+    if (std::filesystem::exists(job->mPath))
+        return;
+    for (const Slot& slot : *job->mCharacter)
+    {
+        if (slot.mPath == job->mPath)
+        {
+            job->mCharacter->deleteSlot(&slot);
+            job->mCharacter->cleanup();
+            break;
+        }
+    }
+}
+
 void MWState::StateManager::requestQuit()
 {
     mQuitRequest = true;
@@ -189,6 +267,8 @@ void MWState::StateManager::resumeGame()
 
 void MWState::StateManager::saveGame(const std::string& description, const Slot* slot)
 {
+    finishSave(true);
+
     MWState::Character* character = getCurrentCharacter();
 
     try
@@ -303,21 +383,32 @@ void MWState::StateManager::saveGame(const std::string& description, const Slot*
         if (stream.fail())
             throw std::runtime_error("Write operation failed (memory stream)");
 
-        // All good, write to file
-        std::ofstream filestream(slot->mPath, std::ios::binary);
-        filestream << stream.rdbuf();
-
-        if (filestream.fail())
-            throw std::runtime_error("Write operation failed (file stream)");
-
-        Settings::Manager::setString(
-            "character", "Saves", Files::pathToUnicodeString(slot->mPath.parent_path().filename()));
-
         const auto finish = std::chrono::steady_clock::now();
 
-        Log(Debug::Info) << '\'' << description << "' is saved in "
+        Log(Debug::Info) << '\'' << description << "' is serialized in "
                          << std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(finish - start).count()
                          << "ms";
+
+        // All good, write to file. It doesn't touch the game state, so it is done in background.
+        auto job = std::make_unique<SaveJob>();
+        job->mCharacter = character;
+        job->mPath = slot->mPath;
+        job->mDescription = description;
+        job->mData = std::move(stream).str();
+        job->mStart = start;
+        mSaveThread = std::thread([job = job.get()] {
+            try
+            {
+                writeSaveFile(job->mPath, job->mData);
+            }
+            catch (const std::exception& e)
+            {
+                job->mError = e.what();
+            }
+            job->mData = std::string();
+            job->mDone = true;
+        });
+        mSaveJob = std::move(job);
     }
     catch (const std::exception& e)
     {
@@ -391,6 +482,8 @@ void MWState::StateManager::loadGame(const std::filesystem::path& filepath)
 
 void MWState::StateManager::loadGame(const Character* character, const std::filesystem::path& filepath)
 {
+    finishSave(true);
+
     try
     {
         cleanup();
@@ -466,6 +559,7 @@ void MWState::StateManager::loadGame(const Character* character, const std::file
                 case ESM::REC_GLOB:
                 case ESM::REC_PLAY:
                 case ESM::REC_CSTA:
+                case ESM::REC_CSTC:
                 case ESM::REC_WTHR:
                 case ESM::REC_DYNA:
                 case ESM::REC_ACTC:
@@ -610,6 +704,8 @@ void MWState::StateManager::quickLoad()
 
 void MWState::StateManager::deleteGame(const MWState::Character* character, const MWState::Slot* slot)
 {
+    finishSave(true);
+
     mCharacterManager.deleteSlot(character, slot);
 }
 
@@ -632,6 +728,8 @@ void MWState::StateManager::update(float duration)
 {
     mTimePlayed += duration;
 
+    finishSave(false);
+
     // Note: It would be nicer to trigger this from InputManager, i.e. the very beginning of the frame update.
     if (mAskLoadRecent)
     {
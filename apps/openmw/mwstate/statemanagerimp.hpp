@@ -1,8 +1,13 @@
 #ifndef GAME_STATE_STATEMANAGER_H
 #define GAME_STATE_STATEMANAGER_H
 
+#include <atomic>
+#include <chrono>
 #include <filesystem>
 #include <map>
+#include <memory>
+#include <string>
+#include <thread>
 
 #include "../mwbase/statemanager.hpp"
 
@@ -18,6 +23,21 @@ namespace MWState
         CharacterManager mCharacterManager;
         double mTimePlayed;
 
+        // Serialized saved game that is written to the file by a background thread.
+        struct SaveJob
+        {
+            Character* mCharacter;
+            std::filesystem::path mPath;
+            std::string mDescription;
+            std::string mData;
+            std::string mError;
+            std::chrono::steady_clock::time_point mStart;
+            std::atomic_bool mDone{ false };
+        };
+
+        std::unique_ptr<SaveJob> mSaveJob;
+        std::thread mSaveThread;
+
     private:
         void cleanup(bool force = false);
 
@@ -30,6 +50,8 @@ namespace MWState
     public:
         StateManager(const std::filesystem::path& saves, const std::vector<std::string>& contentFiles);
 
+        ~StateManager() override;
+
         void requestQuit() override;
 
         bool hasQuitRequest() const override;
@@ -83,6 +105,11 @@ namespace MWState
         CharacterIterator characterEnd() override;
 
         void update(float duration);
+
+        void finishSave(bool wait);
+        ///< Report the result of the background save if it is finished.
+        ///
+        /// \param wait Block until the background save is finished.
     };
 }
 
@@ -0,0 +1,107 @@
+#include "cellrefindex.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/esm3/loadcell.hpp>
+#include <components/esm3/readerscache.hpp>
+
+namespace MWWorld
+{
+    CellRefIndex::CellRefIndex(GetType getType, std::size_t maxCells)
+        : mGetType(std::move(getType))
+        , mMaxCells(maxCells)
+    {
+    }
+
+    std::shared_ptr<const IndexedCellRefs> CellRefIndex::get(
+        int cellX, int cellY, const ESM::Cell& cell, ESM::ReadersCache& readers) const
+    {
+        const std::pair<int, int> key(cellX, cellY);
+        {
+            std::lock_guard lock(mMutex);
+            const auto it = mCells.find(key);
+            if (it != mCells.end())
+                return it->second;
+        }
+
+        // Reading is done without the lock, so several threads may read the same cell. Only the first result is kept.
+        auto refs = std::make_shared<IndexedCellRefs>();
+        for (std::size_t i = 0; i < cell.mContextList.size(); ++i)
+        {
+            try
+            {
+                const std::size_t index = static_cast<std::size_t>(cell.mContextList[i].index);
+                const ESM::ReadersCache::BusyItem reader = readers.get(index);
+                cell.restore(*reader, i);
+                ESM::CellRef ref;
+                bool deleted = false;
+                while (ESM::Cell::getNextRef(*reader, ref, deleted))
+                    refs->push_back(makeRef(ref, deleted));
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to read references of cell " << cellX << ", " << cellY << ": "
+                                    << e.what();
+            }
+        }
+
+        refs->shrink_to_fit();
+        std::shared_ptr<const IndexedCellRefs> result = std::move(refs);
+        std::lock_guard lock(mMutex);
+        emplace(key, result);
+        return result;
+    }
+
+    void CellRefIndex::insert(int cellX, int cellY, IndexedCellRefs refs)
+    {
+        refs.shrink_to_fit();
+        std::shared_ptr<const IndexedCellRefs> value = std::make_shared<const IndexedCellRefs>(std::move(refs));
+        std::lock_guard lock(mMutex);
+        const auto [it, inserted] = mCells.insert_or_assign(std::make_pair(cellX, cellY), std::move(value));
+        if (inserted)
+            addToInsertionOrder(it->first);
+    }
+
+    void CellRefIndex::emplace(std::pair<int, int> key, std::shared_ptr<const IndexedCellRefs>& refs) const
+    {
+        const auto [it, inserted] = mCells.emplace(key, refs);
+        if (inserted)
+            addToInsertionOrder(key);
+        else
+            refs = it->second;
+    }
+
+    void CellRefIndex::addToInsertionOrder(std::pair<int, int> key) const
+    {
+        mInsertionOrder.push_back(key);
+        while (mCells.size() > mMaxCells)
+        {
+            mCells.erase(mInsertionOrder.front());
+            mInsertionOrder.pop_front();
+        }
+    }
+
+    IndexedCellRef CellRefIndex::makeRef(const ESM::CellRef& ref, bool deleted) const
+    {
+        return IndexedCellRef{
+            .mRefNum = ref.mRefNum,
+            .mRefId = ref.mRefID,
+            .mPos = ref.mPos,
+            .mScale = ref.mScale,
+            .mType = mGetType ? mGetType(ref.mRefID) : 0,
+            .mDeleted = deleted,
+        };
+    }
+
+    std::size_t CellRefIndex::getCellCount() const
+    {
+        std::lock_guard lock(mMutex);
+        return mCells.size();
+    }
+
+    void CellRefIndex::clear()
+    {
+        std::lock_guard lock(mMutex);
+        mCells.clear();
+        mInsertionOrder.clear();
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef GAME_MWWORLD_CELLREFINDEX_H
+#define GAME_MWWORLD_CELLREFINDEX_H
+
+#include <deque>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <components/esm/defs.hpp>
+#include <components/esm/refid.hpp>
+#include <components/esm3/cellref.hpp>
+
+namespace ESM
+{
+    struct Cell;
+    class ReadersCache;
+}
+
+namespace MWWorld
+{
+    /// \brief Part of ESM::CellRef needed to place a reference without loading the cell
+    struct IndexedCellRef
+    {
+        ESM::RefNum mRefNum;
+        ESM::RefId mRefId;
+        ESM::Position mPos;
+        float mScale = 1;
+        int mType = 0; ///< As returned by ESMStore::findStatic, 0 if unknown
+        bool mDeleted = false;
+    };
+
+    /// \brief References of a cell in the order they are stored in the content files, including deleted ones.
+    /// Moved references (MVRF) are skipped like ESM::Cell::getNextRef does, ESM::Cell::mMovedRefs is not applied.
+    using IndexedCellRefs = std::vector<IndexedCellRef>;
+
+    /// \brief Thread safe cache of references of exterior cells
+    ///
+    /// Every cell is read from the content files only once, then the references are shared by all users. If the
+    /// number of cells is limited, the cells which were indexed first are dropped and read again when needed.
+    class CellRefIndex
+    {
+    public:
+        using GetType = std::function<int(const ESM::RefId&)>;
+
+        explicit CellRefIndex(
+            GetType getType = {}, std::size_t maxCells = std::numeric_limits<std::size_t>::max());
+
+        /// Returns references of the exterior cell at the given grid position. If the cell is not indexed yet, they
+        /// are read using \a readers; a content file that can't be read is skipped.
+        std::shared_ptr<const IndexedCellRefs> get(
+            int cellX, int cellY, const ESM::Cell& cell, ESM::ReadersCache& readers) const;
+
+        /// Adds references which are already read by the caller.
+        void insert(int cellX, int cellY, IndexedCellRefs refs);
+
+        IndexedCellRef makeRef(const ESM::CellRef& ref, bool deleted) const;
+
+        std::size_t getCellCount() const;
+
+        void clear();
+
+    private:
+        // Keeps the existing value if any and assigns it to `refs`
+        void emplace(std::pair<int, int> key, std::shared_ptr<const IndexedCellRefs>& refs) const;
+        void addToInsertionOrder(std::pair<int, int> key) const;
+
+        GetType mGetType;
+        std::size_t mMaxCells;
+        mutable std::mutex mMutex;
+        mutable std::map<std::pair<int, int>, std::shared_ptr<const IndexedCellRefs>> mCells;
+        mutable std::deque<std::pair<int, int>> mInsertionOrder;
+    };
+}
+
+#endif
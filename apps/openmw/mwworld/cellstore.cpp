@@ -567,6 +567,11 @@ namespace MWWorld
         return mHasState;
     }
 
+    bool CellStore::hasRefsMovedToAnotherCell() const
+    {
+        return !mMovedToAnotherCell.empty();
+    }
+
     bool CellStore::hasId(const ESM::RefId& id) const
     {
         if (mState == State_Unloaded)
@@ -207,6 +207,9 @@ namespace MWWorld
         bool hasState() const;
         ///< Does this cell have state that needs to be stored in a saved game file?
 
+        bool hasRefsMovedToAnotherCell() const;
+        ///< Does the state of other cells depend on the state of this cell?
+
         bool hasId(const ESM::RefId& id) const;
         ///< May return true for deleted IDs when in preload state. Will return false, if cell is
         /// unloaded.
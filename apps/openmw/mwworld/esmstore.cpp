@@ -41,7 +41,8 @@ namespace
     constexpr std::size_t deletedRefID = std::numeric_limits<std::size_t>::max();
 
     void readRefs(const ESM::Cell& cell, std::vector<Ref>& refs, std::vector<ESM::RefId>& refIDs,
-        std::set<ESM::RefId>& keyIDs, ESM::ReadersCache& readers)
+        std::set<ESM::RefId>& keyIDs, ESM::ReadersCache& readers, const MWWorld::CellRefIndex* cellRefIndex = nullptr,
+        MWWorld::IndexedCellRefs* indexedRefs = nullptr)
     {
         // TODO: we have many similar copies of this code.
         for (size_t i = 0; i < cell.mContextList.size(); i++)
@@ -53,6 +54,8 @@ namespace
             bool deleted = false;
             while (cell.getNextRef(*reader, ref, deleted))
             {
+                if (indexedRefs != nullptr)
+                    indexedRefs->push_back(cellRefIndex->makeRef(ref, deleted));
                 if (deleted)
                     refs.emplace_back(ref.mRefNum, deletedRefID);
                 else if (std::find(cell.mMovedRefs.begin(), cell.mMovedRefs.end(), ref.mRefNum)
@@ -237,6 +240,7 @@ namespace MWWorld
     }
 
     ESMStore::ESMStore()
+        : mCellRefIndex([this](const ESM::RefId& id) { return findStatic(id); })
     {
         mStoreImp = std::make_unique<ESMStoreImp>();
         std::apply([this](auto&... x) { (ESMStoreImp::assignStoreToIndex(*this, x), ...); }, mStoreImp->mStores);
@@ -462,8 +466,13 @@ namespace MWWorld
         Store<ESM::Cell> Cells = get<ESM::Cell>();
         for (auto it = Cells.intBegin(); it != Cells.intEnd(); ++it)
             readRefs(*it, refs, refIDs, keyIDs, readers);
+        // Exterior cells are read only here, object paging uses the same references later.
         for (auto it = Cells.extBegin(); it != Cells.extEnd(); ++it)
-            readRefs(*it, refs, refIDs, keyIDs, readers);
+        {
+            MWWorld::IndexedCellRefs indexedRefs;
+            readRefs(*it, refs, refIDs, keyIDs, readers, &mCellRefIndex, &indexedRefs);
+            mCellRefIndex.insert(it->getGridX(), it->getGridY(), std::move(indexedRefs));
+        }
         const auto lessByRefNum = [](const Ref& l, const Ref& r) { return l.mRefNum < r.mRefNum; };
         std::stable_sort(refs.begin(), refs.end(), lessByRefNum);
         const auto equalByRefNum = [](const Ref& l, const Ref& r) { return l.mRefNum == r.mRefNum; };
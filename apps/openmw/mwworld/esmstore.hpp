@@ -12,6 +12,7 @@
 #include <components/esm3/loadgmst.hpp>
 #include <components/misc/tuplemeta.hpp>
 
+#include "cellrefindex.hpp"
 #include "store.hpp"
 
 namespace Loading
@@ -119,6 +120,7 @@ namespace MWWorld
         std::unique_ptr<ESMStoreImp> mStoreImp;
 
         std::unordered_map<ESM::RefId, int> mRefCount;
+        CellRefIndex mCellRefIndex;
 
         std::vector<StoreBase*> mStores;
         std::vector<DynamicStore*> mDynamicStores;
@@ -256,6 +258,9 @@ namespace MWWorld
         /// @return The number of instances defined in the base files. Excludes changes from the save file.
         int getRefCount(const ESM::RefId& id) const;
 
+        /// References of exterior cells defined in the base files. Filled by validateRecords.
+        const CellRefIndex& getCellRefIndex() const { return mCellRefIndex; }
+
         /// Actors with the same ID share spells, abilities, etc.
         /// @return The shared spell list to use for this actor and whether or not it has already been initialized.
         std::pair<std::shared_ptr<MWMechanics::SpellList>, bool> getSpellList(const ESM::RefId& id) const;
@@ -73,4 +73,14 @@ namespace MWWorld
         if (searchCell != mCellContexts.end())
             cell.mContextList = searchCell->second;
     }
+
+    std::shared_ptr<const IndexedCellRefs> GroundcoverStore::getCellRefs(
+        int cellX, int cellY, ESM::ReadersCache& readers) const
+    {
+        ESM::Cell cell;
+        initCell(cell, cellX, cellY);
+        if (cell.mContextList.empty())
+            return nullptr;
+        return mCellRefIndex.get(cellX, cellY, cell, readers);
+    }
 }
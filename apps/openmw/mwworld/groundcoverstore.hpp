@@ -3,14 +3,18 @@
 
 #include <components/esm/refid.hpp>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "cellrefindex.hpp"
+
 namespace ESM
 {
     struct ESM_Context;
     struct Static;
     struct Cell;
+    class ReadersCache;
 }
 
 namespace Loading
@@ -38,6 +42,8 @@ namespace MWWorld
     private:
         std::map<ESM::RefId, std::string> mMeshCache;
         std::map<std::pair<int, int>, std::vector<ESM::ESM_Context>> mCellContexts;
+        // Groundcover files may contain millions of references, so the number of indexed cells is limited
+        CellRefIndex mCellRefIndex{ CellRefIndex::GetType(), 256 };
 
     public:
         void init(const Store<ESM::Static>& statics, const Files::Collections& fileCollections,
@@ -46,6 +52,9 @@ namespace MWWorld
 
         std::string getGroundcoverModel(const ESM::RefId& id) const;
         void initCell(ESM::Cell& cell, int cellX, int cellY) const;
+
+        /// @return References of the cell from groundcover files, nullptr if there are none.
+        std::shared_ptr<const IndexedCellRefs> getCellRefs(int cellX, int cellY, ESM::ReadersCache& readers) const;
     };
 }
 
@@ -377,7 +377,7 @@ namespace MWWorld
         mStore.write(writer, progress); // dynamic Store must be written (and read) before Cells, so that
                                         // references to custom made records will be recognized
         mPlayer->write(writer, progress);
-        mWorldModel.write(writer, progress);
+        mWorldModel.write(writer, progress, mWorldScene->getActiveCells());
         mGlobalVariables.write(writer, progress);
         mWeatherManager->write(writer, progress);
         mProjectileManager->write(writer, progress);
@@ -2725,6 +2725,16 @@ namespace MWWorld
         return mPhysics->getLineOfSight(actor, targetActor);
     }
 
+    void World::requestLOS(const MWWorld::ConstPtr& actor, const MWWorld::ConstPtr& targetActor)
+    {
+        if (!targetActor.getRefData().isEnabled() || !actor.getRefData().isEnabled())
+            return;
+        if (!targetActor.getRefData().getBaseNode() || !actor.getRefData().getBaseNode())
+            return;
+
+        mPhysics->requestLineOfSight(actor, targetActor);
+    }
+
     float World::getDistToNearestRayHit(const osg::Vec3f& from, const osg::Vec3f& dir, float maxDist, bool includeWater)
     {
         osg::Vec3f to(dir);
@@ -3713,6 +3723,11 @@ namespace MWWorld
         return mRendering->getTerrainHeightAt(worldPos);
     }
 
+    void World::getTerrainHeightsAt(std::span<const osg::Vec3f> worldPositions, std::span<float> heights) const
+    {
+        mRendering->getTerrainHeightsAt(worldPositions, heights);
+    }
+
     osg::Vec3f World::getHalfExtents(const ConstPtr& object, bool rendering) const
     {
         if (!object.getClass().isActor())
@@ -580,6 +580,8 @@ namespace MWWorld
         ///< get all items in active cells owned by this Npc
 
         bool getLOS(const MWWorld::ConstPtr& actor, const MWWorld::ConstPtr& targetActor) override;
+
+        void requestLOS(const MWWorld::ConstPtr& actor, const MWWorld::ConstPtr& targetActor) override;
         ///< get Line of Sight (morrowind stupid implementation)
 
         float getDistToNearestRayHit(
@@ -718,6 +720,8 @@ namespace MWWorld
         /// Return terrain height at \a worldPos position.
         float getTerrainHeightAt(const osg::Vec3f& worldPos) const override;
 
+        void getTerrainHeightsAt(std::span<const osg::Vec3f> worldPositions, std::span<float> heights) const override;
+
         /// Return physical or rendering half extents of the given actor.
         osg::Vec3f getHalfExtents(const MWWorld::ConstPtr& actor, bool rendering = false) const override;
 
@@ -7,9 +7,13 @@
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/esmwriter.hpp>
 #include <components/esm3/loadregn.hpp>
+#include <components/files/memorystream.hpp>
 #include <components/loadinglistener/loadinglistener.hpp>
+#include <components/misc/compression.hpp>
 #include <components/settings/settings.hpp>
 
+#include <sstream>
+
 #include "../mwbase/environment.hpp"
 #include "../mwbase/world.hpp"
 
@@ -64,6 +68,8 @@ MWWorld::CellStore* MWWorld::WorldModel::getCellStore(const ESM::Cell* cell)
 {
     if (cell->mData.mFlags & ESM::Cell::Interior)
     {
+        applyPendingInterior(cell->mName);
+
         auto result = mInteriors.find(cell->mName);
 
         if (result == mInteriors.end())
@@ -73,6 +79,8 @@ MWWorld::CellStore* MWWorld::WorldModel::getCellStore(const ESM::Cell* cell)
     }
     else
     {
+        applyPendingExterior(cell->getGridX(), cell->getGridY());
+
         std::map<std::pair<int, int>, CellStore>::iterator result
             = mExteriors.find(std::make_pair(cell->getGridX(), cell->getGridY()));
 
@@ -93,6 +101,10 @@ void MWWorld::WorldModel::clear()
     mLastGeneratedRefnum = ESM::RefNum{};
     mInteriors.clear();
     mExteriors.clear();
+    mPendingInteriors.clear();
+    mPendingExteriors.clear();
+    mPendingRefNums.clear();
+    mPendingContentFileMap.clear();
     std::fill(mIdCache.begin(), mIdCache.end(), std::make_pair(ESM::RefId(), (MWWorld::CellStore*)nullptr));
     mIdCacheIndex = 0;
 }
@@ -150,11 +162,93 @@ void MWWorld::WorldModel::writeCell(ESM::ESMWriter& writer, CellStore& cell) con
     writer.endRecord(ESM::REC_CSTA);
 }
 
+void MWWorld::WorldModel::writeCompressedCell(
+    ESM::ESMWriter& writer, CellStore& cell, const std::vector<ESM::RefNum>& refNums) const
+{
+    // The record is written as a separate file to be read later by a separate reader.
+    std::stringstream stream;
+
+    ESM::ESMWriter cellWriter;
+    cellWriter.setFormatVersion(ESM::CurrentSaveGameFormatVersion);
+    cellWriter.setVersion(0);
+    cellWriter.setType(0);
+    cellWriter.setAuthor("");
+    cellWriter.setDescription("");
+    cellWriter.setRecordCount(1);
+    cellWriter.save(stream);
+    writeCell(cellWriter, cell);
+    cellWriter.close();
+
+    const std::string data = std::move(stream).str();
+    const std::byte* const begin = reinterpret_cast<const std::byte*>(data.data());
+
+    PendingCellState state;
+    state.mId = cell.getCell()->getCellId();
+    state.mRefNums = refNums;
+    state.mData = Misc::compress(std::vector<std::byte>(begin, begin + data.size()));
+
+    writePendingCell(writer, state);
+}
+
+void MWWorld::WorldModel::writePendingCell(ESM::ESMWriter& writer, const PendingCellState& state) const
+{
+    writer.startRecord(ESM::REC_CSTC);
+    state.mId.save(writer);
+    for (const ESM::RefNum& refNum : state.mRefNums)
+        refNum.save(writer, true, "REFN");
+    writer.startSubRecord("DATA");
+    writer.write(reinterpret_cast<const char*>(state.mData.data()), state.mData.size());
+    writer.endRecord("DATA");
+    writer.endRecord(ESM::REC_CSTC);
+}
+
+void MWWorld::WorldModel::applyPendingState(PendingCellState&& state)
+{
+    for (const ESM::RefNum& refNum : state.mRefNums)
+        mPendingRefNums.erase(refNum);
+
+    try
+    {
+        readCompressedCell(state, mPendingContentFileMap);
+    }
+    catch (const std::exception& e)
+    {
+        Log(Debug::Error) << "Failed to load saved state for cell " << state.mId.mWorldspace << ": " << e.what();
+    }
+}
+
+void MWWorld::WorldModel::applyPendingExterior(int x, int y)
+{
+    const auto it = mPendingExteriors.find(std::make_pair(x, y));
+    if (it == mPendingExteriors.end())
+        return;
+    // Remove it first, the state is applied via getExterior.
+    applyPendingState(std::move(mPendingExteriors.extract(it).mapped()));
+}
+
+void MWWorld::WorldModel::applyPendingInterior(std::string_view name)
+{
+    const auto it = mPendingInteriors.find(name);
+    if (it == mPendingInteriors.end())
+        return;
+    // Remove it first, the state is applied via getInterior.
+    applyPendingState(std::move(mPendingInteriors.extract(it).mapped()));
+}
+
+void MWWorld::WorldModel::applyPendingCell(const ESM::CellId& id)
+{
+    if (id.mPaged)
+        applyPendingExterior(id.mIndex.mX, id.mIndex.mY);
+    else
+        applyPendingInterior(id.mWorldspace);
+}
+
 MWWorld::WorldModel::WorldModel(const MWWorld::ESMStore& store, ESM::ReadersCache& readers)
     : mStore(store)
     , mReaders(readers)
     , mIdCacheIndex(0)
     , mPtrIndexUpdateCounter(0)
+    , mLazyCellStates(Settings::Manager::getBool("lazy cell states", "Saves"))
 {
     int cacheSize = std::clamp(Settings::Manager::getInt("pointers cache size", "Cells"), 40, 1000);
     mIdCache = IdCache(cacheSize, std::pair<ESM::RefId, CellStore*>(ESM::RefId(), (CellStore*)nullptr));
@@ -162,6 +256,8 @@ MWWorld::WorldModel::WorldModel(const MWWorld::ESMStore& store, ESM::ReadersCach
 
 MWWorld::CellStore* MWWorld::WorldModel::getExterior(int x, int y)
 {
+    applyPendingExterior(x, y);
+
     std::map<std::pair<int, int>, CellStore>::iterator result = mExteriors.find(std::make_pair(x, y));
 
     if (result == mExteriors.end())
@@ -199,6 +295,8 @@ MWWorld::CellStore* MWWorld::WorldModel::getExterior(int x, int y)
 
 MWWorld::CellStore* MWWorld::WorldModel::getInterior(std::string_view name)
 {
+    applyPendingInterior(name);
+
     auto result = mInteriors.find(name);
 
     if (result == mInteriors.end())
@@ -379,6 +477,10 @@ MWWorld::Ptr MWWorld::WorldModel::getPtr(const ESM::RefId& name)
 
 MWWorld::Ptr MWWorld::WorldModel::getPtr(const ESM::RefId& id, const ESM::RefNum& refNum)
 {
+    const auto pending = mPendingRefNums.find(refNum);
+    if (pending != mPendingRefNums.end())
+        applyPendingCell(ESM::CellId(pending->second));
+
     for (auto& pair : mInteriors)
     {
         Ptr ptr = getPtr(pair.second, id, refNum);
@@ -438,6 +540,11 @@ void MWWorld::WorldModel::getInteriorPtrs(const ESM::RefId& name, std::vector<MW
 
 std::vector<MWWorld::Ptr> MWWorld::WorldModel::getAll(const ESM::RefId& id)
 {
+    while (!mPendingExteriors.empty())
+        applyPendingExterior(mPendingExteriors.begin()->first.first, mPendingExteriors.begin()->first.second);
+    while (!mPendingInteriors.empty())
+        applyPendingInterior(mPendingInteriors.begin()->first);
+
     PtrCollector visitor;
     if (forEachInStore(id, visitor, mInteriors))
         forEachInStore(id, visitor, mExteriors);
@@ -446,7 +553,7 @@ std::vector<MWWorld::Ptr> MWWorld::WorldModel::getAll(const ESM::RefId& id)
 
 int MWWorld::WorldModel::countSavedGameRecords() const
 {
-    int count = 0;
+    int count = static_cast<int>(mPendingInteriors.size() + mPendingExteriors.size());
 
     for (auto iter(mInteriors.begin()); iter != mInteriors.end(); ++iter)
         if (iter->second.hasState())
@@ -460,21 +567,43 @@ int MWWorld::WorldModel::countSavedGameRecords() const
     return count;
 }
 
-void MWWorld::WorldModel::write(ESM::ESMWriter& writer, Loading::Listener& progress) const
+void MWWorld::WorldModel::write(
+    ESM::ESMWriter& writer, Loading::Listener& progress, const std::set<CellStore*>& activeCells) const
 {
+    std::unordered_map<const CellStore*, std::vector<ESM::RefNum>> refNums;
+    if (mLazyCellStates)
+        for (const auto& [refNum, ptr] : mPtrIndex)
+            if (ptr.isInCell())
+                refNums[ptr.getCell()].push_back(refNum);
+
+    const auto writeState = [&](CellStore& cell) {
+        // Cells with references moved away can't be loaded lazily because they define the content of other cells.
+        if (mLazyCellStates && !activeCells.contains(&cell) && !cell.hasRefsMovedToAnotherCell())
+            writeCompressedCell(writer, cell, refNums[&cell]);
+        else
+            writeCell(writer, cell);
+        progress.increaseProgress();
+    };
+
     for (std::map<std::pair<int, int>, CellStore>::iterator iter(mExteriors.begin()); iter != mExteriors.end(); ++iter)
         if (iter->second.hasState())
-        {
-            writeCell(writer, iter->second);
-            progress.increaseProgress();
-        }
+            writeState(iter->second);
+
+    for (const auto& [_, state] : mPendingExteriors)
+    {
+        writePendingCell(writer, state);
+        progress.increaseProgress();
+    }
 
     for (auto iter(mInteriors.begin()); iter != mInteriors.end(); ++iter)
         if (iter->second.hasState())
-        {
-            writeCell(writer, iter->second);
-            progress.increaseProgress();
-        }
+            writeState(iter->second);
+
+    for (const auto& [_, state] : mPendingInteriors)
+    {
+        writePendingCell(writer, state);
+        progress.increaseProgress();
+    }
 }
 
 struct GetCellStoreCallback : public MWWorld::CellStore::GetCellStoreCallback
@@ -500,41 +629,116 @@ public:
     }
 };
 
-bool MWWorld::WorldModel::readRecord(ESM::ESMReader& reader, uint32_t type, const std::map<int, int>& contentFileMap)
+void MWWorld::WorldModel::readCell(ESM::ESMReader& reader, const std::map<int, int>& contentFileMap)
 {
-    if (type == ESM::REC_CSTA)
+    ESM::CellState state;
+    state.mId.load(reader);
+
+    CellStore* cellStore = nullptr;
+
+    try
     {
-        ESM::CellState state;
-        state.mId.load(reader);
+        cellStore = getCell(state.mId);
+    }
+    catch (...)
+    {
+        // silently drop cells that don't exist anymore
+        Log(Debug::Warning) << "Warning: Dropping state for cell " << state.mId.mWorldspace
+                            << " (cell no longer exists)";
+        reader.skipRecord();
+        return;
+    }
 
-        CellStore* cellStore = nullptr;
+    state.load(reader);
+    cellStore->loadState(state);
 
-        try
-        {
-            cellStore = getCell(state.mId);
-        }
-        catch (...)
-        {
-            // silently drop cells that don't exist anymore
-            Log(Debug::Warning) << "Warning: Dropping state for cell " << state.mId.mWorldspace
-                                << " (cell no longer exists)";
-            reader.skipRecord();
-            return true;
-        }
+    if (state.mHasFogOfWar)
+        cellStore->readFog(reader);
 
-        state.load(reader);
-        cellStore->loadState(state);
+    if (cellStore->getState() != CellStore::State_Loaded)
+        cellStore->load();
 
-        if (state.mHasFogOfWar)
-            cellStore->readFog(reader);
+    GetCellStoreCallback callback(*this);
 
-        if (cellStore->getState() != CellStore::State_Loaded)
-            cellStore->load();
+    cellStore->readReferences(reader, contentFileMap, &callback);
+}
+
+void MWWorld::WorldModel::readCompressedCell(const PendingCellState& state, const std::map<int, int>& contentFileMap)
+{
+    const std::vector<std::byte> data = Misc::decompress(state.mData);
 
-        GetCellStoreCallback callback(*this);
+    ESM::ESMReader reader;
+    reader.open(std::make_unique<Files::IMemStream>(reinterpret_cast<const char*>(data.data()), data.size()),
+        state.mId.mWorldspace);
+
+    if (reader.getRecName().toInt() != ESM::REC_CSTA)
+        throw std::runtime_error("Invalid compressed cell state");
+    reader.getRecHeader();
+
+    readCell(reader, contentFileMap);
+}
+
+void MWWorld::WorldModel::addPendingCell(PendingCellState&& state, const std::map<int, int>& contentFileMap)
+{
+    // References in the pending states are written back as is, it's possible only with the same content files.
+    bool sameContentFiles
+        = contentFileMap.size() == MWBase::Environment::get().getWorld()->getContentFiles().size();
+    for (const auto& [saved, current] : contentFileMap)
+        sameContentFiles = sameContentFiles && saved == current;
 
-        cellStore->readReferences(reader, contentFileMap, &callback);
+    const bool hasCellStore = state.mId.mPaged
+        ? mExteriors.contains(std::make_pair(state.mId.mIndex.mX, state.mId.mIndex.mY))
+        : mInteriors.contains(state.mId.mWorldspace);
+
+    if (!mLazyCellStates || !sameContentFiles || hasCellStore)
+    {
+        readCompressedCell(state, contentFileMap);
+        return;
+    }
+
+    if (!state.mId.mPaged && mStore.get<ESM::Cell>().search(state.mId.mWorldspace) == nullptr
+        && mStore.get<ESM4::Cell>().searchCellName(state.mId.mWorldspace) == nullptr)
+    {
+        Log(Debug::Warning) << "Warning: Dropping state for cell " << state.mId.mWorldspace
+                            << " (cell no longer exists)";
+        return;
+    }
+
+    mPendingContentFileMap = contentFileMap;
+    for (const ESM::RefNum& refNum : state.mRefNums)
+        mPendingRefNums.emplace(refNum, state.mId);
+
+    if (state.mId.mPaged)
+        mPendingExteriors.emplace(std::make_pair(state.mId.mIndex.mX, state.mId.mIndex.mY), std::move(state));
+    else
+        mPendingInteriors.emplace(state.mId.mWorldspace, std::move(state));
+}
+
+bool MWWorld::WorldModel::readRecord(ESM::ESMReader& reader, uint32_t type, const std::map<int, int>& contentFileMap)
+{
+    if (type == ESM::REC_CSTA)
+    {
+        readCell(reader, contentFileMap);
+        return true;
+    }
+
+    if (type == ESM::REC_CSTC)
+    {
+        PendingCellState state;
+        state.mId.load(reader);
+        while (reader.isNextSub("REFN"))
+        {
+            ESM::RefNum refNum;
+            reader.cacheSubName();
+            refNum.load(reader, true, "REFN");
+            state.mRefNums.push_back(refNum);
+        }
+        reader.getSubNameIs("DATA");
+        reader.getSubHeader();
+        state.mData.resize(reader.getSubSize());
+        reader.getExact(state.mData.data(), static_cast<int>(state.mData.size()));
 
+        addPendingCell(std::move(state), contentFileMap);
         return true;
     }
 
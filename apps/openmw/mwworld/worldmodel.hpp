@@ -1,11 +1,17 @@
 #ifndef GAME_MWWORLD_WORLDMODEL_H
 #define GAME_MWWORLD_WORLDMODEL_H
 
+#include <cstddef>
 #include <list>
 #include <map>
+#include <set>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <variant>
+#include <vector>
+
+#include <components/esm3/cellid.hpp>
 
 #include <components/misc/algorithm.hpp>
 
@@ -17,7 +23,6 @@ namespace ESM
     class ESMReader;
     class ESMWriter;
     class ReadersCache;
-    struct CellId;
     struct Cell;
     struct RefNum;
 }
@@ -58,11 +63,44 @@ namespace MWWorld
 
         Ptr getPtr(CellStore& cellStore, const ESM::RefId& id, const ESM::RefNum& refNum);
 
+        // Saved state of a cell that is not applied yet: the compressed REC_CSTA record and the references it
+        // contains. It is applied when the cell is accessed for the first time.
+        struct PendingCellState
+        {
+            ESM::CellId mId;
+            std::vector<ESM::RefNum> mRefNums;
+            std::vector<std::byte> mData;
+        };
+
         void writeCell(ESM::ESMWriter& writer, CellStore& cell) const;
 
+        void writeCompressedCell(
+            ESM::ESMWriter& writer, CellStore& cell, const std::vector<ESM::RefNum>& refNums) const;
+
+        void writePendingCell(ESM::ESMWriter& writer, const PendingCellState& state) const;
+
+        void readCell(ESM::ESMReader& reader, const std::map<int, int>& contentFileMap);
+
+        void readCompressedCell(const PendingCellState& state, const std::map<int, int>& contentFileMap);
+
+        void addPendingCell(PendingCellState&& state, const std::map<int, int>& contentFileMap);
+
+        void applyPendingState(PendingCellState&& state);
+
+        void applyPendingExterior(int x, int y);
+
+        void applyPendingInterior(std::string_view name);
+
+        void applyPendingCell(const ESM::CellId& id);
+
         std::unordered_map<ESM::RefNum, Ptr> mPtrIndex;
         size_t mPtrIndexUpdateCounter;
         ESM::RefNum mLastGeneratedRefnum;
+        bool mLazyCellStates;
+        std::map<std::string, PendingCellState, Misc::StringUtils::CiComp> mPendingInteriors;
+        std::map<std::pair<int, int>, PendingCellState> mPendingExteriors;
+        std::unordered_map<ESM::RefNum, ESM::CellId> mPendingRefNums;
+        std::map<int, int> mPendingContentFileMap;
 
     public:
         void clear();
@@ -120,7 +158,10 @@ namespace MWWorld
 
         int countSavedGameRecords() const;
 
-        void write(ESM::ESMWriter& writer, Loading::Listener& progress) const;
+        void write(
+            ESM::ESMWriter& writer, Loading::Listener& progress, const std::set<CellStore*>& activeCells) const;
+        ///< With "lazy cell states" enabled the states of cells other than \a activeCells are compressed and not
+        /// applied on load until the cell is accessed.
 
         bool readRecord(ESM::ESMReader& reader, uint32_t type, const std::map<int, int>& contentFileMap);
     };
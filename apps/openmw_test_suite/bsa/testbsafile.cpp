@@ -0,0 +1,86 @@
+#include <components/bsa/bsa_file.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+#include "../testing_util.hpp"
+
+namespace
+{
+    using namespace testing;
+    using namespace TestingOpenMW;
+    using namespace Bsa;
+
+    std::string readAll(std::istream& stream)
+    {
+        return std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+
+    std::filesystem::path makeArchivePath()
+    {
+        std::string fileName(UnitTest::GetInstance()->current_test_info()->name());
+        std::replace(fileName.begin(), fileName.end(), '/', '_');
+        return outputFilePath(fileName + ".bsa");
+    }
+
+    struct BsaBSAFileTest : TestWithParam<bool>
+    {
+        const std::filesystem::path mPath = makeArchivePath();
+
+        BsaBSAFileTest()
+        {
+            std::filesystem::remove(mPath);
+            BSAFile file;
+            file.open(mPath);
+            std::istringstream foo("foo content");
+            file.addFile("meshes\\foo.nif", foo);
+            std::istringstream bar("bar");
+            file.addFile("textures\\bar.dds", bar);
+        }
+    };
+
+    TEST_P(BsaBSAFileTest, getFile_should_return_file_content)
+    {
+        BSAFile file;
+        file.open(mPath, GetParam());
+        ASSERT_EQ(file.getList().size(), 2);
+        for (const BSAFile::FileStruct& fileStruct : file.getList())
+        {
+            const Files::IStreamPtr stream = file.getFile(&fileStruct);
+            if (std::string(fileStruct.name()) == "meshes\\foo.nif")
+                EXPECT_EQ(readAll(*stream), "foo content");
+            else
+                EXPECT_EQ(readAll(*stream), "bar");
+        }
+    }
+
+    TEST_P(BsaBSAFileTest, file_stream_should_be_valid_after_close)
+    {
+        BSAFile file;
+        file.open(mPath, GetParam());
+        const BSAFile::FileStruct fileStruct = file.getList().front();
+        const Files::IStreamPtr stream = file.getFile(&fileStruct);
+        file.close();
+        EXPECT_EQ(readAll(*stream).size(), fileStruct.fileSize);
+    }
+
+    TEST_P(BsaBSAFileTest, file_stream_should_support_seek)
+    {
+        BSAFile file;
+        file.open(mPath, GetParam());
+        const BSAFile::FileStruct fileStruct = file.getList().front();
+        const Files::IStreamPtr stream = file.getFile(&fileStruct);
+        stream->seekg(1);
+        const std::string content = readAll(*stream);
+        stream->clear();
+        stream->seekg(0, std::ios_base::beg);
+        EXPECT_EQ(readAll(*stream).substr(1), content);
+    }
+
+    INSTANTIATE_TEST_SUITE_P(Mapped, BsaBSAFileTest, Values(false, true));
+}
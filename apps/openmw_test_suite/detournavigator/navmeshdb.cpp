@@ -1,15 +1,23 @@
+#include "../testing_util.hpp"
 #include "generate.hpp"
 
 #include <components/detournavigator/navmeshdb.hpp>
+#include <components/misc/compression.hpp>
+#include <components/sqlite3/db.hpp>
 
 #include <DetourAlloc.h>
 
+#include <sqlite3.h>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <filesystem>
 #include <limits>
 #include <numeric>
 #include <random>
+#include <string>
 
 namespace
 {
@@ -48,6 +56,25 @@ namespace
         }
     };
 
+    struct DetourNavigatorNavMeshDbFileTest : DetourNavigatorNavMeshDbTest
+    {
+        const std::filesystem::path mPath = TestingOpenMW::temporaryFilePath("navmeshdb_test.db");
+
+        DetourNavigatorNavMeshDbFileTest() { removeFiles(); }
+
+        ~DetourNavigatorNavMeshDbFileTest() override
+        {
+            mDb = NavMeshDb(":memory:", std::numeric_limits<std::uint64_t>::max());
+            removeFiles();
+        }
+
+        void removeFiles()
+        {
+            for (const char* suffix : { "", "-wal", "-shm" })
+                std::filesystem::remove(mPath.string() + suffix);
+        }
+    };
+
     TEST_F(DetourNavigatorNavMeshDbTest, get_max_tile_id_for_empty_db_should_return_zero)
     {
         EXPECT_EQ(mDb.getMaxTileId(), TileId{ 0 });
@@ -177,4 +204,61 @@ namespace
         };
         EXPECT_THROW(f(), std::runtime_error);
     }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, make_reader_for_in_memory_db_should_return_nullptr)
+    {
+        EXPECT_EQ(mDb.makeReader(), nullptr);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbFileTest, reader_should_get_tile_data_inserted_by_writer)
+    {
+        mDb = NavMeshDb(mPath.string(), std::numeric_limits<std::uint64_t>::max());
+        const std::unique_ptr<NavMeshDb> reader = mDb.makeReader();
+        ASSERT_NE(reader, nullptr);
+        const TileId tileId{ 42 };
+        const TileVersion version{ 1 };
+        const auto [worldspace, tilePosition, input, data] = insertTile(tileId, version);
+        const auto row = reader->getTileData(worldspace, tilePosition, input);
+        ASSERT_TRUE(row.has_value());
+        EXPECT_EQ(row->mTileId, tileId);
+        EXPECT_EQ(row->mVersion, version);
+        EXPECT_EQ(row->mData, data);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbFileTest, tile_inserted_without_input_hash_should_be_found_after_reopening)
+    {
+        const std::vector<std::byte> input = generateData();
+        {
+            const Sqlite3::Db db = Sqlite3::makeDb(mPath.string(), R"(
+                CREATE TABLE tiles (
+                    tile_id INTEGER PRIMARY KEY,
+                    revision INTEGER NOT NULL DEFAULT 1,
+                    worldspace TEXT NOT NULL,
+                    tile_position_x INTEGER NOT NULL,
+                    tile_position_y INTEGER NOT NULL,
+                    version INTEGER NOT NULL,
+                    input BLOB,
+                    data BLOB
+                );
+
+                CREATE UNIQUE INDEX index_unique_tiles_by_worldspace_and_tile_position_and_input
+                    ON tiles (worldspace, tile_position_x, tile_position_y, input);
+            )");
+            std::string query = "INSERT INTO tiles (tile_id, worldspace, tile_position_x, tile_position_y, version, "
+                                "input, data) VALUES (7, 'sys::default', 3, 4, 1, X'";
+            for (const std::byte v : Misc::compress(input))
+            {
+                char hex[3];
+                std::snprintf(hex, sizeof(hex), "%02X", static_cast<unsigned>(v));
+                query += hex;
+            }
+            query += "', NULL);";
+            ASSERT_EQ(sqlite3_exec(db.get(), query.c_str(), nullptr, nullptr, nullptr), SQLITE_OK);
+        }
+        mDb = NavMeshDb(mPath.string(), std::numeric_limits<std::uint64_t>::max());
+        const auto tile = mDb.findTile("sys::default", TilePosition{ 3, 4 }, input);
+        ASSERT_TRUE(tile.has_value());
+        EXPECT_EQ(tile->mTileId, TileId{ 7 });
+        EXPECT_EQ(tile->mVersion, TileVersion{ 1 });
+    }
 }
@@ -10,6 +10,9 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <memory>
+#include <vector>
+
 namespace
 {
     using namespace testing;
@@ -470,4 +473,72 @@ namespace
             ElementsAre(
                 std::pair(TilePosition(-1, -1), ChangeType::add), std::pair(TilePosition(0, 0), ChangeType::remove)));
     }
+
+    TEST_F(DetourNavigatorTileCachedRecastMeshManagerTest,
+        get_mesh_after_repeated_moving_object_updates_should_be_equal_to_new_mesh)
+    {
+        TileCachedRecastMeshManager manager(mSettings);
+        manager.setWorldspace("worldspace", nullptr);
+        std::vector<std::unique_ptr<btBoxShape>> staticShapes;
+        for (int i = 0; i < 8; ++i)
+        {
+            staticShapes.push_back(std::make_unique<btBoxShape>(btVector3(20 + i, 30, 100)));
+            const CollisionShape shape(mInstance, *staticShapes.back(), mObjectTransform);
+            const btTransform transform(btMatrix3x3::getIdentity(), btVector3(-600 + 150 * i, 50 * i - 200, 0));
+            ASSERT_TRUE(manager.addObject(
+                ObjectId(staticShapes.back().get()), shape, transform, AreaType::AreaType_ground, nullptr));
+        }
+        const btBoxShape movingShape(btVector3(50, 50, 10));
+        const CollisionShape shape(mInstance, movingShape, mObjectTransform);
+        ASSERT_TRUE(manager.addObject(
+            ObjectId(&movingShape), shape, btTransform::getIdentity(), AreaType::AreaType_ground, nullptr));
+        manager.takeChangedTiles(nullptr);
+        for (int i = 1; i <= 200; ++i)
+        {
+            const btTransform transform(btMatrix3x3::getIdentity(), btVector3(i * 7 % 500 - 250, i % 13 * 10, i % 5));
+            const AreaType areaType = i % 10 == 0 ? AreaType::AreaType_null : AreaType::AreaType_ground;
+            manager.updateObject(ObjectId(&movingShape), transform, areaType, nullptr);
+            for (const auto& [tilePosition, changeType] : manager.takeChangedTiles(nullptr))
+            {
+                const std::shared_ptr<RecastMesh> mesh = manager.getMesh("worldspace", tilePosition);
+                const std::shared_ptr<RecastMesh> newMesh = manager.getNewMesh("worldspace", tilePosition);
+                ASSERT_EQ(mesh == nullptr, newMesh == nullptr) << i << " " << tilePosition;
+                if (mesh == nullptr)
+                    continue;
+                EXPECT_EQ(mesh->getMesh().getVertices(), newMesh->getMesh().getVertices()) << i << " " << tilePosition;
+                EXPECT_EQ(mesh->getMesh().getIndices(), newMesh->getMesh().getIndices()) << i << " " << tilePosition;
+                EXPECT_EQ(mesh->getMesh().getAreaTypes(), newMesh->getMesh().getAreaTypes())
+                    << i << " " << tilePosition;
+                EXPECT_EQ(mesh->getMeshSources().size(), newMesh->getMeshSources().size())
+                    << i << " " << tilePosition;
+            }
+        }
+    }
+
+    TEST_F(DetourNavigatorTileCachedRecastMeshManagerTest,
+        get_mesh_after_removing_object_from_tile_with_moving_object_should_not_contain_removed_object)
+    {
+        TileCachedRecastMeshManager manager(mSettings);
+        manager.setWorldspace("worldspace", nullptr);
+        const btBoxShape staticShape(btVector3(20, 20, 100));
+        const CollisionShape staticCollisionShape(mInstance, staticShape, mObjectTransform);
+        ASSERT_TRUE(manager.addObject(ObjectId(&staticShape), staticCollisionShape, btTransform::getIdentity(),
+            AreaType::AreaType_ground, nullptr));
+        const btBoxShape movingShape(btVector3(10, 10, 10));
+        const CollisionShape movingCollisionShape(mInstance, movingShape, mObjectTransform);
+        ASSERT_TRUE(manager.addObject(ObjectId(&movingShape), movingCollisionShape, btTransform::getIdentity(),
+            AreaType::AreaType_ground, nullptr));
+        const btTransform transform(btMatrix3x3::getIdentity(), btVector3(1, 2, 3));
+        ASSERT_TRUE(manager.updateObject(ObjectId(&movingShape), transform, AreaType::AreaType_ground, nullptr));
+        manager.takeChangedTiles(nullptr);
+        ASSERT_NE(manager.getMesh("worldspace", TilePosition(0, 0)), nullptr);
+        manager.removeObject(ObjectId(&staticShape), nullptr);
+        manager.takeChangedTiles(nullptr);
+        const std::shared_ptr<RecastMesh> mesh = manager.getMesh("worldspace", TilePosition(0, 0));
+        ASSERT_NE(mesh, nullptr);
+        EXPECT_EQ(mesh->getMeshSources().size(), 1);
+        const std::shared_ptr<RecastMesh> newMesh = manager.getNewMesh("worldspace", TilePosition(0, 0));
+        ASSERT_NE(newMesh, nullptr);
+        EXPECT_EQ(mesh->getMesh().getVertices(), newMesh->getMesh().getVertices());
+    }
 }
@@ -0,0 +1,113 @@
+#include <components/esm3/esmreader.hpp>
+#include <components/esm3/esmwriter.hpp>
+#include <components/esm3/formatversion.hpp>
+#include <components/esm3/loadstat.hpp>
+#include <components/files/openfile.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../testing_util.hpp"
+
+namespace ESM
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        struct Esm3EsmReaderTest : Test
+        {
+            const std::filesystem::path mPath = TestingOpenMW::outputFilePath("esm3_esmreader.omwaddon");
+            std::vector<Static> mStatics;
+
+            void SetUp() override
+            {
+                for (int i = 0; i < 10; ++i)
+                {
+                    Static record;
+                    record.blank();
+                    record.mId = RefId::stringRefId("static" + std::to_string(i));
+                    record.mModel = "meshes\\static" + std::to_string(i) + ".nif";
+                    mStatics.push_back(record);
+                }
+
+                std::ofstream stream(mPath, std::ios::binary);
+                ESMWriter writer;
+                writer.setFormatVersion(CurrentContentFormatVersion);
+                writer.save(stream);
+                for (const Static& record : mStatics)
+                {
+                    writer.startRecord(REC_STAT);
+                    record.save(writer);
+                    writer.endRecord(REC_STAT);
+                }
+                writer.close();
+            }
+
+            std::vector<Static> readAll(ESMReader& reader)
+            {
+                std::vector<Static> result;
+                while (reader.hasMoreRecs())
+                {
+                    EXPECT_EQ(reader.getRecName().toInt(), REC_STAT);
+                    reader.getRecHeader();
+                    Static record;
+                    bool isDeleted = false;
+                    record.load(reader, isDeleted);
+                    result.push_back(record);
+                }
+                return result;
+            }
+        };
+
+        TEST_F(Esm3EsmReaderTest, openByPathShouldReadSameRecordsAsFromStream)
+        {
+            ESMReader streamReader;
+            streamReader.open(Files::openBinaryInputFileStream(mPath), mPath);
+            const std::vector<Static> fromStream = readAll(streamReader);
+
+            ESMReader mappedReader;
+            mappedReader.open(mPath);
+            EXPECT_EQ(mappedReader.getFileSize(), streamReader.getFileSize());
+            const std::vector<Static> fromMapping = readAll(mappedReader);
+
+            ASSERT_EQ(fromMapping.size(), mStatics.size());
+            ASSERT_EQ(fromStream.size(), mStatics.size());
+            for (std::size_t i = 0; i < mStatics.size(); ++i)
+            {
+                EXPECT_EQ(fromMapping[i].mId, mStatics[i].mId);
+                EXPECT_EQ(fromMapping[i].mModel, mStatics[i].mModel);
+                EXPECT_EQ(fromStream[i].mId, mStatics[i].mId);
+                EXPECT_EQ(fromStream[i].mModel, mStatics[i].mModel);
+            }
+            EXPECT_EQ(mappedReader.getFileOffset(), streamReader.getFileOffset());
+        }
+
+        TEST_F(Esm3EsmReaderTest, restoreContextShouldContinueFromSavedPositionForMappedFile)
+        {
+            ESMReader reader;
+            reader.open(mPath);
+            ASSERT_TRUE(reader.hasMoreRecs());
+            const ESM_Context context = reader.getContext();
+            const std::vector<Static> first = readAll(reader);
+            reader.restoreContext(context);
+            const std::vector<Static> second = readAll(reader);
+            ASSERT_EQ(second.size(), first.size());
+            for (std::size_t i = 0; i < first.size(); ++i)
+                EXPECT_EQ(second[i].mModel, first[i].mModel);
+        }
+
+        TEST_F(Esm3EsmReaderTest, readingBeyondEndOfMappedFileShouldThrowException)
+        {
+            std::filesystem::resize_file(mPath, std::filesystem::file_size(mPath) - 4);
+            ESMReader reader;
+            reader.open(mPath);
+            EXPECT_THROW(readAll(reader), std::runtime_error);
+        }
+    }
+}
@@ -0,0 +1,60 @@
+#include <components/esm3terrain/storage.hpp>
+#include <components/misc/constants.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace ESMTerrain;
+
+    constexpr float cellSize = Constants::CellSizeInUnits;
+
+    std::unique_ptr<ESM::Land::LandData> makeLandData()
+    {
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> distribution(-1000, 1000);
+        auto result = std::make_unique<ESM::Land::LandData>();
+        for (float& height : result->mHeights)
+            height = distribution(random);
+        return result;
+    }
+
+    TEST(ESM3TerrainGetHeightsAtTest, shouldReturnVertexHeightsForPositionsAtVertices)
+    {
+        const auto data = makeLandData();
+        const float step = cellSize / (ESM::Land::LAND_SIZE - 1);
+        const std::vector<osg::Vec3f> positions{
+            osg::Vec3f(-cellSize, 2 * cellSize, 0),
+            osg::Vec3f(-cellSize + step, 2 * cellSize, 0),
+            osg::Vec3f(-cellSize + 3 * step, 2 * cellSize + 5 * step, 0),
+            osg::Vec3f(-cellSize + 64 * step, 2 * cellSize + 64 * step, 0),
+        };
+        std::vector<float> heights(positions.size());
+        getHeightsAt(*data, -1, 2, positions, heights);
+        EXPECT_FLOAT_EQ(heights[0], data->mHeights[0]);
+        EXPECT_FLOAT_EQ(heights[1], data->mHeights[1]);
+        EXPECT_FLOAT_EQ(heights[2], data->mHeights[5 * ESM::Land::LAND_SIZE + 3]);
+        EXPECT_FLOAT_EQ(heights[3], data->mHeights[ESM::Land::LAND_NUM_VERTS - 1]);
+    }
+
+    TEST(ESM3TerrainGetHeightsAtTest, shouldMatchGetHeightAtForRandomPositions)
+    {
+        const auto data = makeLandData();
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> distribution(0, cellSize);
+        std::vector<osg::Vec3f> positions;
+        // Not a multiple of the block size to cover the remainder
+        for (std::size_t i = 0; i < 1003; ++i)
+            positions.emplace_back(3 * cellSize + distribution(random), -4 * cellSize + distribution(random), 0);
+        std::vector<float> heights(positions.size());
+        getHeightsAt(*data, 3, -4, positions, heights);
+        for (std::size_t i = 0; i < positions.size(); ++i)
+            EXPECT_NEAR(heights[i], getHeightAt(*data, 3, -4, positions[i]), 0.1f) << i;
+    }
+}
@@ -5,7 +5,10 @@
 #include <components/esm3/loadgmst.hpp>
 #include <components/esm3/loadland.hpp>
 #include <components/esm3/loadstat.hpp>
+#include <components/esm3/esmwriter.hpp>
+#include <components/esm3/formatversion.hpp>
 #include <components/esm3/readerscache.hpp>
+#include <components/esmloader/cache.hpp>
 #include <components/esmloader/esmdata.hpp>
 #include <components/esmloader/load.hpp>
 #include <components/files/collections.hpp>
@@ -14,6 +17,10 @@
 
 #include <gtest/gtest.h>
 
+#include <fstream>
+
+#include "../testing_util.hpp"
+
 #ifndef OPENMW_DATA_DIR
 #error "OPENMW_DATA_DIR is not defined"
 #endif
@@ -133,4 +140,186 @@ namespace
         EXPECT_EQ(esmData.mLands.size(), 0);
         EXPECT_EQ(esmData.mStatics.size(), 0);
     }
+
+    struct EsmLoaderMultipleFilesTest : TestWithParam<std::size_t>
+    {
+        const std::filesystem::path mDataDir = TestingOpenMW::outputFilePath("esmloader");
+        const Files::PathContainer mDataDirs{ mDataDir };
+        const std::vector<std::string> mContentFiles{ { "base.omwgame", "addon1.omwaddon", "addon2.omwaddon" } };
+
+        static ESM::Static makeStatic(std::string_view id, std::string_view model)
+        {
+            ESM::Static result;
+            result.blank();
+            result.mId = ESM::RefId::stringRefId(id);
+            result.mModel = model;
+            return result;
+        }
+
+        static ESM::Cell makeInterior(const std::string& name, float water)
+        {
+            ESM::Cell result;
+            result.mName = name;
+            result.mData.mFlags = ESM::Cell::Interior;
+            result.mWater = water;
+            return result;
+        }
+
+        static ESM::Cell makeExterior(int x, int y)
+        {
+            ESM::Cell result;
+            result.mData.mFlags = 0;
+            result.mData.mX = x;
+            result.mData.mY = y;
+            return result;
+        }
+
+        void writeContentFile(const std::string& name, const std::vector<std::string>& masters,
+            const std::vector<ESM::Static>& statics, const std::vector<ESM::Cell>& cells)
+        {
+            std::ofstream stream(mDataDir / name, std::ios::binary);
+            ESM::ESMWriter writer;
+            writer.setFormatVersion(ESM::CurrentContentFormatVersion);
+            for (const std::string& master : masters)
+                writer.addMaster(master, 0);
+            writer.save(stream);
+            for (const ESM::Static& value : statics)
+            {
+                writer.startRecord(ESM::REC_STAT);
+                value.save(writer);
+                writer.endRecord(ESM::REC_STAT);
+            }
+            for (const ESM::Cell& value : cells)
+            {
+                writer.startRecord(ESM::REC_CELL);
+                value.save(writer);
+                writer.endRecord(ESM::REC_CELL);
+            }
+            writer.close();
+        }
+
+        void SetUp() override
+        {
+            std::filesystem::create_directories(mDataDir);
+            writeContentFile("base.omwgame", {}, { makeStatic("a", "a.nif"), makeStatic("b", "b.nif") },
+                { makeInterior("Interior", 1), makeExterior(0, 0) });
+            writeContentFile("addon1.omwaddon", { "base.omwgame" }, { makeStatic("b", "b1.nif") },
+                { makeInterior("Interior", 2), makeInterior("Interior", 3), makeExterior(1, 0) });
+            writeContentFile("addon2.omwaddon", { "base.omwgame", "addon1.omwaddon" },
+                { makeStatic("c", "c.nif"), makeStatic("b", "b2.nif") }, { makeExterior(1, 0) });
+        }
+    };
+
+    TEST_P(EsmLoaderMultipleFilesTest, loadEsmDataShouldApplyOverridesInLoadOrder)
+    {
+        Query query;
+        query.mLoadCells = true;
+        query.mLoadStatics = true;
+        const Files::Collections fileCollections(mDataDirs, true);
+        ESM::ReadersCache readers;
+        ToUTF8::Utf8Encoder* const encoder = nullptr;
+        const EsmData esmData
+            = loadEsmData(query, mContentFiles, fileCollections, readers, encoder, nullptr, GetParam());
+
+        ASSERT_EQ(esmData.mStatics.size(), 3);
+        EXPECT_EQ(esmData.mStatics[0].mId, ESM::RefId::stringRefId("a"));
+        EXPECT_EQ(esmData.mStatics[1].mId, ESM::RefId::stringRefId("b"));
+        EXPECT_EQ(esmData.mStatics[1].mModel, "b2.nif");
+        EXPECT_EQ(esmData.mStatics[2].mId, ESM::RefId::stringRefId("c"));
+
+        ASSERT_EQ(esmData.mCells.size(), 3);
+        EXPECT_EQ(esmData.mCells[0].mName, "Interior");
+        EXPECT_EQ(esmData.mCells[0].mWater, 3);
+        ASSERT_EQ(esmData.mCells[0].mContextList.size(), 3);
+        EXPECT_EQ(esmData.mCells[0].mContextList[0].index, 0);
+        EXPECT_EQ(esmData.mCells[0].mContextList[1].index, 1);
+        EXPECT_EQ(esmData.mCells[0].mContextList[2].index, 1);
+        EXPECT_EQ(esmData.mCells[1].mContextList.size(), 1);
+        EXPECT_EQ(esmData.mCells[2].mData.mX, 1);
+        ASSERT_EQ(esmData.mCells[2].mContextList.size(), 2);
+        EXPECT_EQ(esmData.mCells[2].mContextList[0].index, 1);
+        EXPECT_EQ(esmData.mCells[2].mContextList[1].index, 2);
+        EXPECT_EQ(esmData.mCells[2].mContextList[1].parentFileIndices, std::vector<int>({ 0, 1 }));
+    }
+
+    TEST_P(EsmLoaderMultipleFilesTest, loadCachedEsmDataShouldReuseWrittenCache)
+    {
+        Query query;
+        query.mLoadCells = true;
+        query.mLoadStatics = true;
+        const Files::Collections fileCollections(mDataDirs, true);
+        const std::filesystem::path cachePath = mDataDir / "esmdata.cache";
+        std::filesystem::remove(cachePath);
+        ToUTF8::Utf8Encoder* const encoder = nullptr;
+
+        ESM::ReadersCache loadedReaders;
+        const EsmData loaded = loadCachedEsmData(
+            cachePath, query, mContentFiles, fileCollections, loadedReaders, encoder, nullptr, GetParam());
+        ASSERT_TRUE(std::filesystem::exists(cachePath));
+
+        ESM::ReadersCache cachedReaders;
+        const EsmData cached = loadCachedEsmData(
+            cachePath, query, mContentFiles, fileCollections, cachedReaders, encoder, nullptr, GetParam());
+
+        ASSERT_EQ(cached.mStatics.size(), loaded.mStatics.size());
+        for (std::size_t i = 0; i < cached.mStatics.size(); ++i)
+        {
+            EXPECT_EQ(cached.mStatics[i].mId, loaded.mStatics[i].mId);
+            EXPECT_EQ(cached.mStatics[i].mModel, loaded.mStatics[i].mModel);
+        }
+        ASSERT_EQ(cached.mCells.size(), loaded.mCells.size());
+        for (std::size_t i = 0; i < cached.mCells.size(); ++i)
+        {
+            EXPECT_EQ(cached.mCells[i].mName, loaded.mCells[i].mName);
+            EXPECT_EQ(cached.mCells[i].mWater, loaded.mCells[i].mWater);
+            EXPECT_EQ(cached.mCells[i].mData.mX, loaded.mCells[i].mData.mX);
+            EXPECT_EQ(cached.mCells[i].mData.mY, loaded.mCells[i].mData.mY);
+            ASSERT_EQ(cached.mCells[i].mContextList.size(), loaded.mCells[i].mContextList.size());
+            for (std::size_t j = 0; j < cached.mCells[i].mContextList.size(); ++j)
+            {
+                const ESM::ESM_Context& cachedContext = cached.mCells[i].mContextList[j];
+                const ESM::ESM_Context& loadedContext = loaded.mCells[i].mContextList[j];
+                EXPECT_EQ(cachedContext.index, loadedContext.index);
+                EXPECT_EQ(cachedContext.filePos, loadedContext.filePos);
+                EXPECT_EQ(cachedContext.leftFile, loadedContext.leftFile);
+                EXPECT_EQ(cachedContext.parentFileIndices, loadedContext.parentFileIndices);
+            }
+        }
+        ASSERT_EQ(cached.mRefIdTypes.size(), loaded.mRefIdTypes.size());
+        for (std::size_t i = 0; i < cached.mRefIdTypes.size(); ++i)
+        {
+            EXPECT_EQ(cached.mRefIdTypes[i].mId, loaded.mRefIdTypes[i].mId);
+            EXPECT_EQ(cached.mRefIdTypes[i].mType, loaded.mRefIdTypes[i].mType);
+        }
+        EXPECT_EQ(cachedReaders.get(2)->getIndex(), 2);
+    }
+
+    TEST_P(EsmLoaderMultipleFilesTest, loadCachedEsmDataShouldReloadChangedContentFiles)
+    {
+        Query query;
+        query.mLoadStatics = true;
+        const Files::Collections fileCollections(mDataDirs, true);
+        const std::filesystem::path cachePath = mDataDir / "esmdata.cache";
+        std::filesystem::remove(cachePath);
+        ToUTF8::Utf8Encoder* const encoder = nullptr;
+
+        {
+            ESM::ReadersCache readers;
+            const EsmData esmData = loadCachedEsmData(
+                cachePath, query, mContentFiles, fileCollections, readers, encoder, nullptr, GetParam());
+            ASSERT_EQ(esmData.mStatics.size(), 3);
+            EXPECT_EQ(esmData.mStatics[1].mModel, "b2.nif");
+        }
+
+        writeContentFile("addon2.omwaddon", { "base.omwgame", "addon1.omwaddon" },
+            { makeStatic("c", "c.nif"), makeStatic("b", "b3.nif") }, {});
+
+        ESM::ReadersCache readers;
+        const EsmData esmData = loadCachedEsmData(
+            cachePath, query, mContentFiles, fileCollections, readers, encoder, nullptr, GetParam());
+        ASSERT_EQ(esmData.mStatics.size(), 3);
+        EXPECT_EQ(esmData.mStatics[1].mModel, "b3.nif");
+    }
+
+    INSTANTIATE_TEST_SUITE_P(ThreadsNumber, EsmLoaderMultipleFilesTest, Values(1, 2, 3));
 }
@@ -0,0 +1,107 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <sstream>
+
+#include <components/lua/configuration.hpp>
+#include <components/lua/handlersprofiler.hpp>
+
+namespace
+{
+    using namespace testing;
+    using namespace std::chrono_literals;
+    using LuaUtil::HandlersProfiler;
+    using HandlerType = HandlersProfiler::HandlerType;
+
+    TEST(LuaHandlersProfilerTest, nextFrameShouldSumCallsAndTimeOfFinishedFrame)
+    {
+        HandlersProfiler profiler;
+        profiler.add(0, HandlerType::Engine, "onUpdate", 1ms);
+        profiler.add(0, HandlerType::Engine, "onUpdate", 2ms);
+        profiler.add(1, HandlerType::Event, "Hit", 4ms);
+        EXPECT_EQ(profiler.getFrameCalls(), 0);
+        EXPECT_EQ(profiler.getFrameTime(), std::chrono::steady_clock::duration::zero());
+        profiler.nextFrame();
+        EXPECT_EQ(profiler.getFrameCalls(), 3);
+        EXPECT_EQ(profiler.getFrameTime(), 7ms);
+        profiler.nextFrame();
+        EXPECT_EQ(profiler.getFrameCalls(), 0);
+        EXPECT_EQ(profiler.getFrameTime(), std::chrono::steady_clock::duration::zero());
+    }
+
+    TEST(LuaHandlersProfilerTest, getStatsShouldReturnSlowestHandlersFirst)
+    {
+        HandlersProfiler profiler;
+        profiler.add(0, HandlerType::Engine, "onUpdate", 1ms);
+        profiler.add(1, HandlerType::Timer, "", 3ms);
+        profiler.add(1, HandlerType::Event, "Hit", 2ms);
+        profiler.add(1, HandlerType::Event, "Hit", 2ms);
+        profiler.nextFrame();
+        profiler.add(0, HandlerType::Engine, "onUpdate", 1ms);
+        profiler.nextFrame();
+
+        const std::vector<HandlersProfiler::HandlerStats> stats = profiler.getStats();
+        ASSERT_EQ(stats.size(), 3);
+
+        EXPECT_EQ(stats[0].mScriptId, 1);
+        EXPECT_EQ(stats[0].mType, HandlerType::Event);
+        EXPECT_EQ(stats[0].mName, "Hit");
+        EXPECT_EQ(stats[0].mFrameCalls, 0);
+        EXPECT_EQ(stats[0].mTotalCalls, 2);
+        EXPECT_EQ(stats[0].mTotalTime, 4ms);
+
+        EXPECT_EQ(stats[1].mScriptId, 1);
+        EXPECT_EQ(stats[1].mType, HandlerType::Timer);
+        EXPECT_EQ(stats[1].mTotalCalls, 1);
+
+        EXPECT_EQ(stats[2].mScriptId, 0);
+        EXPECT_EQ(stats[2].mName, "onUpdate");
+        EXPECT_EQ(stats[2].mFrameCalls, 1);
+        EXPECT_EQ(stats[2].mFrameTime, 1ms);
+        EXPECT_EQ(stats[2].mTotalCalls, 2);
+        EXPECT_EQ(stats[2].mTotalTime, 2ms);
+    }
+
+    TEST(LuaHandlersProfilerTest, scopeShouldAddMeasuredTime)
+    {
+        HandlersProfiler profiler;
+        {
+            const HandlersProfiler::Scope scope(&profiler, 2, HandlerType::Engine, "onActive");
+        }
+        {
+            const HandlersProfiler::Scope scope(nullptr, 3, HandlerType::Engine, "onActive");
+        }
+        profiler.nextFrame();
+        const std::vector<HandlersProfiler::HandlerStats> stats = profiler.getStats();
+        ASSERT_EQ(stats.size(), 1);
+        EXPECT_EQ(stats[0].mScriptId, 2);
+        EXPECT_EQ(stats[0].mName, "onActive");
+        EXPECT_EQ(stats[0].mFrameCalls, 1);
+    }
+
+    TEST(LuaHandlersProfilerTest, writeCollapsedStacksShouldWriteTotalTimePerScriptAndHandler)
+    {
+        ESM::LuaScriptsCfg cfg;
+        LuaUtil::parseOMWScripts(cfg, "GLOBAL: global.lua\nCUSTOM: custom.lua\n");
+        LuaUtil::ScriptsConfiguration conf;
+        conf.init(std::move(cfg));
+
+        HandlersProfiler profiler;
+        profiler.add(0, HandlerType::Engine, "onUpdate", 1500us);
+        profiler.add(1, HandlerType::Event, "Hit", 20us);
+        profiler.add(1, HandlerType::Timer, "callback", 300us);
+        profiler.add(1, HandlerType::Engine, "onSave", 7us);
+        profiler.nextFrame();
+        profiler.add(0, HandlerType::Engine, "onUpdate", 500us);
+        profiler.nextFrame();
+
+        std::ostringstream stream;
+        profiler.writeCollapsedStacks(conf, stream);
+        EXPECT_EQ(stream.str(),
+            "global.lua;onUpdate 2000\n"
+            "custom.lua;onSave 7\n"
+            "custom.lua;event:Hit 20\n"
+            "custom.lua;timer:callback 300\n");
+    }
+}
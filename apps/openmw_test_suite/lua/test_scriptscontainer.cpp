@@ -445,6 +445,51 @@ CUSTOM, PLAYER: useInterface.lua
         EXPECT_EQ(counter4, 25);
     }
 
+    TEST_F(LuaScriptsContainerTest, SharedTimers)
+    {
+        using TimerType = LuaUtil::ScriptsContainer::TimerType;
+        LuaUtil::ScriptsTimers timers;
+        LuaUtil::ScriptsContainer scripts1(&mLua, "Test1");
+        LuaUtil::ScriptsContainer scripts2(&mLua, "Test2");
+        int test1Id = *mCfg.findId("test1.lua");
+        EXPECT_TRUE(scripts1.addCustomScript(test1Id));
+        EXPECT_TRUE(scripts2.addCustomScript(test1Id));
+
+        std::string log;
+        scripts1.registerTimerCallback(test1Id, "A", sol::make_object(mLua.sol(), [&](int d) {
+            log += std::to_string(d);
+        }));
+        scripts2.registerTimerCallback(test1Id, "A", sol::make_object(mLua.sol(), [&](int d) {
+            log += std::to_string(d);
+        }));
+
+        scripts1.setupSerializableTimer(TimerType::SIMULATION_TIME, 3, test1Id, "A", sol::make_object(mLua.sol(), 3));
+        scripts1.setTimers(&timers); // existing timers are moved
+        scripts2.setTimers(&timers);
+        scripts2.setupSerializableTimer(TimerType::SIMULATION_TIME, 2, test1Id, "A", sol::make_object(mLua.sol(), 2));
+        scripts1.setupSerializableTimer(TimerType::GAME_TIME, 1, test1Id, "A", sol::make_object(mLua.sol(), 1));
+        scripts2.setupSerializableTimer(TimerType::SIMULATION_TIME, 4, test1Id, "A", sol::make_object(mLua.sol(), 4));
+        EXPECT_EQ(timers.size(), 4);
+
+        scripts1.processTimers(10, 10); // does nothing because the timers are shared
+        EXPECT_EQ(log, "");
+
+        scripts2.setTimersActive(false);
+        timers.processTimers(3, 1);
+        EXPECT_EQ(log, "31");
+        EXPECT_EQ(timers.size(), 1);
+
+        ESM::LuaScripts data;
+        scripts2.save(data);
+        ASSERT_EQ(data.mScripts.size(), 1);
+        EXPECT_EQ(data.mScripts[0].mTimers.size(), 2); // includes the postponed timer
+
+        scripts2.setTimersActive(true);
+        timers.processTimers(4, 1);
+        EXPECT_EQ(log, "3124");
+        EXPECT_EQ(timers.size(), 0);
+    }
+
     TEST_F(LuaScriptsContainerTest, CallbackWrapper)
     {
         LuaUtil::Callback callback{ mLua.sol()["print"], mLua.newTable() };
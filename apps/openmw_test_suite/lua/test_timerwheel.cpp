@@ -0,0 +1,129 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include <components/lua/timerwheel.hpp>
+
+namespace
+{
+    using namespace testing;
+    using LuaUtil::TimerHandle;
+    using LuaUtil::TimerWheel;
+
+    std::vector<int> advance(TimerWheel<int>& wheel, double time)
+    {
+        std::vector<TimerHandle> expired;
+        wheel.advance(time, expired);
+        std::vector<int> result;
+        for (TimerHandle handle : expired)
+        {
+            result.push_back(wheel.get(handle));
+            wheel.erase(handle);
+        }
+        return result;
+    }
+
+    TEST(LuaTimerWheelTest, advanceShouldReturnExpiredValuesOrderedByTime)
+    {
+        TimerWheel<int> wheel(0.25);
+        wheel.insert(3, 3);
+        wheel.insert(1, 1);
+        wheel.insert(2.1, 21);
+        wheel.insert(2, 2);
+        wheel.insert(1000, 1000);
+        EXPECT_THAT(advance(wheel, 0.5), ElementsAre());
+        EXPECT_THAT(advance(wheel, 2.1), ElementsAre(1, 2, 21));
+        EXPECT_THAT(advance(wheel, 999), ElementsAre(3));
+        EXPECT_EQ(wheel.size(), 1);
+        EXPECT_THAT(advance(wheel, 1e6), ElementsAre(1000));
+        EXPECT_EQ(wheel.size(), 0);
+    }
+
+    TEST(LuaTimerWheelTest, valuesWithEqualTimeShouldBeOrderedByInsertion)
+    {
+        TimerWheel<int> wheel(1);
+        for (int i = 0; i < 5; ++i)
+            wheel.insert(10, i);
+        EXPECT_THAT(advance(wheel, 10), ElementsAre(0, 1, 2, 3, 4));
+    }
+
+    TEST(LuaTimerWheelTest, valueShouldNotExpireBeforeItsTimeWithinTheSameTick)
+    {
+        TimerWheel<int> wheel(1);
+        wheel.insert(5.75, 1);
+        EXPECT_THAT(advance(wheel, 5.5), ElementsAre());
+        EXPECT_THAT(advance(wheel, 5.75), ElementsAre(1));
+    }
+
+    TEST(LuaTimerWheelTest, valueInThePastShouldExpireOnNextAdvance)
+    {
+        TimerWheel<int> wheel(1);
+        EXPECT_THAT(advance(wheel, 100), ElementsAre());
+        wheel.insert(50, 1);
+        EXPECT_THAT(advance(wheel, 100), ElementsAre(1));
+    }
+
+    TEST(LuaTimerWheelTest, erasedValueShouldNotExpire)
+    {
+        TimerWheel<int> wheel(1);
+        wheel.insert(1, 1);
+        const TimerHandle handle = wheel.insert(2, 2);
+        wheel.insert(3, 3);
+        wheel.erase(handle);
+        EXPECT_THAT(advance(wheel, 3), ElementsAre(1, 3));
+    }
+
+    TEST(LuaTimerWheelTest, shouldSupportTimeGoingBackwards)
+    {
+        TimerWheel<int> wheel(1);
+        wheel.insert(1e5, 1);
+        EXPECT_THAT(advance(wheel, 5e4), ElementsAre());
+        wheel.insert(20, 2);
+        EXPECT_THAT(advance(wheel, 10), ElementsAre());
+        EXPECT_THAT(advance(wheel, 20), ElementsAre(2));
+        EXPECT_THAT(advance(wheel, 1e5), ElementsAre(1));
+    }
+
+    TEST(LuaTimerWheelTest, shouldSupportValuesBeyondTheRangeOfLevels)
+    {
+        TimerWheel<int> wheel(1);
+        wheel.insert(1e15, 2);
+        wheel.insert(-1e15, 0);
+        wheel.insert(1e12, 1);
+        EXPECT_THAT(advance(wheel, 1e13), ElementsAre(0, 1));
+        EXPECT_THAT(advance(wheel, 1e15), ElementsAre(2));
+    }
+
+    TEST(LuaTimerWheelTest, shouldExpireRandomValuesInTheSameOrderAsSorting)
+    {
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<double> timeDistribution(0, 5000);
+        std::uniform_real_distribution<double> stepDistribution(0, 100);
+        TimerWheel<int> wheel(1.0 / 16);
+        std::vector<double> times;
+        std::vector<std::pair<double, int>> values;
+        for (int i = 0; i < 10000; ++i)
+        {
+            times.push_back(timeDistribution(generator));
+            values.emplace_back(times.back(), i);
+            wheel.insert(times.back(), i);
+        }
+        std::stable_sort(values.begin(), values.end(),
+            [](const auto& l, const auto& r) { return l.first < r.first; });
+
+        std::vector<int> result;
+        for (double time = 0; time < 5100; time += stepDistribution(generator))
+        {
+            const std::vector<int> expired = advance(wheel, time);
+            for (int v : expired)
+                EXPECT_LE(times[v], time);
+            result.insert(result.end(), expired.begin(), expired.end());
+        }
+        std::vector<int> expected;
+        for (const auto& [_, v] : values)
+            expected.push_back(v);
+        EXPECT_EQ(result, expected);
+        EXPECT_EQ(wheel.size(), 0);
+    }
+}
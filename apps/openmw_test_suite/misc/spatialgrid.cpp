@@ -0,0 +1,80 @@
+#include <components/misc/spatialgrid.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace Misc;
+
+    std::vector<int> findInRange(const SpatialGrid<int>& grid, const osg::Vec3f& position, float radius)
+    {
+        std::vector<int> result;
+        grid.forEachInRange(position, radius, [&](int value, const osg::Vec3f&) { result.push_back(value); });
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    TEST(MiscSpatialGridTest, forEachInRangeShouldFindNothingInEmptyGrid)
+    {
+        SpatialGrid<int> grid(100);
+        grid.build();
+        EXPECT_THAT(findInRange(grid, osg::Vec3f(0, 0, 0), 1000), IsEmpty());
+    }
+
+    TEST(MiscSpatialGridTest, forEachInRangeShouldFindValuesWithinRadius)
+    {
+        SpatialGrid<int> grid(100);
+        grid.add(osg::Vec3f(0, 0, 0), 1);
+        grid.add(osg::Vec3f(150, 0, 0), 2);
+        grid.add(osg::Vec3f(-90, -10, 0), 3);
+        grid.add(osg::Vec3f(0, 0, 300), 4);
+        grid.add(osg::Vec3f(1000, 1000, 0), 5);
+        grid.build();
+        EXPECT_THAT(findInRange(grid, osg::Vec3f(0, 0, 0), 200), ElementsAre(1, 2, 3));
+    }
+
+    TEST(MiscSpatialGridTest, forEachInSquareShouldPreserveAddingOrderForSameCell)
+    {
+        SpatialGrid<int> grid(100);
+        grid.add(osg::Vec3f(10, 10, 0), 3);
+        grid.add(osg::Vec3f(20, 20, 0), 1);
+        grid.add(osg::Vec3f(30, 30, 0), 2);
+        grid.build();
+        std::vector<int> result;
+        grid.forEachInSquare(osg::Vec3f(50, 50, 0), 10, [&](int value, const osg::Vec3f&) { result.push_back(value); });
+        EXPECT_THAT(result, ElementsAre(3, 1, 2));
+    }
+
+    TEST(MiscSpatialGridTest, forEachInRangeShouldFindSameValuesAsLinearSearch)
+    {
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> distribution(-10000, 10000);
+        std::vector<osg::Vec3f> positions;
+        SpatialGrid<int> grid(1024);
+        for (int i = 0; i < 1000; ++i)
+        {
+            const osg::Vec3f position(distribution(random), distribution(random), distribution(random) / 10);
+            grid.add(position, i);
+            positions.push_back(position);
+        }
+        grid.build();
+        for (float radius : { 0.f, 100.f, 2000.f, 7168.f, 30000.f })
+        {
+            for (std::size_t i = 0; i < positions.size(); i += 10)
+            {
+                std::vector<int> expected;
+                for (std::size_t j = 0; j < positions.size(); ++j)
+                    if ((positions[j] - positions[i]).length2() <= radius * radius)
+                        expected.push_back(static_cast<int>(j));
+                EXPECT_THAT(findInRange(grid, positions[i], radius), ElementsAreArray(expected))
+                    << "radius=" << radius << " i=" << i;
+            }
+        }
+    }
+}
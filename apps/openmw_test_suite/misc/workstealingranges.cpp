@@ -0,0 +1,95 @@
+#include <components/misc/workstealingranges.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace Misc;
+
+    using Range = std::pair<std::size_t, std::size_t>;
+
+    TEST(MiscWorkStealingRangesTest, takeShouldReturnEmptyRangeWhenThereIsNoJobs)
+    {
+        WorkStealingRanges ranges(2);
+        ranges.reset(0);
+        EXPECT_EQ(ranges.take(0), Range(0, 0));
+        EXPECT_EQ(ranges.take(1), Range(0, 0));
+    }
+
+    TEST(MiscWorkStealingRangesTest, takeShouldReturnChunksOfOwnRange)
+    {
+        WorkStealingRanges ranges(2);
+        ranges.reset(10, 3);
+        EXPECT_EQ(ranges.take(0), Range(0, 3));
+        EXPECT_EQ(ranges.take(1), Range(5, 8));
+        EXPECT_EQ(ranges.take(0), Range(3, 5));
+    }
+
+    TEST(MiscWorkStealingRangesTest, takeShouldStealSecondHalfOfOtherWorkerRangeWhenOwnIsEmpty)
+    {
+        WorkStealingRanges ranges(2);
+        ranges.reset(10);
+        for (std::size_t i = 0; i < 5; ++i)
+            EXPECT_EQ(ranges.take(0), Range(i, i + 1));
+        EXPECT_EQ(ranges.take(0), Range(8, 9));
+        EXPECT_EQ(ranges.take(0), Range(9, 10));
+        EXPECT_EQ(ranges.take(1), Range(5, 6));
+        EXPECT_EQ(ranges.take(1), Range(6, 7));
+        EXPECT_EQ(ranges.take(0), Range(7, 8));
+        EXPECT_EQ(ranges.take(0), Range(0, 0));
+        EXPECT_EQ(ranges.take(1), Range(0, 0));
+    }
+
+    TEST(MiscWorkStealingRangesTest, resetShouldHandleLessJobsThanWorkers)
+    {
+        WorkStealingRanges ranges(4);
+        ranges.reset(1);
+        std::size_t taken = 0;
+        for (std::size_t i = 0; i < ranges.getWorkersCount(); ++i)
+        {
+            const auto [begin, end] = ranges.take(i);
+            taken += end - begin;
+        }
+        EXPECT_EQ(taken, 1);
+    }
+
+    TEST(MiscWorkStealingRangesTest, concurrentTakeShouldReturnEachJobExactlyOnce)
+    {
+        constexpr std::size_t workers = 4;
+        constexpr std::size_t count = 10000;
+        WorkStealingRanges ranges(workers);
+        std::vector<std::atomic<int>> counters(count);
+        for (std::size_t chunkSize : { 1, 7 })
+        {
+            for (auto& v : counters)
+                v = 0;
+            ranges.reset(count, chunkSize);
+            std::vector<std::thread> threads;
+            for (std::size_t i = 0; i < workers; ++i)
+                threads.emplace_back([&, i] {
+                    while (true)
+                    {
+                        const auto [begin, end] = ranges.take(i);
+                        if (begin == end)
+                            break;
+                        for (std::size_t j = begin; j < end; ++j)
+                            counters[j].fetch_add(1, std::memory_order_relaxed);
+                        // Make some workers slower to let others steal
+                        if (i == 0)
+                            std::this_thread::yield();
+                    }
+                });
+            for (std::thread& thread : threads)
+                thread.join();
+            for (std::size_t i = 0; i < count; ++i)
+                ASSERT_EQ(counters[i].load(), 1) << i;
+        }
+    }
+}
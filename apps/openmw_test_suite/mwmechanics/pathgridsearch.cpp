@@ -0,0 +1,186 @@
+#include "apps/openmw/mwmechanics/pathgridsearch.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWMechanics;
+
+    struct Graph
+    {
+        ESM::Pathgrid::PointList mPoints;
+        std::vector<std::vector<PathgridEdge>> mEdges;
+
+        void addEdge(int a, int b)
+        {
+            const float cost = getPathgridCost(mPoints[a], mPoints[b]);
+            mEdges[a].push_back(PathgridEdge{ b, cost });
+            mEdges[b].push_back(PathgridEdge{ a, cost });
+        }
+    };
+
+    // 0 - 1 - 2 - 3 - 4 along X axis and a detour 0 - 5 - 4 far away from it
+    Graph makeGraph()
+    {
+        Graph result;
+        for (int i = 0; i < 5; ++i)
+            result.mPoints.emplace_back(i * 100, 0, 0);
+        result.mPoints.emplace_back(200, 1000, 0);
+        result.mEdges.resize(result.mPoints.size());
+        for (int i = 0; i < 4; ++i)
+            result.addEdge(i, i + 1);
+        result.addEdge(0, 5);
+        result.addEdge(5, 4);
+        return result;
+    }
+
+    std::vector<int> findPath(PathgridSearch& search, const Graph& graph, int start, int goal)
+    {
+        search.start(graph.mPoints, graph.mEdges, start, goal);
+        EXPECT_EQ(search.advance(std::numeric_limits<std::size_t>::max()), PathgridSearchStatus::Found);
+        std::vector<int> path;
+        search.getPath(path);
+        return path;
+    }
+
+    TEST(MWMechanicsPathgridSearchTest, shouldFindShortestPath)
+    {
+        const Graph graph = makeGraph();
+        PathgridSearch search;
+        EXPECT_THAT(findPath(search, graph, 0, 4), ElementsAre(0, 1, 2, 3, 4));
+        EXPECT_THAT(findPath(search, graph, 3, 5), ElementsAre(3, 4, 5));
+    }
+
+    TEST(MWMechanicsPathgridSearchTest, shouldReturnOnlyStartWhenGoalIsTheSame)
+    {
+        const Graph graph = makeGraph();
+        PathgridSearch search;
+        EXPECT_THAT(findPath(search, graph, 2, 2), ElementsAre(2));
+    }
+
+    TEST(MWMechanicsPathgridSearchTest, shouldNotFindPathToNotConnectedPoint)
+    {
+        Graph graph = makeGraph();
+        graph.mPoints.emplace_back(0, 0, 1000);
+        graph.mEdges.emplace_back();
+        PathgridSearch search;
+        search.start(graph.mPoints, graph.mEdges, 0, 6);
+        EXPECT_EQ(search.advance(std::numeric_limits<std::size_t>::max()), PathgridSearchStatus::NotFound);
+        std::vector<int> path{ 42 };
+        search.getPath(path);
+        EXPECT_THAT(path, IsEmpty());
+    }
+
+    TEST(MWMechanicsPathgridSearchTest, shouldNotFindPathForInvalidPoints)
+    {
+        const Graph graph = makeGraph();
+        PathgridSearch search;
+        search.start(graph.mPoints, graph.mEdges, 0, 42);
+        EXPECT_EQ(search.getStatus(), PathgridSearchStatus::NotFound);
+        search.start(graph.mPoints, graph.mEdges, -1, 0);
+        EXPECT_EQ(search.getStatus(), PathgridSearchStatus::NotFound);
+    }
+
+    TEST(MWMechanicsPathgridSearchTest, advanceShouldExpandNotMoreThanGivenNumberOfPoints)
+    {
+        const Graph graph = makeGraph();
+        PathgridSearch search;
+        search.start(graph.mPoints, graph.mEdges, 0, 4);
+        std::size_t steps = 0;
+        while (search.advance(1) == PathgridSearchStatus::InProgress)
+        {
+            ++steps;
+            EXPECT_EQ(search.getExpansions(), steps);
+        }
+        EXPECT_EQ(search.getStatus(), PathgridSearchStatus::Found);
+        EXPECT_EQ(search.getExpansions(), 4);
+        std::vector<int> path;
+        search.getPath(path);
+        EXPECT_THAT(path, ElementsAre(0, 1, 2, 3, 4));
+    }
+
+    TEST(MWMechanicsPathgridSearchTest, shouldReuseBuffersForDifferentGraphs)
+    {
+        const Graph graph = makeGraph();
+        Graph small;
+        small.mPoints = { ESM::Pathgrid::Point(0, 0, 0), ESM::Pathgrid::Point(100, 0, 0) };
+        small.mEdges.resize(2);
+        small.addEdge(0, 1);
+        PathgridSearch search;
+        EXPECT_THAT(findPath(search, graph, 4, 0), ElementsAre(4, 3, 2, 1, 0));
+        EXPECT_THAT(findPath(search, small, 1, 0), ElementsAre(1, 0));
+        EXPECT_THAT(findPath(search, graph, 0, 4), ElementsAre(0, 1, 2, 3, 4));
+    }
+
+    TEST(MWMechanicsPathgridPathCacheTest, getShouldReturnPutPath)
+    {
+        PathgridPathCache cache(2);
+        std::vector<int> path;
+        EXPECT_FALSE(cache.get(0, 2, path));
+        cache.put(0, 2, { 0, 1, 2 });
+        EXPECT_TRUE(cache.get(0, 2, path));
+        EXPECT_THAT(path, ElementsAre(0, 1, 2));
+        EXPECT_FALSE(cache.get(2, 0, path));
+    }
+
+    TEST(MWMechanicsPathgridPathCacheTest, putShouldReplaceLeastRecentlyUsedPath)
+    {
+        PathgridPathCache cache(2);
+        std::vector<int> path;
+        cache.put(0, 1, { 0, 1 });
+        cache.put(1, 2, { 1, 2 });
+        EXPECT_TRUE(cache.get(0, 1, path));
+        cache.put(2, 3, { 2, 3 });
+        EXPECT_TRUE(cache.get(0, 1, path));
+        EXPECT_FALSE(cache.get(1, 2, path));
+        EXPECT_TRUE(cache.get(2, 3, path));
+        EXPECT_THAT(path, ElementsAre(2, 3));
+    }
+
+    TEST(MWMechanicsPathgridSearchQueueTest, updateShouldContinueSearchesWithinGivenBudget)
+    {
+        const Graph graph = makeGraph();
+        PathgridSearchQueue queue;
+        const auto first = queue.push(graph.mPoints, graph.mEdges, nullptr, 0, 4);
+        const auto second = queue.push(graph.mPoints, graph.mEdges, nullptr, 0, 1);
+        EXPECT_EQ(queue.update(3), 3);
+        EXPECT_EQ(first->mStatus, PathgridSearchStatus::InProgress);
+        EXPECT_EQ(second->mStatus, PathgridSearchStatus::InProgress);
+        EXPECT_EQ(queue.update(3), 2);
+        EXPECT_EQ(first->mStatus, PathgridSearchStatus::Found);
+        EXPECT_THAT(first->mPath, ElementsAre(0, 1, 2, 3, 4));
+        EXPECT_EQ(second->mStatus, PathgridSearchStatus::Found);
+        EXPECT_THAT(second->mPath, ElementsAre(0, 1));
+        EXPECT_EQ(queue.size(), 0);
+    }
+
+    TEST(MWMechanicsPathgridSearchQueueTest, updateShouldDropSearchesWithoutResultOwner)
+    {
+        const Graph graph = makeGraph();
+        PathgridSearchQueue queue;
+        queue.push(graph.mPoints, graph.mEdges, nullptr, 0, 4);
+        const auto result = queue.push(graph.mPoints, graph.mEdges, nullptr, 0, 1);
+        EXPECT_EQ(queue.update(2), 1);
+        EXPECT_EQ(result->mStatus, PathgridSearchStatus::Found);
+        EXPECT_EQ(queue.size(), 0);
+    }
+
+    TEST(MWMechanicsPathgridSearchQueueTest, updateShouldPutFoundPathIntoCache)
+    {
+        const Graph graph = makeGraph();
+        PathgridPathCache cache(1);
+        PathgridSearchQueue queue;
+        const auto result = queue.push(graph.mPoints, graph.mEdges, &cache, 3, 5);
+        queue.update(std::numeric_limits<std::size_t>::max());
+        std::vector<int> path;
+        EXPECT_TRUE(cache.get(3, 5, path));
+        EXPECT_THAT(path, ElementsAre(3, 4, 5));
+    }
+}
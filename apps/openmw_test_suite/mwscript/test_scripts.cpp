@@ -49,6 +49,17 @@ namespace
             mInterpreter.run(script.mProgram, context);
         }
 
+        Interpreter::DecodedProgram decode(const Interpreter::Program& program) const
+        {
+            return mInterpreter.decode(program);
+        }
+
+        void run(const Interpreter::Program& program, const Interpreter::DecodedProgram& decoded,
+            TestInterpreterContext& context)
+        {
+            mInterpreter.run(program, decoded, context);
+        }
+
         template <typename T, typename... TArgs>
         void installOpcode(int code, TArgs&&... args)
         {
@@ -508,6 +519,39 @@ End)mwscript";
         }
     }
 
+    TEST_F(MWScriptTest, mwscript_test_decoded_program_can_be_run_multiple_times)
+    {
+        if (const auto script = compile(sScript1))
+        {
+            const Interpreter::DecodedProgram decoded = decode(script->mProgram);
+            ASSERT_EQ(decoded.mInstructions.size(), script->mProgram.mInstructions.size());
+            for (int two : { 1, 5, 10 })
+            {
+                TestInterpreterContext context;
+                context.setLocalShort(0, 0);
+                context.setLocalShort(1, two);
+                run(script->mProgram, decoded, context);
+                EXPECT_EQ(context.getLocalShort(0), two);
+                EXPECT_EQ(context.getLocalShort(1), two);
+            }
+        }
+        else
+        {
+            FAIL();
+        }
+    }
+
+    TEST_F(MWScriptTest, mwscript_test_unknown_opcode_is_reported_when_executed)
+    {
+        Interpreter::Program program;
+        program.mInstructions.push_back(0xc8000000 | 0x3ffffff);
+        const Interpreter::DecodedProgram decoded = decode(program);
+        ASSERT_EQ(decoded.mInstructions.size(), 1);
+        EXPECT_EQ(decoded.mInstructions[0].mType, Interpreter::DecodedInstruction::Type::Invalid);
+        TestInterpreterContext context;
+        EXPECT_THROW(run(program, decoded, context), std::runtime_error);
+    }
+
     TEST_F(MWScriptTest, mwscript_test_math)
     {
         if (const auto script = compile(sScript3))
@@ -1,6 +1,7 @@
 #ifndef MWSCRIPT_TESTING_UTIL_H
 #define MWSCRIPT_TESTING_UTIL_H
 
+#include <map>
 #include <optional>
 #include <string>
 #include <utility>
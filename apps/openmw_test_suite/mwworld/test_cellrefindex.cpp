@@ -0,0 +1,80 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <components/esm3/loadcell.hpp>
+#include <components/esm3/readerscache.hpp>
+
+#include "apps/openmw/mwworld/cellrefindex.hpp"
+
+namespace
+{
+    using namespace testing;
+    using namespace MWWorld;
+
+    ESM::CellRef makeCellRef(unsigned index, std::string_view id)
+    {
+        ESM::CellRef ref;
+        ref.blank();
+        ref.mRefNum.mIndex = index;
+        ref.mRefID = ESM::RefId::stringRefId(id);
+        ref.mScale = 2;
+        return ref;
+    }
+
+    TEST(MWWorldCellRefIndexTest, makeRefShouldCopyPlacementAndResolveType)
+    {
+        const CellRefIndex index([](const ESM::RefId& id) { return id == ESM::RefId::stringRefId("rock") ? 42 : 0; });
+        const IndexedCellRef ref = index.makeRef(makeCellRef(1, "rock"), true);
+        EXPECT_EQ(ref.mRefNum.mIndex, 1);
+        EXPECT_EQ(ref.mRefId, ESM::RefId::stringRefId("rock"));
+        EXPECT_EQ(ref.mScale, 2);
+        EXPECT_EQ(ref.mType, 42);
+        EXPECT_TRUE(ref.mDeleted);
+        EXPECT_EQ(CellRefIndex().makeRef(makeCellRef(1, "rock"), false).mType, 0);
+    }
+
+    TEST(MWWorldCellRefIndexTest, getShouldReturnInsertedRefsWithoutReading)
+    {
+        CellRefIndex index;
+        index.insert(1, 2, { index.makeRef(makeCellRef(1, "a"), false), index.makeRef(makeCellRef(2, "b"), true) });
+        ESM::Cell cell;
+        cell.blank();
+        ESM::ReadersCache readers;
+        const std::shared_ptr<const IndexedCellRefs> refs = index.get(1, 2, cell, readers);
+        ASSERT_NE(refs, nullptr);
+        ASSERT_EQ(refs->size(), 2);
+        EXPECT_EQ((*refs)[0].mRefId, ESM::RefId::stringRefId("a"));
+        EXPECT_TRUE((*refs)[1].mDeleted);
+        EXPECT_EQ(index.get(1, 2, cell, readers), refs);
+    }
+
+    TEST(MWWorldCellRefIndexTest, getShouldIndexCellWithoutContentFiles)
+    {
+        CellRefIndex index;
+        ESM::Cell cell;
+        cell.blank();
+        ESM::ReadersCache readers;
+        const std::shared_ptr<const IndexedCellRefs> refs = index.get(0, 0, cell, readers);
+        ASSERT_NE(refs, nullptr);
+        EXPECT_THAT(*refs, IsEmpty());
+        EXPECT_EQ(index.getCellCount(), 1);
+        EXPECT_EQ(index.get(0, 0, cell, readers), refs);
+    }
+
+    TEST(MWWorldCellRefIndexTest, shouldDropFirstIndexedCellsWhenLimitIsExceeded)
+    {
+        CellRefIndex index(CellRefIndex::GetType(), 2);
+        index.insert(0, 0, { index.makeRef(makeCellRef(1, "a"), false) });
+        index.insert(0, 1, {});
+        index.insert(0, 0, { index.makeRef(makeCellRef(2, "b"), false) });
+        EXPECT_EQ(index.getCellCount(), 2);
+        index.insert(0, 2, {});
+        EXPECT_EQ(index.getCellCount(), 2);
+
+        ESM::Cell cell;
+        cell.blank();
+        ESM::ReadersCache readers;
+        EXPECT_THAT(*index.get(0, 0, cell, readers), IsEmpty());
+        EXPECT_EQ(index.getCellCount(), 2);
+    }
+}
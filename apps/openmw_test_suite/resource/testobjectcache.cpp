@@ -0,0 +1,82 @@
+#include <components/resource/objectcache.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace Resource
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        struct ResourceObjectCacheTest : Test
+        {
+            osg::ref_ptr<GenericObjectCache<std::string>> mCache = new GenericObjectCache<std::string>;
+        };
+
+        TEST_F(ResourceObjectCacheTest, getRefFromObjectCacheShouldReturnAddedObject)
+        {
+            osg::ref_ptr<osg::Object> object = new osg::Node;
+            mCache->addEntryToObjectCache("key", object.get());
+            EXPECT_EQ(mCache->getRefFromObjectCache("key").get(), object.get());
+            EXPECT_EQ(mCache->getRefFromObjectCache("other").get(), nullptr);
+            EXPECT_EQ(mCache->getCacheSize(), 1);
+        }
+
+        TEST_F(ResourceObjectCacheTest, takeStatsShouldReturnHitsAndMissesSincePreviousCall)
+        {
+            mCache->addEntryToObjectCache("key", new osg::Node);
+            mCache->getRefFromObjectCache("key");
+            mCache->checkInObjectCache("key", 1);
+            mCache->getRefFromObjectCache("other");
+            const CacheStats stats = mCache->takeStats();
+            EXPECT_EQ(stats.mHit, 2);
+            EXPECT_EQ(stats.mMiss, 1);
+            EXPECT_EQ(stats.mContention, 0);
+            const CacheStats next = mCache->takeStats();
+            EXPECT_EQ(next.mHit, 0);
+            EXPECT_EQ(next.mMiss, 0);
+        }
+
+        TEST_F(ResourceObjectCacheTest, updateCacheShouldRemoveOnlyExpiredObjectsWithoutExternalReferences)
+        {
+            osg::ref_ptr<osg::Object> referenced = new osg::Node;
+            for (int i = 0; i < 100; ++i)
+                mCache->addEntryToObjectCache("unreferenced" + std::to_string(i), new osg::Node, 1);
+            mCache->addEntryToObjectCache("referenced", referenced.get(), 1);
+            mCache->addEntryToObjectCache("recent", new osg::Node, 5);
+            mCache->addEntryToObjectCache("new", new osg::Node);
+            mCache->updateCache(10, 2, std::chrono::hours(1));
+            EXPECT_EQ(mCache->getCacheSize(), 3);
+            EXPECT_EQ(mCache->getRefFromObjectCache("referenced").get(), referenced.get());
+            EXPECT_NE(mCache->getRefFromObjectCache("recent").get(), nullptr);
+            EXPECT_NE(mCache->getRefFromObjectCache("new").get(), nullptr);
+        }
+
+        TEST_F(ResourceObjectCacheTest, updateCacheShouldProcessAllShardsWithinSeveralCallsWhenOutOfBudget)
+        {
+            for (int i = 0; i < 100; ++i)
+                mCache->addEntryToObjectCache(std::to_string(i), new osg::Node, 1);
+            mCache->updateCache(10, 2, std::chrono::nanoseconds(0));
+            EXPECT_GT(mCache->getCacheSize(), 0);
+            for (int i = 0; i < 100; ++i)
+                mCache->updateCache(10, 2, std::chrono::nanoseconds(0));
+            EXPECT_EQ(mCache->getCacheSize(), 0);
+        }
+
+        TEST_F(ResourceObjectCacheTest, shouldSupportTupleKeys)
+        {
+            using Key = std::tuple<osg::Vec2f, float, bool, unsigned char>;
+            osg::ref_ptr<GenericObjectCache<Key>> cache = new GenericObjectCache<Key>;
+            osg::ref_ptr<osg::Object> object = new osg::Node;
+            const Key key(osg::Vec2f(1, 2), 3.0f, true, 4);
+            cache->addEntryToObjectCache(key, object.get());
+            EXPECT_EQ(cache->getRefFromObjectCache(key).get(), object.get());
+            EXPECT_EQ(cache->getRefFromObjectCache(Key(osg::Vec2f(1, 2), 3.0f, false, 4)).get(), nullptr);
+        }
+    }
+}
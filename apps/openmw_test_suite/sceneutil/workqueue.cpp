@@ -0,0 +1,67 @@
+#include <components/sceneutil/workqueue.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    TEST(SceneUtilParallelForTest, shouldCallFunctionForEachIndexWithoutWorkQueue)
+    {
+        std::vector<int> calls(10, 0);
+        parallelFor(nullptr, calls.size(), [&](std::size_t index) { ++calls[index]; });
+        EXPECT_THAT(calls, Each(1));
+    }
+
+    TEST(SceneUtilParallelForTest, shouldCallFunctionForEachIndexUsingWorkQueue)
+    {
+        osg::ref_ptr<WorkQueue> workQueue = new WorkQueue(3);
+        std::vector<std::atomic_int> calls(1000);
+        parallelFor(workQueue.get(), calls.size(), [&](std::size_t index) { ++calls[index]; });
+        for (const std::atomic_int& v : calls)
+            EXPECT_EQ(v.load(), 1);
+    }
+
+    TEST(SceneUtilParallelForTest, shouldNotWaitForWorkQueueItemsWhenThreadsAreBusy)
+    {
+        osg::ref_ptr<WorkQueue> workQueue = new WorkQueue(1);
+        std::atomic_bool release{ false };
+        struct Blocking : WorkItem
+        {
+            std::atomic_bool& mRelease;
+            explicit Blocking(std::atomic_bool& release)
+                : mRelease(release)
+            {
+            }
+            void doWork() override
+            {
+                while (!mRelease)
+                    std::this_thread::yield();
+            }
+        };
+        osg::ref_ptr<WorkItem> blocking = new Blocking(release);
+        workQueue->addWorkItem(blocking);
+        std::size_t calls = 0;
+        parallelFor(workQueue.get(), 10, [&](std::size_t) { ++calls; });
+        EXPECT_EQ(calls, 10);
+        release = true;
+        blocking->waitTillDone();
+    }
+
+    TEST(SceneUtilParallelForTest, shouldRethrowException)
+    {
+        osg::ref_ptr<WorkQueue> workQueue = new WorkQueue(2);
+        EXPECT_THROW(parallelFor(workQueue.get(), 100,
+                         [&](std::size_t index) {
+                             if (index == 42)
+                                 throw std::runtime_error("error");
+                         }),
+            std::runtime_error);
+    }
+}
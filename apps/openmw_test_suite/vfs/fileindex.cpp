@@ -0,0 +1,101 @@
+#include <components/vfs/fileindex.hpp>
+
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace VFS;
+
+    File* const a = reinterpret_cast<File*>(1);
+    File* const b = reinterpret_cast<File*>(2);
+    File* const c = reinterpret_cast<File*>(3);
+    File* const d = reinterpret_cast<File*>(4);
+
+    std::vector<std::string> getNames(std::pair<FileIndex::const_iterator, FileIndex::const_iterator> range)
+    {
+        std::vector<std::string> result;
+        for (auto it = range.first; it != range.second; ++it)
+            result.push_back(it->first);
+        return result;
+    }
+
+    struct VFSFileIndexTest : Test
+    {
+        FileIndex mIndex{ false };
+
+        VFSFileIndexTest()
+        {
+            mIndex.assign({
+                { "meshes/a.nif", a },
+                { "meshes/b/c.nif", b },
+                { "meshes0/d.nif", c },
+                { "textures/a.dds", d },
+            });
+        }
+    };
+
+    TEST_F(VFSFileIndexTest, find_should_return_nullptr_for_missing_file)
+    {
+        EXPECT_EQ(mIndex.find("meshes/x.nif"), nullptr);
+        EXPECT_EQ(mIndex.find("meshes"), nullptr);
+        EXPECT_EQ(mIndex.find(""), nullptr);
+    }
+
+    TEST_F(VFSFileIndexTest, find_should_return_file_for_normalized_name)
+    {
+        EXPECT_EQ(mIndex.find("meshes/a.nif"), a);
+        EXPECT_EQ(mIndex.find("meshes/b/c.nif"), b);
+    }
+
+    TEST_F(VFSFileIndexTest, find_should_normalize_name)
+    {
+        EXPECT_EQ(mIndex.find("Meshes\\B\\C.NIF"), b);
+        EXPECT_EQ(mIndex.find("TEXTURES/a.dds"), d);
+    }
+
+    TEST_F(VFSFileIndexTest, find_in_strict_mode_should_only_convert_slashes)
+    {
+        FileIndex index(true);
+        index.assign({ { "Meshes/A.nif", a } });
+        EXPECT_EQ(index.find("Meshes\\A.nif"), a);
+        EXPECT_EQ(index.find("meshes/a.nif"), nullptr);
+    }
+
+    TEST_F(VFSFileIndexTest, find_prefix_should_return_all_files_for_empty_prefix)
+    {
+        EXPECT_EQ(getNames(mIndex.findPrefix("")),
+            (std::vector<std::string>{ "meshes/a.nif", "meshes/b/c.nif", "meshes0/d.nif", "textures/a.dds" }));
+    }
+
+    TEST_F(VFSFileIndexTest, find_prefix_should_return_contiguous_range_of_matching_files)
+    {
+        EXPECT_EQ(
+            getNames(mIndex.findPrefix("meshes/")), (std::vector<std::string>{ "meshes/a.nif", "meshes/b/c.nif" }));
+        EXPECT_EQ(getNames(mIndex.findPrefix("meshes")),
+            (std::vector<std::string>{ "meshes/a.nif", "meshes/b/c.nif", "meshes0/d.nif" }));
+    }
+
+    TEST_F(VFSFileIndexTest, find_prefix_should_normalize_prefix)
+    {
+        EXPECT_EQ(getNames(mIndex.findPrefix("MESHES\\B")), (std::vector<std::string>{ "meshes/b/c.nif" }));
+    }
+
+    TEST_F(VFSFileIndexTest, find_prefix_should_return_empty_range_for_missing_prefix)
+    {
+        EXPECT_EQ(getNames(mIndex.findPrefix("sound/")), std::vector<std::string>());
+        EXPECT_EQ(getNames(mIndex.findPrefix("z")), std::vector<std::string>());
+    }
+
+    TEST_F(VFSFileIndexTest, clear_should_remove_all_files)
+    {
+        mIndex.clear();
+        EXPECT_TRUE(mIndex.empty());
+        EXPECT_EQ(mIndex.find("meshes/a.nif"), nullptr);
+    }
+}
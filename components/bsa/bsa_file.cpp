@@ -22,14 +22,21 @@
  */
 
 #include "bsa_file.hpp"
+#include "memorystream.hpp"
 
+#include <components/debug/debuglog.hpp>
 #include <components/files/constrainedfilestream.hpp>
+#include <components/platform/file.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstring>
+#include <exception>
 #include <filesystem>
 #include <fstream>
+#include <mutex>
+#include <thread>
 
 using namespace Bsa;
 
@@ -233,14 +240,28 @@ void Bsa::BSAFile::writeHeader()
 }
 
 /// Open an archive file.
-void BSAFile::open(const std::filesystem::path& file)
+void BSAFile::open(const std::filesystem::path& file, bool mapped)
 {
     if (mIsLoaded)
         close();
 
     mFilepath = file;
     if (std::filesystem::exists(file))
+    {
+        if (mapped)
+        {
+            try
+            {
+                mMappedFile = std::make_shared<Platform::File::MappedFile>(file);
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to map BSA archive " << file
+                                    << " into memory, falling back to file streams: " << e.what();
+            }
+        }
         readHeader();
+    }
     else
     {
         {
@@ -259,12 +280,60 @@ void Bsa::BSAFile::close()
 
     mFiles.clear();
     mStringBuf.clear();
+    mMappedFile = nullptr;
     mIsLoaded = false;
 }
 
+Files::IStreamPtr Bsa::BSAFile::openRegion(std::size_t offset, std::size_t size) const
+{
+    if (mMappedFile == nullptr)
+        return Files::openConstrainedFileStream(mFilepath, offset, size);
+    if (offset > mMappedFile->size() || size > mMappedFile->size() - offset)
+        fail("Archive contains offsets outside itself");
+    return std::make_unique<MappedInputStream>(mMappedFile, offset, size);
+}
+
 Files::IStreamPtr Bsa::BSAFile::getFile(const FileStruct* file)
 {
-    return Files::openConstrainedFileStream(mFilepath, file->offset, file->fileSize);
+    return openRegion(file->offset, file->fileSize);
+}
+
+std::vector<Files::IStreamPtr> Bsa::BSAFile::getFiles(const std::vector<const FileStruct*>& files, std::size_t threads)
+{
+    std::vector<Files::IStreamPtr> result(files.size());
+    std::atomic_size_t next{ 0 };
+    std::mutex errorMutex;
+    std::exception_ptr error;
+
+    const auto work = [&] {
+        try
+        {
+            for (std::size_t i = next++; i < files.size(); i = next++)
+                result[i] = getFile(files[i]);
+        }
+        catch (...)
+        {
+            next = files.size();
+            const std::lock_guard lock(errorMutex);
+            if (error == nullptr)
+                error = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    const std::size_t threadsCount = std::min(threads, files.size());
+    for (std::size_t i = 1; i < threadsCount; ++i)
+        workers.emplace_back(work);
+
+    work();
+
+    for (std::thread& worker : workers)
+        worker.join();
+
+    if (error != nullptr)
+        std::rethrow_exception(error);
+
+    return result;
 }
 
 void Bsa::BSAFile::addFile(const std::string& filename, std::istream& file)
@@ -272,6 +341,9 @@ void Bsa::BSAFile::addFile(const std::string& filename, std::istream& file)
     if (!mIsLoaded)
         fail("Unable to add file " + filename + " the archive is not opened");
 
+    if (mMappedFile != nullptr)
+        fail("Unable to add file " + filename + " the archive is opened in mapped mode");
+
     auto newStartOfDataBuffer = 12 + (12 + 8) * (mFiles.size() + 1) + mStringBuf.size() + filename.size() + 1;
     if (mFiles.empty())
         std::filesystem::resize_file(mFilepath, newStartOfDataBuffer);
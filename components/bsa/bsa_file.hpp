@@ -26,12 +26,18 @@
 
 #include <cstdint>
 #include <filesystem>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include <components/files/conversion.hpp>
 #include <components/files/istreamptr.hpp>
 
+namespace Platform::File
+{
+    class MappedFile;
+}
+
 namespace Bsa
 {
 
@@ -87,9 +93,15 @@ namespace Bsa
         /// Used for error messages
         std::filesystem::path mFilepath;
 
+        /// Whole archive content when opened in mapped mode
+        std::shared_ptr<const Platform::File::MappedFile> mMappedFile;
+
         /// Error handling
         [[noreturn]] void fail(const std::string& msg) const;
 
+        /// Open a stream over the given region of the archive. Doesn't copy the data when archive is mapped.
+        Files::IStreamPtr openRegion(std::size_t offset, std::size_t size) const;
+
         /// Read header information from the input source
         virtual void readHeader();
         virtual void writeHeader();
@@ -111,7 +123,9 @@ namespace Bsa
         }
 
         /// Open an archive file.
-        void open(const std::filesystem::path& file);
+        /// @param mapped Map the whole archive into memory to read files without copying. Falls back to file streams
+        /// if mapping fails. Archive can't be modified when opened in this mode.
+        void open(const std::filesystem::path& file, bool mapped = false);
 
         void close();
 
@@ -123,7 +137,13 @@ namespace Bsa
         /** Open a file contained in the archive.
          * @note Thread safe.
          */
-        Files::IStreamPtr getFile(const FileStruct* file);
+        virtual Files::IStreamPtr getFile(const FileStruct* file);
+
+        /** Open multiple files contained in the archive concurrently using up to the given number of threads
+         * including the calling one. Returned streams are in the same order as requested files.
+         * @note Thread safe.
+         */
+        std::vector<Files::IStreamPtr> getFiles(const std::vector<const FileStruct*>& files, std::size_t threads);
 
         void addFile(const std::string& filename, std::istream& file);
 
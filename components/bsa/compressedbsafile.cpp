@@ -27,6 +27,7 @@
 #include <cassert>
 #include <filesystem>
 #include <fstream>
+#include <stdexcept>
 
 #include <lz4frame.h>
 
@@ -47,9 +48,52 @@
 #include <components/files/constrainedfilestream.hpp>
 #include <components/files/conversion.hpp>
 #include <components/misc/strings/lower.hpp>
+#include <components/platform/file.hpp>
 
 namespace Bsa
 {
+    namespace
+    {
+        /// LZ4 frame decompression context shared by all archives on the same thread to avoid creating a new one for
+        /// each file.
+        class LZ4DecompressionContext
+        {
+        public:
+            LZ4DecompressionContext() { create(); }
+
+            LZ4DecompressionContext(const LZ4DecompressionContext&) = delete;
+
+            ~LZ4DecompressionContext() { LZ4F_freeDecompressionContext(mContext); }
+
+            LZ4F_decompressionContext_t get() const { return mContext; }
+
+            /// Context state is undefined after an error or incomplete frame so it has to be recreated
+            void reset()
+            {
+                LZ4F_freeDecompressionContext(mContext);
+                mContext = nullptr;
+                create();
+            }
+
+        private:
+            LZ4F_decompressionContext_t mContext = nullptr;
+
+            void create()
+            {
+                const LZ4F_errorCode_t errorCode = LZ4F_createDecompressionContext(&mContext, LZ4F_VERSION);
+                if (LZ4F_isError(errorCode))
+                    throw std::runtime_error(
+                        std::string("Failed to create LZ4 decompression context: ") + LZ4F_getErrorName(errorCode));
+            }
+        };
+
+        LZ4DecompressionContext& getLZ4DecompressionContext()
+        {
+            thread_local LZ4DecompressionContext context;
+            return context;
+        }
+    }
+
     // special marker for invalid records,
     // equal to max uint32_t value
     const uint32_t CompressedBSAFile::sInvalidOffset = std::numeric_limits<uint32_t>::max();
@@ -378,7 +422,7 @@ namespace Bsa
         size_t size = fileRecord.getSizeWithoutCompressionFlag();
         size_t uncompressedSize = size;
         bool compressed = fileRecord.isCompressed(mCompressedByDefault);
-        Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilepath, fileRecord.offset, size);
+        Files::IStreamPtr streamPtr = openRegion(fileRecord.offset, size);
         std::istream* fileStream = streamPtr.get();
         if (mEmbeddedFileNames)
         {
@@ -393,6 +437,16 @@ namespace Bsa
             fileStream->read(reinterpret_cast<char*>(&uncompressedSize), sizeof(uint32_t));
             size -= sizeof(uint32_t);
         }
+
+        // Uncompressed data is returned as a view over the mapped memory
+        std::size_t dataOffset = 0;
+        if (mMappedFile != nullptr)
+        {
+            dataOffset = fileRecord.offset + static_cast<std::size_t>(fileStream->tellg());
+            if (!compressed)
+                return std::make_unique<MappedInputStream>(mMappedFile, dataOffset, size);
+        }
+
         auto memoryStreamPtr = std::make_unique<MemoryInputStream>(uncompressedSize);
 
         if (compressed)
@@ -408,17 +462,24 @@ namespace Bsa
             }
             else // SSE: lz4
             {
-                auto buffer = std::vector<char>(size);
-                fileStream->read(buffer.data(), size);
-                LZ4F_decompressionContext_t context = nullptr;
-                LZ4F_createDecompressionContext(&context, LZ4F_VERSION);
+                // Decompress directly from the mapped memory when possible
+                std::vector<char> buffer;
+                const char* compressedData = nullptr;
+                if (mMappedFile != nullptr)
+                    compressedData = mMappedFile->data() + dataOffset;
+                else
+                {
+                    buffer.resize(size);
+                    fileStream->read(buffer.data(), size);
+                    compressedData = buffer.data();
+                }
+                LZ4DecompressionContext& context = getLZ4DecompressionContext();
                 LZ4F_decompressOptions_t options = {};
-                LZ4F_errorCode_t errorCode = LZ4F_decompress(
-                    context, memoryStreamPtr->getRawData(), &uncompressedSize, buffer.data(), &size, &options);
-                if (LZ4F_isError(errorCode))
-                    fail("LZ4 decompression error (file " + Files::pathToUnicodeString(mFilepath)
-                        + "): " + LZ4F_getErrorName(errorCode));
-                errorCode = LZ4F_freeDecompressionContext(context);
+                const LZ4F_errorCode_t errorCode = LZ4F_decompress(
+                    context.get(), memoryStreamPtr->getRawData(), &uncompressedSize, compressedData, &size, &options);
+                // Non zero result means the frame is not finished
+                if (errorCode != 0)
+                    context.reset();
                 if (LZ4F_isError(errorCode))
                     fail("LZ4 decompression error (file " + Files::pathToUnicodeString(mFilepath)
                         + "): " + LZ4F_getErrorName(errorCode));
@@ -486,8 +547,7 @@ namespace Bsa
                 continue;
             }
 
-            Files::IStreamPtr dataBegin = Files::openConstrainedFileStream(
-                mFilepath, fileRecord.offset, fileRecord.getSizeWithoutCompressionFlag());
+            Files::IStreamPtr dataBegin = openRegion(fileRecord.offset, fileRecord.getSizeWithoutCompressionFlag());
 
             if (mEmbeddedFileNames)
             {
@@ -82,13 +82,11 @@ namespace Bsa
         void getBZString(std::string& str, std::istream& filestream);
         // mFiles used by OpenMW will contain uncompressed file sizes
         void convertCompressedSizesToUncompressed();
-        /// \brief Normalizes given filename or folder and generates format-compatible hash. See
-        /// https://en.uesp.net/wiki/Tes4Mod:Hash_Calculation.
-        static std::uint64_t generateHash(const std::filesystem::path& stem, std::string extension);
         Files::IStreamPtr getFile(const FileRecord& fileRecord);
 
     public:
         using BSAFile::getFilename;
+        using BSAFile::getFiles;
         using BSAFile::getList;
         using BSAFile::open;
 
@@ -102,8 +100,12 @@ namespace Bsa
         void readHeader() override;
 
         Files::IStreamPtr getFile(const char* filePath);
-        Files::IStreamPtr getFile(const FileStruct* fileStruct);
+        Files::IStreamPtr getFile(const FileStruct* fileStruct) override;
         void addFile(const std::string& filename, std::istream& file);
+
+        /// \brief Normalizes given filename or folder and generates format-compatible hash. See
+        /// https://en.uesp.net/wiki/Tes4Mod:Hash_Calculation.
+        static std::uint64_t generateHash(const std::filesystem::path& stem, std::string extension);
     };
 }
 
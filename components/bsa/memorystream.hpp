@@ -27,7 +27,10 @@
 #define BSA_MEMORY_STREAM_H
 
 #include <components/files/memorystream.hpp>
+#include <components/platform/file.hpp>
+
 #include <istream>
+#include <memory>
 #include <vector>
 
 namespace Bsa
@@ -53,5 +56,25 @@ namespace Bsa
         char* getRawData() { return this->data(); }
     };
 
+    /**
+        Allows to pass a region of memory mapped archive as Files::IStreamPtr without copying.
+
+        Mapping is kept alive while the class instance exists.
+     */
+    class MappedInputStream : public Files::MemBuf, public std::istream
+    {
+    public:
+        explicit MappedInputStream(
+            std::shared_ptr<const Platform::File::MappedFile> file, std::size_t offset, std::size_t size)
+            : Files::MemBuf(file->data() + offset, size)
+            , std::istream(static_cast<std::streambuf*>(this))
+            , mFile(std::move(file))
+        {
+        }
+
+    private:
+        std::shared_ptr<const Platform::File::MappedFile> mFile;
+    };
+
 }
 #endif
@@ -95,7 +95,7 @@ namespace DetourNavigator
             if (db == nullptr)
                 return nullptr;
             return std::make_unique<DbWorker>(updater, std::move(db), TileVersion(navMeshFormatVersion),
-                settings.mRecast, settings.mWriteToNavMeshDb);
+                settings.mRecast, settings.mWriteToNavMeshDb, settings.mNavMeshDbReaderThreads);
         }
 
         void updateJobs(std::deque<JobIt>& jobs, TilePosition playerTile, int maxTiles)
@@ -118,6 +118,8 @@ namespace DetourNavigator
         {
             return job.mGeneratedNavMeshData != nullptr;
         }
+
+        constexpr std::size_t maxDbWritingJobsPerTransaction = 64;
     }
 
     std::ostream& operator<<(std::ostream& stream, JobStatus value)
@@ -690,19 +692,29 @@ namespace DetourNavigator
         mHasJob.notify_all();
     }
 
-    std::optional<JobIt> DbJobQueue::pop()
+    std::vector<JobIt> DbJobQueue::pop(std::size_t maxWritingJobs)
     {
+        std::vector<JobIt> result;
         std::unique_lock lock(mMutex);
         mHasJob.wait(lock, [&] { return mShouldStop || !mJobs.empty(); });
         if (mJobs.empty())
-            return std::nullopt;
+            return result;
         const JobIt job = mJobs.front();
         mJobs.pop_front();
-        if (isWritingDbJob(*job))
-            --mWritingJobs;
-        else
+        result.push_back(job);
+        if (!isWritingDbJob(*job))
+        {
             --mReadingJobs;
-        return job;
+            return result;
+        }
+        --mWritingJobs;
+        while (result.size() < maxWritingJobs && !mJobs.empty() && isWritingDbJob(*mJobs.front()))
+        {
+            result.push_back(mJobs.front());
+            mJobs.pop_front();
+            --mWritingJobs;
+        }
+        return result;
     }
 
     void DbJobQueue::update(TilePosition playerTile, int maxTiles)
@@ -727,7 +739,7 @@ namespace DetourNavigator
     }
 
     DbWorker::DbWorker(AsyncNavMeshUpdater& updater, std::unique_ptr<NavMeshDb>&& db, TileVersion version,
-        const RecastSettings& recastSettings, bool writeToDb)
+        const RecastSettings& recastSettings, bool writeToDb, std::size_t readers)
         : mUpdater(updater)
         , mRecastSettings(recastSettings)
         , mDb(std::move(db))
@@ -737,6 +749,23 @@ namespace DetourNavigator
         , mNextShapeId(mDb->getMaxShapeId() + 1)
         , mThread([this] { run(); })
     {
+        for (std::size_t i = 0; i < readers; ++i)
+        {
+            try
+            {
+                std::unique_ptr<NavMeshDb> readerDb = mDb->makeReader();
+                if (readerDb == nullptr)
+                    break;
+                mReaders.push_back(Reader{ .mDb = std::move(readerDb), .mThread = {} });
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Error) << "Failed to open navmeshdb reader: " << e.what();
+                break;
+            }
+        }
+        for (Reader& reader : mReaders)
+            reader.mThread = std::thread([this, db = reader.mDb.get()] { runReader(*db); });
     }
 
     DbWorker::~DbWorker()
@@ -747,21 +776,37 @@ namespace DetourNavigator
     void DbWorker::enqueueJob(JobIt job)
     {
         Log(Debug::Debug) << "Enqueueing db job " << job->mId << " by thread=" << std::this_thread::get_id();
-        mQueue.push(job);
+        if (!mReaders.empty() && !isWritingDbJob(*job))
+            mReadingQueue.push(job);
+        else
+            mQueue.push(job);
+    }
+
+    void DbWorker::updateJobs(TilePosition playerTile, int maxTiles)
+    {
+        mQueue.update(playerTile, maxTiles);
+        mReadingQueue.update(playerTile, maxTiles);
     }
 
     DbWorkerStats DbWorker::getStats() const
     {
-        return DbWorkerStats{ .mJobs = mQueue.getStats(),
-            .mGetTileCount = mGetTileCount.load(std::memory_order_relaxed) };
+        DbJobQueueStats jobs = mQueue.getStats();
+        const DbJobQueueStats readingJobs = mReadingQueue.getStats();
+        jobs.mWritingJobs += readingJobs.mWritingJobs;
+        jobs.mReadingJobs += readingJobs.mReadingJobs;
+        return DbWorkerStats{ .mJobs = jobs, .mGetTileCount = mGetTileCount.load(std::memory_order_relaxed) };
     }
 
     void DbWorker::stop()
     {
         mShouldStop = true;
         mQueue.stop();
+        mReadingQueue.stop();
         if (mThread.joinable())
             mThread.join();
+        for (Reader& reader : mReaders)
+            if (reader.mThread.joinable())
+                reader.mThread.join();
     }
 
     void DbWorker::run() noexcept
@@ -770,8 +815,13 @@ namespace DetourNavigator
         {
             try
             {
-                if (const auto job = mQueue.pop())
-                    processJob(*job);
+                const std::vector<JobIt> jobs = mQueue.pop(maxDbWritingJobsPerTransaction);
+                if (jobs.empty())
+                    continue;
+                if (isWritingDbJob(*jobs.front()))
+                    processWritingJobs(jobs);
+                else
+                    processJob(jobs.front());
             }
             catch (const std::exception& e)
             {
@@ -780,6 +830,35 @@ namespace DetourNavigator
         }
     }
 
+    void DbWorker::runReader(NavMeshDb& db) noexcept
+    {
+        while (!mShouldStop)
+        {
+            try
+            {
+                const std::vector<JobIt> jobs = mReadingQueue.pop(0);
+                if (jobs.empty())
+                    continue;
+                const JobIt job = jobs.front();
+                try
+                {
+                    processReadingJob(job, db, false);
+                }
+                catch (const std::exception& e)
+                {
+                    Log(Debug::Error) << "DbWorker reader exception while processing job " << job->mId << ": "
+                                      << e.what();
+                }
+                job->mState = JobState::WithDbResult;
+                mUpdater.enqueueJob(job);
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Error) << "DbWorker reader exception: " << e.what();
+            }
+        }
+    }
+
     void DbWorker::processJob(JobIt job)
     {
         const auto process = [&](auto f) {
@@ -790,61 +869,98 @@ namespace DetourNavigator
             catch (const std::exception& e)
             {
                 Log(Debug::Error) << "DbWorker exception while processing job " << job->mId << ": " << e.what();
-                if (mWriteToDb)
-                {
-                    const std::string_view message(e.what());
-                    if (message.find("database or disk is full") != std::string_view::npos)
-                    {
-                        mWriteToDb = false;
-                        Log(Debug::Warning)
-                            << "Writes to navmeshdb are disabled because file size limit is reached or disk is full";
-                    }
-                    else if (message.find("database is locked") != std::string_view::npos)
-                    {
-                        mWriteToDb = false;
-                        Log(Debug::Warning)
-                            << "Writes to navmeshdb are disabled to avoid concurrent writes from multiple processes";
-                    }
-                }
+                handleWriteError(e.what());
             }
         };
 
         if (isWritingDbJob(*job))
         {
             process([&](JobIt job) { processWritingJob(job); });
-            mUpdater.removeJob(job);
             return;
         }
 
-        process([&](JobIt job) { processReadingJob(job); });
+        process([&](JobIt job) { processReadingJob(job, *mDb, mWriteToDb); });
         job->mState = JobState::WithDbResult;
         mUpdater.enqueueJob(job);
     }
 
-    void DbWorker::processReadingJob(JobIt job)
+    void DbWorker::processWritingJobs(const std::vector<JobIt>& jobs)
+    {
+        // Grouping writes reduces the number of journal syncs.
+        std::optional<Sqlite3::Transaction> transaction;
+        if (mWriteToDb && jobs.size() > 1)
+        {
+            try
+            {
+                transaction.emplace(mDb->startTransaction(Sqlite3::TransactionMode::Immediate));
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Error) << "DbWorker failed to start transaction: " << e.what();
+                handleWriteError(e.what());
+            }
+        }
+        for (const JobIt job : jobs)
+            processJob(job);
+        if (transaction.has_value())
+        {
+            try
+            {
+                transaction->commit();
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Error) << "DbWorker failed to commit " << jobs.size() << " db write jobs: " << e.what();
+                handleWriteError(e.what());
+            }
+        }
+        for (const JobIt job : jobs)
+            mUpdater.removeJob(job);
+    }
+
+    void DbWorker::handleWriteError(std::string_view message)
+    {
+        if (!mWriteToDb)
+            return;
+        if (message.find("database or disk is full") != std::string_view::npos)
+        {
+            mWriteToDb = false;
+            Log(Debug::Warning)
+                << "Writes to navmeshdb are disabled because file size limit is reached or disk is full";
+        }
+        else if (message.find("database is locked") != std::string_view::npos)
+        {
+            mWriteToDb = false;
+            Log(Debug::Warning)
+                << "Writes to navmeshdb are disabled to avoid concurrent writes from multiple processes";
+        }
+    }
+
+    void DbWorker::processReadingJob(JobIt job, NavMeshDb& db, bool writeShapes)
     {
         Log(Debug::Debug) << "Processing db read job " << job->mId;
 
         if (job->mInput.empty())
         {
             Log(Debug::Debug) << "Serializing input for job " << job->mId;
-            if (mWriteToDb)
+            if (writeShapes)
             {
                 const auto objects = makeDbRefGeometryObjects(job->mRecastMesh->getMeshSources(),
-                    [&](const MeshSource& v) { return resolveMeshSource(*mDb, v, mNextShapeId); });
+                    [&](const MeshSource& v) { return resolveMeshSource(db, v, mNextShapeId); });
                 job->mInput = serialize(mRecastSettings, job->mAgentBounds, *job->mRecastMesh, objects);
             }
             else
             {
+                // A tile can't be stored for a shape that isn't stored, so the writer will add the shape later.
                 const auto objects = makeDbRefGeometryObjects(job->mRecastMesh->getMeshSources(),
-                    [&](const MeshSource& v) { return resolveMeshSource(*mDb, v); });
+                    [&](const MeshSource& v) { return resolveMeshSource(db, v); });
                 if (!objects.has_value())
                     return;
                 job->mInput = serialize(mRecastSettings, job->mAgentBounds, *job->mRecastMesh, *objects);
             }
         }
 
-        job->mCachedTileData = mDb->getTileData(job->mWorldspace, job->mChangedTile, job->mInput);
+        job->mCachedTileData = db.getTileData(job->mWorldspace, job->mChangedTile, job->mInput);
         ++mGetTileCount;
     }
 
@@ -26,8 +26,10 @@
 #include <mutex>
 #include <optional>
 #include <set>
+#include <string_view>
 #include <thread>
 #include <tuple>
+#include <vector>
 
 class dtNavMesh;
 
@@ -83,7 +85,8 @@ namespace DetourNavigator
     public:
         void push(JobIt job);
 
-        std::optional<JobIt> pop();
+        // Returns the first job. If it's a writing job, up to maxWritingJobs following writing jobs are taken with it.
+        std::vector<JobIt> pop(std::size_t maxWritingJobs);
 
         void update(TilePosition playerTile, int maxTiles);
 
@@ -106,7 +109,7 @@ namespace DetourNavigator
     {
     public:
         DbWorker(AsyncNavMeshUpdater& updater, std::unique_ptr<NavMeshDb>&& db, TileVersion version,
-            const RecastSettings& recastSettings, bool writeToDb);
+            const RecastSettings& recastSettings, bool writeToDb, std::size_t readers);
 
         ~DbWorker();
 
@@ -114,11 +117,17 @@ namespace DetourNavigator
 
         void enqueueJob(JobIt job);
 
-        void updateJobs(TilePosition playerTile, int maxTiles) { mQueue.update(playerTile, maxTiles); }
+        void updateJobs(TilePosition playerTile, int maxTiles);
 
         void stop();
 
     private:
+        struct Reader
+        {
+            std::unique_ptr<NavMeshDb> mDb;
+            std::thread mThread;
+        };
+
         AsyncNavMeshUpdater& mUpdater;
         const RecastSettings& mRecastSettings;
         const std::unique_ptr<NavMeshDb> mDb;
@@ -126,18 +135,27 @@ namespace DetourNavigator
         bool mWriteToDb;
         TileId mNextTileId;
         ShapeId mNextShapeId;
+        // Writing jobs and reading jobs when there are no readers.
         DbJobQueue mQueue;
+        DbJobQueue mReadingQueue;
         std::atomic_bool mShouldStop{ false };
         std::atomic_size_t mGetTileCount{ 0 };
+        std::vector<Reader> mReaders;
         std::thread mThread;
 
         inline void run() noexcept;
 
+        inline void runReader(NavMeshDb& db) noexcept;
+
         inline void processJob(JobIt job);
 
-        inline void processReadingJob(JobIt job);
+        inline void processWritingJobs(const std::vector<JobIt>& jobs);
+
+        inline void processReadingJob(JobIt job, NavMeshDb& db, bool writeShapes);
 
         inline void processWritingJob(JobIt job);
+
+        inline void handleWriteError(std::string_view message);
     };
 
     class AsyncNavMeshUpdater
@@ -1,6 +1,7 @@
 #include "navmeshdb.hpp"
 
 #include <components/debug/debuglog.hpp>
+#include <components/files/hash.hpp>
 #include <components/misc/compression.hpp>
 #include <components/misc/strings/format.hpp>
 #include <components/sqlite3/db.hpp>
@@ -10,8 +11,14 @@
 
 #include <sqlite3.h>
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <string>
 #include <string_view>
+#include <tuple>
 #include <vector>
 
 namespace DetourNavigator
@@ -29,12 +36,10 @@ namespace DetourNavigator
                 tile_position_y INTEGER NOT NULL,
                 version INTEGER NOT NULL,
                 input BLOB,
-                data BLOB
+                data BLOB,
+                input_hash BLOB
             );
 
-            CREATE UNIQUE INDEX IF NOT EXISTS index_unique_tiles_by_worldspace_and_tile_position_and_input
-                ON tiles (worldspace, tile_position_x, tile_position_y, input);
-
             CREATE INDEX IF NOT EXISTS index_tiles_by_worldspace_and_tile_position
                 ON tiles (worldspace, tile_position_x, tile_position_y);
 
@@ -51,6 +56,18 @@ namespace DetourNavigator
             COMMIT;
         )";
 
+        // Applied after input_hash column is added to the tiles created before it was introduced.
+        constexpr const char inputHashIndex[] = R"(
+            BEGIN TRANSACTION;
+
+            CREATE UNIQUE INDEX IF NOT EXISTS index_unique_tiles_by_worldspace_and_tile_position_and_input_hash
+                ON tiles (worldspace, tile_position_x, tile_position_y, input_hash);
+
+            DROP INDEX IF EXISTS index_unique_tiles_by_worldspace_and_tile_position_and_input;
+
+            COMMIT;
+        )";
+
         constexpr std::string_view getMaxTileIdQuery = R"(
             SELECT max(tile_id) FROM tiles
         )";
@@ -61,7 +78,7 @@ namespace DetourNavigator
              WHERE worldspace = :worldspace
                AND tile_position_x = :tile_position_x
                AND tile_position_y = :tile_position_y
-               AND input = :input
+               AND input_hash = :input_hash
         )";
 
         constexpr std::string_view getTileDataQuery = R"(
@@ -70,12 +87,14 @@ namespace DetourNavigator
              WHERE worldspace = :worldspace
                AND tile_position_x = :tile_position_x
                AND tile_position_y = :tile_position_y
-               AND input = :input
+               AND input_hash = :input_hash
         )";
 
         constexpr std::string_view insertTileQuery = R"(
-            INSERT INTO tiles ( tile_id,  worldspace,  version,  tile_position_x,  tile_position_y,  input,  data)
-                   VALUES     (:tile_id, :worldspace, :version, :tile_position_x, :tile_position_y, :input, :data)
+            INSERT INTO tiles ( tile_id,  worldspace,  version,  tile_position_x,  tile_position_y,
+                                input,  input_hash,  data)
+                   VALUES     (:tile_id, :worldspace, :version, :tile_position_x, :tile_position_y,
+                               :input, :input_hash, :data)
         )";
 
         constexpr std::string_view updateTileQuery = R"(
@@ -138,6 +157,97 @@ namespace DetourNavigator
             static void bind(sqlite3&, sqlite3_stmt&) {}
         };
 
+        struct HasInputHashColumn
+        {
+            static std::string_view text() noexcept
+            {
+                return "SELECT count(*) FROM pragma_table_info('tiles') WHERE name = 'input_hash';";
+            }
+            static void bind(sqlite3&, sqlite3_stmt&) {}
+        };
+
+        struct GetTilesWithoutInputHash
+        {
+            static std::string_view text() noexcept
+            {
+                return "SELECT tile_id, input FROM tiles WHERE input_hash IS NULL AND input IS NOT NULL LIMIT 256;";
+            }
+            static void bind(sqlite3&, sqlite3_stmt&) {}
+        };
+
+        struct SetInputHash
+        {
+            static std::string_view text() noexcept
+            {
+                return "UPDATE tiles SET input_hash = :input_hash WHERE tile_id = :tile_id;";
+            }
+            static void bind(sqlite3& db, sqlite3_stmt& statement, TileId tileId, const Sqlite3::ConstBlob& inputHash)
+            {
+                Sqlite3::bindParameter(db, statement, ":tile_id", tileId);
+                Sqlite3::bindParameter(db, statement, ":input_hash", inputHash);
+            }
+        };
+
+        using InputHash = std::array<std::uint64_t, 2>;
+
+        InputHash getInputHash(const std::vector<std::byte>& input)
+        {
+            return Files::getHash(std::string_view(reinterpret_cast<const char*>(input.data()), input.size()));
+        }
+
+        Sqlite3::ConstBlob toBlob(const InputHash& hash)
+        {
+            return Sqlite3::ConstBlob{ reinterpret_cast<const char*>(hash.data()), static_cast<int>(sizeof(hash)) };
+        }
+
+        void exec(sqlite3& db, const char* query, std::string_view description)
+        {
+            if (const int ec = sqlite3_exec(&db, query, nullptr, nullptr, nullptr); ec != SQLITE_OK)
+                throw std::runtime_error("Failed to " + std::string(description) + ": " + sqlite3_errmsg(&db));
+        }
+
+        // Tiles written before lookup by input hash was introduced have only compressed input.
+        void addInputHashes(sqlite3& db)
+        {
+            std::int64_t hasColumn = 0;
+            Sqlite3::Statement<HasInputHashColumn> hasInputHashColumn(db);
+            request(db, hasInputHashColumn, &hasColumn, 1);
+            if (hasColumn == 0)
+                exec(db, "ALTER TABLE tiles ADD COLUMN input_hash BLOB;", "add input_hash column");
+            std::size_t count = 0;
+            {
+                Sqlite3::Statement<GetTilesWithoutInputHash> getTiles(db);
+                Sqlite3::Statement<SetInputHash> setInputHash(db);
+                std::vector<std::tuple<TileId, std::vector<std::byte>>> tiles;
+                Sqlite3::Transaction transaction(db);
+                while (true)
+                {
+                    tiles.clear();
+                    request(db, getTiles, std::back_inserter(tiles), std::numeric_limits<std::size_t>::max());
+                    if (tiles.empty())
+                        break;
+                    for (const auto& [tileId, input] : tiles)
+                        execute(db, setInputHash, tileId, toBlob(getInputHash(Misc::decompress(input))));
+                    count += tiles.size();
+                }
+                transaction.commit();
+            }
+            if (count > 0)
+                Log(Debug::Info) << "Added input hash to " << count << " navmeshdb tiles";
+            exec(db, inputHashIndex, "create input_hash index");
+        }
+
+        Sqlite3::Db makeNavMeshDb(std::string_view path)
+        {
+            Sqlite3::Db db = Sqlite3::makeDb(path, schema);
+            addInputHashes(*db);
+            // Readers don't block the writer and the writer doesn't block readers. Losing the last transactions on
+            // a power failure is acceptable for the cache so full sync isn't required.
+            exec(*db, "pragma journal_mode = WAL;", "set journal mode");
+            exec(*db, "pragma synchronous = NORMAL;", "set synchronous mode");
+            return db;
+        }
+
         std::uint64_t getPageSize(sqlite3& db)
         {
             Sqlite3::Statement<GetPageSize> statement(db);
@@ -167,7 +277,16 @@ namespace DetourNavigator
     }
 
     NavMeshDb::NavMeshDb(std::string_view path, std::uint64_t maxFileSize)
-        : mDb(Sqlite3::makeDb(path, schema))
+        : NavMeshDb(makeNavMeshDb(path))
+    {
+        const std::uint64_t dbPageSize = getPageSize(*mDb);
+        if (dbPageSize == 0)
+            throw std::runtime_error("NavMeshDb page size is zero");
+        setMaxPageCount(*mDb, maxFileSize / dbPageSize + static_cast<std::uint64_t>((maxFileSize % dbPageSize) != 0));
+    }
+
+    NavMeshDb::NavMeshDb(Sqlite3::Db&& db)
+        : mDb(std::move(db))
         , mGetMaxTileId(*mDb, DbQueries::GetMaxTileId{})
         , mFindTile(*mDb, DbQueries::FindTile{})
         , mGetTileData(*mDb, DbQueries::GetTileData{})
@@ -181,10 +300,17 @@ namespace DetourNavigator
         , mInsertShape(*mDb, DbQueries::InsertShape{})
         , mVacuum(*mDb, DbQueries::Vacuum{})
     {
-        const std::uint64_t dbPageSize = getPageSize(*mDb);
-        if (dbPageSize == 0)
-            throw std::runtime_error("NavMeshDb page size is zero");
-        setMaxPageCount(*mDb, maxFileSize / dbPageSize + static_cast<std::uint64_t>((maxFileSize % dbPageSize) != 0));
+    }
+
+    std::unique_ptr<NavMeshDb> NavMeshDb::makeReader() const
+    {
+        const char* const path = sqlite3_db_filename(mDb.get(), "main");
+        if (path == nullptr || *path == '\0')
+            return nullptr;
+        Sqlite3::Db db = Sqlite3::makeReadOnlyDb(path);
+        // Checkpoint may hold a lock for a short time.
+        sqlite3_busy_timeout(db.get(), 1000);
+        return std::unique_ptr<NavMeshDb>(new NavMeshDb(std::move(db)));
     }
 
     Sqlite3::Transaction NavMeshDb::startTransaction(Sqlite3::TransactionMode mode)
@@ -204,8 +330,8 @@ namespace DetourNavigator
     {
         Tile result;
         auto row = std::tie(result.mTileId, result.mVersion);
-        const std::vector<std::byte> compressedInput = Misc::compress(input);
-        if (&row == request(*mDb, mFindTile, &row, 1, worldspace, tilePosition, compressedInput))
+        const InputHash inputHash = getInputHash(input);
+        if (&row == request(*mDb, mFindTile, &row, 1, worldspace, tilePosition, toBlob(inputHash)))
             return {};
         return result;
     }
@@ -215,8 +341,8 @@ namespace DetourNavigator
     {
         TileData result;
         auto row = std::tie(result.mTileId, result.mVersion, result.mData);
-        const std::vector<std::byte> compressedInput = Misc::compress(input);
-        if (&row == request(*mDb, mGetTileData, &row, 1, worldspace, tilePosition, compressedInput))
+        const InputHash inputHash = getInputHash(input);
+        if (&row == request(*mDb, mGetTileData, &row, 1, worldspace, tilePosition, toBlob(inputHash)))
             return {};
         result.mData = Misc::decompress(result.mData);
         return result;
@@ -226,8 +352,10 @@ namespace DetourNavigator
         TileVersion version, const std::vector<std::byte>& input, const std::vector<std::byte>& data)
     {
         const std::vector<std::byte> compressedInput = Misc::compress(input);
+        const InputHash inputHash = getInputHash(input);
         const std::vector<std::byte> compressedData = Misc::compress(data);
-        return execute(*mDb, mInsertTile, tileId, worldspace, tilePosition, version, compressedInput, compressedData);
+        return execute(*mDb, mInsertTile, tileId, worldspace, tilePosition, version, compressedInput,
+            toBlob(inputHash), compressedData);
     }
 
     int NavMeshDb::updateTile(TileId tileId, TileVersion version, const std::vector<std::byte>& data)
@@ -290,12 +418,12 @@ namespace DetourNavigator
         }
 
         void FindTile::bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace,
-            const TilePosition& tilePosition, const std::vector<std::byte>& input)
+            const TilePosition& tilePosition, const Sqlite3::ConstBlob& inputHash)
         {
             Sqlite3::bindParameter(db, statement, ":worldspace", worldspace);
             Sqlite3::bindParameter(db, statement, ":tile_position_x", tilePosition.x());
             Sqlite3::bindParameter(db, statement, ":tile_position_y", tilePosition.y());
-            Sqlite3::bindParameter(db, statement, ":input", input);
+            Sqlite3::bindParameter(db, statement, ":input_hash", inputHash);
         }
 
         std::string_view GetTileData::text() noexcept
@@ -304,12 +432,12 @@ namespace DetourNavigator
         }
 
         void GetTileData::bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace,
-            const TilePosition& tilePosition, const std::vector<std::byte>& input)
+            const TilePosition& tilePosition, const Sqlite3::ConstBlob& inputHash)
         {
             Sqlite3::bindParameter(db, statement, ":worldspace", worldspace);
             Sqlite3::bindParameter(db, statement, ":tile_position_x", tilePosition.x());
             Sqlite3::bindParameter(db, statement, ":tile_position_y", tilePosition.y());
-            Sqlite3::bindParameter(db, statement, ":input", input);
+            Sqlite3::bindParameter(db, statement, ":input_hash", inputHash);
         }
 
         std::string_view InsertTile::text() noexcept
@@ -319,7 +447,7 @@ namespace DetourNavigator
 
         void InsertTile::bind(sqlite3& db, sqlite3_stmt& statement, TileId tileId, std::string_view worldspace,
             const TilePosition& tilePosition, TileVersion version, const std::vector<std::byte>& input,
-            const std::vector<std::byte>& data)
+            const Sqlite3::ConstBlob& inputHash, const std::vector<std::byte>& data)
         {
             Sqlite3::bindParameter(db, statement, ":tile_id", tileId);
             Sqlite3::bindParameter(db, statement, ":worldspace", worldspace);
@@ -327,6 +455,7 @@ namespace DetourNavigator
             Sqlite3::bindParameter(db, statement, ":tile_position_y", tilePosition.y());
             Sqlite3::bindParameter(db, statement, ":version", version);
             Sqlite3::bindParameter(db, statement, ":input", input);
+            Sqlite3::bindParameter(db, statement, ":input_hash", inputHash);
             Sqlite3::bindParameter(db, statement, ":data", data);
         }
 
@@ -65,14 +65,14 @@ namespace DetourNavigator
         {
             static std::string_view text() noexcept;
             static void bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace,
-                const TilePosition& tilePosition, const std::vector<std::byte>& input);
+                const TilePosition& tilePosition, const Sqlite3::ConstBlob& inputHash);
         };
 
         struct GetTileData
         {
             static std::string_view text() noexcept;
             static void bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace,
-                const TilePosition& tilePosition, const std::vector<std::byte>& input);
+                const TilePosition& tilePosition, const Sqlite3::ConstBlob& inputHash);
         };
 
         struct InsertTile
@@ -80,7 +80,7 @@ namespace DetourNavigator
             static std::string_view text() noexcept;
             static void bind(sqlite3& db, sqlite3_stmt& statement, TileId tileId, std::string_view worldspace,
                 const TilePosition& tilePosition, TileVersion version, const std::vector<std::byte>& input,
-                const std::vector<std::byte>& data);
+                const Sqlite3::ConstBlob& inputHash, const std::vector<std::byte>& data);
         };
 
         struct UpdateTile
@@ -138,11 +138,16 @@ namespace DetourNavigator
         };
     }
 
+    // Tiles are looked up by a hash of the uncompressed input, the compressed input is stored only for reference.
+    // File database uses WAL journal mode so connections created by makeReader can read while another one writes.
     class NavMeshDb
     {
     public:
         explicit NavMeshDb(std::string_view path, std::uint64_t maxFileSize);
 
+        // Opens a read only connection to the same database. Returns nullptr for in-memory database.
+        std::unique_ptr<NavMeshDb> makeReader() const;
+
         Sqlite3::Transaction startTransaction(Sqlite3::TransactionMode mode = Sqlite3::TransactionMode::Default);
 
         TileId getMaxTileId();
@@ -173,6 +178,8 @@ namespace DetourNavigator
         void vacuum();
 
     private:
+        explicit NavMeshDb(Sqlite3::Db&& db);
+
         Sqlite3::Db mDb;
         Sqlite3::Statement<DbQueries::GetMaxTileId> mGetMaxTileId;
         Sqlite3::Statement<DbQueries::FindTile> mFindTile;
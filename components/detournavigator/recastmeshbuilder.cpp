@@ -240,6 +240,13 @@ namespace DetourNavigator
         }
     }
 
+    void RecastMeshBuilder::addObject(const std::vector<RecastMeshTriangle>& triangles, const AreaType areaType,
+        osg::ref_ptr<const Resource::BulletShape> source, const ObjectTransform& objectTransform)
+    {
+        mTriangles.insert(mTriangles.end(), triangles.begin(), triangles.end());
+        mSources.push_back(MeshSource{ std::move(source), objectTransform, areaType });
+    }
+
     void RecastMeshBuilder::addWater(const osg::Vec2i& cellPosition, const Water& water)
     {
         mWater.push_back(CellWater{ cellPosition, water });
@@ -302,6 +309,14 @@ namespace DetourNavigator
             std::move(mFlatHeightfields), std::move(mSources));
     }
 
+    std::vector<RecastMeshTriangle> RecastMeshBuilder::makeObjectTriangles(const TileBounds& bounds,
+        const btCollisionShape& shape, const btTransform& transform, const AreaType areaType)
+    {
+        RecastMeshBuilder builder(bounds);
+        builder.addObject(shape, transform, areaType);
+        return std::move(builder.mTriangles);
+    }
+
     void RecastMeshBuilder::addObject(
         const btConcaveShape& shape, const btTransform& transform, btTriangleCallback&& callback)
     {
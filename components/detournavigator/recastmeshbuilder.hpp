@@ -51,6 +51,9 @@ namespace DetourNavigator
 
         void addObject(const btBoxShape& shape, const btTransform& transform, const AreaType areaType);
 
+        void addObject(const std::vector<RecastMeshTriangle>& triangles, const AreaType areaType,
+            osg::ref_ptr<const Resource::BulletShape> source, const ObjectTransform& objectTransform);
+
         void addWater(const osg::Vec2i& cellPosition, const Water& water);
 
         void addHeightfield(const osg::Vec2i& cellPosition, int cellSize, float height);
@@ -60,6 +63,10 @@ namespace DetourNavigator
 
         std::shared_ptr<RecastMesh> create(const Version& version) &&;
 
+        // Triangles of the object inside the bounds, they can be added to a builder with the same bounds.
+        static std::vector<RecastMeshTriangle> makeObjectTriangles(const TileBounds& bounds,
+            const btCollisionShape& shape, const btTransform& transform, const AreaType areaType);
+
     private:
         const TileBounds mBounds;
         std::vector<RecastMeshTriangle> mTriangles;
@@ -75,6 +75,7 @@ namespace DetourNavigator
         result.mEnableNavMeshDiskCache = ::Settings::Manager::getBool("enable nav mesh disk cache", "Navigator");
         result.mWriteToNavMeshDb = ::Settings::Manager::getBool("write to navmeshdb", "Navigator");
         result.mMaxDbFileSize = ::Settings::Manager::getUInt64("max navmeshdb file size", "Navigator");
+        result.mNavMeshDbReaderThreads = ::Settings::Manager::getSize("navmeshdb reader threads", "Navigator");
 
         return result;
     }
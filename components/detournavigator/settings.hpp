@@ -51,6 +51,7 @@ namespace DetourNavigator
         std::string mNavMeshPathPrefix;
         std::chrono::milliseconds mMinUpdateInterval;
         std::uint64_t mMaxDbFileSize = 0;
+        std::size_t mNavMeshDbReaderThreads = 0;
     };
 
     inline constexpr std::int64_t navMeshFormatVersion = 2;
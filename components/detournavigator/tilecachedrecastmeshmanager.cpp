@@ -125,7 +125,7 @@ namespace DetourNavigator
         mObjects.clear();
         mWater.clear();
         mHeightfields.clear();
-        mCache.clear();
+        clearCache();
     }
 
     bool TileCachedRecastMeshManager::addObject(ObjectId id, const CollisionShape& shape, const btTransform& transform,
@@ -147,6 +147,8 @@ namespace DetourNavigator
                               .mAabb = CommulativeAabb(revision, BulletHelpers::getAabb(shape.getShape(), transform)),
                               .mGeneration = mGeneration,
                               .mRevision = revision,
+                              .mTrianglesVersion = ++mTrianglesVersion,
+                              .mUpdated = false,
                               .mLastNavMeshReportedChange = {},
                               .mLastNavMeshReport = {},
                           }))
@@ -172,6 +174,8 @@ namespace DetourNavigator
                 return false;
             if (!it->second->mObject.update(transform, areaType))
                 return false;
+            it->second->mTrianglesVersion = ++mTrianglesVersion;
+            it->second->mUpdated = true;
             const std::size_t lastChangeRevision = it->second->mLastNavMeshReportedChange.has_value()
                 ? it->second->mLastNavMeshReportedChange->mRevision
                 : mRevision;
@@ -328,18 +332,28 @@ namespace DetourNavigator
             const std::lock_guard lock(mMutex);
             if (mWorldspace != worldspace)
                 return nullptr;
-            const auto it = mCache.find(tilePosition);
-            if (it != mCache.end() && it->second.mRecastMesh->getVersion() == it->second.mVersion)
-                return it->second.mRecastMesh;
         }
-        auto result = makeMesh(tilePosition);
+        CacheShard& shard = getCacheShard(tilePosition);
+        ObjectsTriangles objectsTriangles;
+        {
+            const std::lock_guard lock(shard.mMutex);
+            const auto it = shard.mTiles.find(tilePosition);
+            if (it != shard.mTiles.end())
+            {
+                if (it->second.mRecastMesh->getVersion() == it->second.mVersion)
+                    return it->second.mRecastMesh;
+                objectsTriangles = it->second.mObjectsTriangles;
+            }
+        }
+        auto result = makeMesh(tilePosition, &objectsTriangles);
         if (result != nullptr)
         {
-            const std::lock_guard lock(mMutex);
-            mCache.insert_or_assign(tilePosition,
+            const std::lock_guard lock(shard.mMutex);
+            shard.mTiles.insert_or_assign(tilePosition,
                 CachedTile{
                     .mVersion = result->getVersion(),
                     .mRecastMesh = result,
+                    .mObjectsTriangles = std::move(objectsTriangles),
                 });
         }
         return result;
@@ -348,11 +362,15 @@ namespace DetourNavigator
     std::shared_ptr<RecastMesh> TileCachedRecastMeshManager::getCachedMesh(
         std::string_view worldspace, const TilePosition& tilePosition) const
     {
-        const std::lock_guard lock(mMutex);
-        if (mWorldspace != worldspace)
-            return nullptr;
-        const auto it = mCache.find(tilePosition);
-        if (it == mCache.end())
+        {
+            const std::lock_guard lock(mMutex);
+            if (mWorldspace != worldspace)
+                return nullptr;
+        }
+        const CacheShard& shard = getCacheShard(tilePosition);
+        const std::lock_guard lock(shard.mMutex);
+        const auto it = shard.mTiles.find(tilePosition);
+        if (it == shard.mTiles.end())
             return nullptr;
         return it->second.mRecastMesh;
     }
@@ -365,7 +383,7 @@ namespace DetourNavigator
             if (mWorldspace != worldspace)
                 return nullptr;
         }
-        return makeMesh(tilePosition);
+        return makeMesh(tilePosition, nullptr);
     }
 
     void TileCachedRecastMeshManager::reportNavMeshChange(
@@ -400,8 +418,12 @@ namespace DetourNavigator
         {
             const MaybeLockGuard lock(mMutex, guard);
             for (const auto& [tilePosition, changeType] : mChangedTiles)
-                if (const auto it = mCache.find(tilePosition); it != mCache.end())
+            {
+                CacheShard& shard = getCacheShard(tilePosition);
+                const std::lock_guard shardLock(shard.mMutex);
+                if (const auto it = shard.mTiles.find(tilePosition); it != shard.mTiles.end())
                     ++it->second.mVersion.mRevision;
+            }
         }
         return std::move(mChangedTiles);
     }
@@ -443,14 +465,40 @@ namespace DetourNavigator
         return boost::geometry::index::intersects(IndexBox(point, point));
     }
 
-    std::shared_ptr<RecastMesh> TileCachedRecastMeshManager::makeMesh(const TilePosition& tilePosition) const
+    TileCachedRecastMeshManager::CacheShard& TileCachedRecastMeshManager::getCacheShard(
+        const TilePosition& tilePosition)
     {
-        RecastMeshBuilder builder(makeRealTileBoundsWithBorder(mSettings, tilePosition));
+        const auto hash = static_cast<unsigned>(tilePosition.x()) * 73856093u
+            ^ static_cast<unsigned>(tilePosition.y()) * 19349663u;
+        return mCache[hash % sCacheShards];
+    }
+
+    const TileCachedRecastMeshManager::CacheShard& TileCachedRecastMeshManager::getCacheShard(
+        const TilePosition& tilePosition) const
+    {
+        return const_cast<TileCachedRecastMeshManager*>(this)->getCacheShard(tilePosition);
+    }
+
+    void TileCachedRecastMeshManager::clearCache()
+    {
+        for (CacheShard& shard : mCache)
+        {
+            const std::lock_guard lock(shard.mMutex);
+            shard.mTiles.clear();
+        }
+    }
+
+    std::shared_ptr<RecastMesh> TileCachedRecastMeshManager::makeMesh(
+        const TilePosition& tilePosition, ObjectsTriangles* objectsTriangles) const
+    {
+        const TileBounds bounds = makeRealTileBoundsWithBorder(mSettings, tilePosition);
+        RecastMeshBuilder builder(bounds);
         using Object = std::tuple<osg::ref_ptr<const Resource::BulletShapeInstance>, ObjectTransform,
-            std::reference_wrapper<const btCollisionShape>, btTransform, AreaType>;
+            std::reference_wrapper<const btCollisionShape>, btTransform, AreaType, std::size_t>;
         std::vector<Object> objects;
         Version version;
         bool hasInput = false;
+        bool hasUpdatedObjects = false;
         {
             const std::lock_guard lock(mMutex);
             for (auto it = mWaterIndex.qbegin(makeIndexQuery(tilePosition)); it != mWaterIndex.qend(); ++it)
@@ -470,7 +518,8 @@ namespace DetourNavigator
             {
                 const auto& object = it->second->mObject;
                 objects.emplace_back(object.getInstance(), object.getObjectTransform(), object.getShape(),
-                    object.getTransform(), object.getAreaType());
+                    object.getTransform(), object.getAreaType(), it->second->mTrianglesVersion);
+                hasUpdatedObjects = hasUpdatedObjects || it->second->mUpdated;
                 hasInput = true;
             }
             if (hasInput)
@@ -486,9 +535,34 @@ namespace DetourNavigator
             }
         }
         if (!hasInput)
+        {
+            if (objectsTriangles != nullptr)
+                objectsTriangles->clear();
             return nullptr;
-        for (const auto& [instance, objectTransform, shape, transform, areaType] : objects)
-            builder.addObject(shape, transform, areaType, instance->getSource(), objectTransform);
+        }
+        // Static geometry is not worth keeping twice, so the triangles are reused only when there are moving objects.
+        if (objectsTriangles == nullptr || !hasUpdatedObjects)
+        {
+            if (objectsTriangles != nullptr)
+                objectsTriangles->clear();
+            for (const auto& [instance, objectTransform, shape, transform, areaType, trianglesVersion] : objects)
+                builder.addObject(shape, transform, areaType, instance->getSource(), objectTransform);
+            return std::move(builder).create(version);
+        }
+        ObjectsTriangles usedTriangles;
+        usedTriangles.reserve(objects.size());
+        for (const auto& [instance, objectTransform, shape, transform, areaType, trianglesVersion] : objects)
+        {
+            std::shared_ptr<const std::vector<RecastMeshTriangle>> triangles;
+            if (const auto it = objectsTriangles->find(trianglesVersion); it != objectsTriangles->end())
+                triangles = it->second;
+            else
+                triangles = std::make_shared<const std::vector<RecastMeshTriangle>>(
+                    RecastMeshBuilder::makeObjectTriangles(bounds, shape, transform, areaType));
+            builder.addObject(*triangles, areaType, instance->getSource(), objectTransform);
+            usedTriangles.emplace(trianglesVersion, std::move(triangles));
+        }
+        *objectsTriangles = std::move(usedTriangles);
         return std::move(builder).create(version);
     }
 
@@ -8,6 +8,7 @@
 #include "heightfieldshape.hpp"
 #include "objectid.hpp"
 #include "recastmesh.hpp"
+#include "recastmeshbuilder.hpp"
 #include "recastmeshobject.hpp"
 #include "tileposition.hpp"
 #include "version.hpp"
@@ -16,9 +17,11 @@
 #include <boost/geometry/geometries/point.hpp>
 #include <boost/geometry/index/rtree.hpp>
 
+#include <array>
 #include <map>
 #include <mutex>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
 namespace DetourNavigator
@@ -92,6 +95,9 @@ namespace DetourNavigator
             CommulativeAabb mAabb;
             std::size_t mGeneration = 0;
             std::size_t mRevision = 0;
+            // Identifies the triangles produced by the object, changes with every update of the object.
+            std::size_t mTrianglesVersion = 0;
+            bool mUpdated = false;
             std::optional<Report> mLastNavMeshReportedChange;
             std::optional<Report> mLastNavMeshReport;
         };
@@ -111,12 +117,26 @@ namespace DetourNavigator
             std::size_t mRevision;
         };
 
+        using ObjectsTriangles
+            = std::unordered_map<std::size_t, std::shared_ptr<const std::vector<RecastMeshTriangle>>>;
+
         struct CachedTile
         {
             Version mVersion;
             std::shared_ptr<RecastMesh> mRecastMesh;
+            // Triangles of each object by ObjectData::mTrianglesVersion. Kept only for tiles with moving objects to
+            // rebuild the mesh without going through the shapes of the objects that didn't change.
+            ObjectsTriangles mObjectsTriangles;
+        };
+
+        struct CacheShard
+        {
+            mutable std::mutex mMutex;
+            std::map<TilePosition, CachedTile> mTiles;
         };
 
+        static constexpr std::size_t sCacheShards = 16;
+
         using IndexPoint = boost::geometry::model::point<int, 2, boost::geometry::cs::cartesian>;
         using IndexBox = boost::geometry::model::box<IndexPoint>;
         using ObjectIndexValue = std::pair<IndexBox, ObjectData*>;
@@ -135,9 +155,11 @@ namespace DetourNavigator
         std::map<osg::Vec2i, HeightfieldData>::const_iterator mInfiniteHeightfield = mHeightfields.end();
         boost::geometry::index::rtree<HeightfieldIndexValue, boost::geometry::index::linear<4>> mHeightfieldIndex;
         std::map<osg::Vec2i, ChangeType> mChangedTiles;
-        std::map<TilePosition, CachedTile> mCache;
+        // Locked after mMutex when both are required.
+        std::array<CacheShard, sCacheShards> mCache;
         std::size_t mGeneration = 0;
         std::size_t mRevision = 0;
+        std::size_t mTrianglesVersion = 0;
         mutable std::mutex mMutex;
 
         inline static IndexPoint makeIndexPoint(const TilePosition& tilePosition);
@@ -155,7 +177,14 @@ namespace DetourNavigator
         inline static auto makeIndexQuery(const TilePosition& tilePosition)
             -> decltype(boost::geometry::index::intersects(IndexBox()));
 
-        inline std::shared_ptr<RecastMesh> makeMesh(const TilePosition& tilePosition) const;
+        inline CacheShard& getCacheShard(const TilePosition& tilePosition);
+
+        inline const CacheShard& getCacheShard(const TilePosition& tilePosition) const;
+
+        inline void clearCache();
+
+        inline std::shared_ptr<RecastMesh> makeMesh(
+            const TilePosition& tilePosition, ObjectsTriangles* objectsTriangles) const;
 
         inline void addChangedTiles(const std::optional<TilesPositionsRange>& range, ChangeType changeType);
     };
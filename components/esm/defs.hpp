@@ -193,6 +193,9 @@ namespace ESM
         // format 21 - Random state in saved games.
         REC_RAND = esm3Recname("RAND"), // Random state.
 
+        // format 24 - Compressed cell states in saved games.
+        REC_CSTC = esm3Recname("CSTC"), // Compressed cell state.
+
         REC_AACT4 = esm4Recname(ESM4::REC_AACT), // Action
         REC_ACHR4 = esm4Recname(ESM4::REC_ACHR), // Actor Reference
         REC_ACTI4 = esm4Recname(ESM4::REC_ACTI), // Activator
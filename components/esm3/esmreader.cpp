@@ -3,7 +3,6 @@
 #include "readerscache.hpp"
 
 #include <components/files/conversion.hpp>
-#include <components/files/openfile.hpp>
 #include <components/misc/strings/algorithm.hpp>
 
 #include <filesystem>
@@ -17,7 +16,7 @@ namespace ESM
     ESM_Context ESMReader::getContext()
     {
         // Update the file position before returning
-        mCtx.filePos = mEsm->tellg();
+        mCtx.filePos = getFileOffset();
         return mCtx;
     }
 
@@ -41,12 +40,15 @@ namespace ESM
         mCtx = rc;
 
         // Make sure we seek to the right place
-        mEsm->seekg(mCtx.filePos);
+        seek(mCtx.filePos);
     }
 
     void ESMReader::close()
     {
         mEsm.reset();
+        mMappedFile.reset();
+        mPos = nullptr;
+        mEnd = nullptr;
         clearCtx();
         mHeader.blank();
     }
@@ -97,13 +99,28 @@ namespace ESM
 
     void ESMReader::openRaw(const std::filesystem::path& filename)
     {
-        openRaw(Files::openBinaryInputFileStream(filename), filename);
+        close();
+        mMappedFile = std::make_unique<Platform::File::MappedFile>(filename);
+        mCtx.filename = filename;
+        mPos = mMappedFile->data();
+        mEnd = mPos + mMappedFile->size();
+        mCtx.leftFile = mFileSize = mMappedFile->size();
     }
 
     void ESMReader::open(std::unique_ptr<std::istream>&& stream, const std::filesystem::path& name)
     {
         openRaw(std::move(stream), name);
+        readHeader();
+    }
 
+    void ESMReader::open(const std::filesystem::path& file)
+    {
+        openRaw(file);
+        readHeader();
+    }
+
+    void ESMReader::readHeader()
+    {
         if (getRecName() != "TES3")
             fail("Not a valid Morrowind file");
 
@@ -112,9 +129,25 @@ namespace ESM
         mHeader.load(*this);
     }
 
-    void ESMReader::open(const std::filesystem::path& file)
+    int ESMReader::peek() const
     {
-        open(Files::openBinaryInputFileStream(file), file);
+        if (mMappedFile == nullptr)
+            return mEsm->peek();
+        if (mPos == mEnd)
+            return std::char_traits<char>::eof();
+        return static_cast<unsigned char>(*mPos);
+    }
+
+    void ESMReader::seek(std::size_t offset)
+    {
+        if (mMappedFile == nullptr)
+        {
+            mEsm->seekg(offset);
+            return;
+        }
+        if (offset > mMappedFile->size())
+            fail("Offset is out of file: " + std::to_string(offset));
+        mPos = mMappedFile->data() + offset;
     }
 
     std::string ESMReader::getHNOString(NAME name)
@@ -163,7 +196,7 @@ namespace ESM
         // them. For some reason, they break the rules, and contain a byte
         // (value 0) even if the header says there is no data. If
         // Morrowind accepts it, so should we.
-        if (mCtx.leftSub == 0 && hasMoreSubs() && !mEsm->peek())
+        if (mCtx.leftSub == 0 && hasMoreSubs() && !peek())
         {
             // Skip the following zero byte
             mCtx.leftRec--;
@@ -189,7 +222,7 @@ namespace ESM
         // them. For some reason, they break the rules, and contain a byte
         // (value 0) even if the header says there is no data. If
         // Morrowind accepts it, so should we.
-        if (mCtx.leftSub == 0 && hasMoreSubs() && !mEsm->peek())
+        if (mCtx.leftSub == 0 && hasMoreSubs() && !peek())
         {
             // Skip the following zero byte
             mCtx.leftRec--;
@@ -380,6 +413,18 @@ namespace ESM
 
     std::string_view ESMReader::getStringView(std::size_t size)
     {
+        if (mMappedFile != nullptr)
+        {
+            // Strings are read directly from the mapping, the encoder returns its input as is for ASCII strings
+            checkMappedSize(size);
+            const char* const ptr = mPos;
+            mPos += size;
+            const std::string_view value(ptr, strnlen(ptr, size));
+            if (mEncoder != nullptr)
+                return mEncoder->getUtf8(value);
+            return value;
+        }
+
         if (mBuffer.size() <= size)
             // Add some extra padding to reduce the chance of having to resize
             // again later.
@@ -414,8 +459,8 @@ namespace ESM
         ss << "\n  File: " << Files::pathToUnicodeString(mCtx.filename);
         ss << "\n  Record: " << mCtx.recName.toStringView();
         ss << "\n  Subrecord: " << mCtx.subName.toStringView();
-        if (mEsm.get())
-            ss << "\n  Offset: 0x" << std::hex << mEsm->tellg();
+        if (isOpen())
+            ss << "\n  Offset: 0x" << std::hex << getFileOffset();
         throw std::runtime_error(ss.str());
     }
 
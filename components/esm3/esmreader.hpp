@@ -2,11 +2,13 @@
 #define OPENMW_ESM_READER_H
 
 #include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <istream>
 #include <memory>
 #include <vector>
 
+#include <components/platform/file.hpp>
 #include <components/to_utf8/to_utf8.hpp>
 
 #include "components/esm/esmcommon.hpp"
@@ -40,7 +42,7 @@ namespace ESM
         const NAME& retSubName() const { return mCtx.subName; }
         uint32_t getSubSize() const { return mCtx.leftSub; }
         const std::filesystem::path& getName() const { return mCtx.filename; }
-        bool isOpen() const { return mEsm != nullptr; }
+        bool isOpen() const { return mEsm != nullptr || mMappedFile != nullptr; }
 
         /*************************************************************************
          *
@@ -69,12 +71,19 @@ namespace ESM
         /// currently open file first, if any.
         void open(std::unique_ptr<std::istream>&& stream, const std::filesystem::path& name);
 
+        /// Load ES file mapped into memory. Subrecords are read directly from the mapping and strings not requiring
+        /// conversion are returned as views into it.
         void open(const std::filesystem::path& file);
 
         void openRaw(const std::filesystem::path& filename);
 
         /// Get the current position in the file. Make sure that the file has been opened!
-        size_t getFileOffset() const { return mEsm->tellg(); }
+        size_t getFileOffset() const
+        {
+            if (mMappedFile != nullptr)
+                return static_cast<std::size_t>(mPos - mMappedFile->data());
+            return mEsm->tellg();
+        }
 
         // This is a quick hack for multiple esm/esp files. Each plugin introduces its own
         //  terrain palette, but ESMReader does not pass a reference to the correct plugin
@@ -273,7 +282,17 @@ namespace ESM
             skip(sizeof(T));
         }
 
-        void getExact(void* x, int size) { mEsm->read((char*)x, size); }
+        void getExact(void* x, int size)
+        {
+            if (mMappedFile == nullptr)
+            {
+                mEsm->read((char*)x, size);
+                return;
+            }
+            checkMappedSize(static_cast<std::size_t>(size));
+            std::memcpy(x, mPos, static_cast<std::size_t>(size));
+            mPos += size;
+        }
         void getName(NAME& name) { getT(name); }
         void getUint(uint32_t& u) { getT(u); }
 
@@ -289,6 +308,12 @@ namespace ESM
 
         void skip(std::size_t bytes)
         {
+            if (mMappedFile != nullptr)
+            {
+                checkMappedSize(bytes);
+                mPos += bytes;
+                return;
+            }
             char buffer[4096];
             if (bytes > std::size(buffer))
                 mEsm->seekg(getFileOffset() + bytes);
@@ -315,8 +340,25 @@ namespace ESM
 
         void clearCtx();
 
+        void readHeader();
+
+        void checkMappedSize(std::size_t size)
+        {
+            if (static_cast<std::size_t>(mEnd - mPos) < size)
+                fail("Unexpected end of file while reading " + std::to_string(size) + " bytes");
+        }
+
+        int peek() const;
+
+        void seek(std::size_t offset);
+
         std::unique_ptr<std::istream> mEsm;
 
+        // Used instead of mEsm when the file is opened by path
+        std::unique_ptr<Platform::File::MappedFile> mMappedFile;
+        const char* mPos = nullptr;
+        const char* mEnd = nullptr;
+
         ESM_Context mCtx;
 
         unsigned int mRecordFlags;
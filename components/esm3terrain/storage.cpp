@@ -1,5 +1,7 @@
 #include "storage.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <set>
 
 #include <osg/Image>
@@ -43,6 +45,21 @@ namespace ESMTerrain
 
     const float defaultHeight = ESM::Land::DEFAULT_HEIGHT;
 
+    namespace
+    {
+        float getVertexHeight(const ESM::Land::LandData& data, int x, int y)
+        {
+            assert(x < ESM::Land::LAND_SIZE);
+            assert(y < ESM::Land::LAND_SIZE);
+            return data.mHeights[y * ESM::Land::LAND_SIZE + x];
+        }
+
+        int getCellIndex(float coordinate)
+        {
+            return static_cast<int>(std::floor(coordinate / float(Constants::CellSizeInUnits)));
+        }
+    }
+
     Storage::Storage(const VFS::Manager* vfs, const std::string& normalMapPattern,
         const std::string& normalHeightMapPattern, bool autoUseNormalMaps, const std::string& specularMapPattern,
         bool autoUseSpecularMaps)
@@ -442,19 +459,8 @@ namespace ESMTerrain
             blendmaps.clear(); // If a single texture fills the whole terrain, there is no need to blend
     }
 
-    float Storage::getHeightAt(const osg::Vec3f& worldPos)
+    float getHeightAt(const ESM::Land::LandData& data, int cellX, int cellY, const osg::Vec3f& worldPos)
     {
-        int cellX = static_cast<int>(std::floor(worldPos.x() / float(Constants::CellSizeInUnits)));
-        int cellY = static_cast<int>(std::floor(worldPos.y() / float(Constants::CellSizeInUnits)));
-
-        osg::ref_ptr<const LandObject> land = getLand(cellX, cellY);
-        if (!land)
-            return defaultHeight;
-
-        const ESM::Land::LandData* data = land->getData(ESM::Land::DATA_VHGT);
-        if (!data)
-            return defaultHeight;
-
         // Mostly lifted from Ogre::Terrain::getHeightAtTerrainPosition
 
         // Normalized position in the cell
@@ -524,6 +530,101 @@ namespace ESMTerrain
             * Constants::CellSizeInUnits;
     }
 
+    void getHeightsAt(const ESM::Land::LandData& data, int cellX, int cellY, std::span<const osg::Vec3f> worldPositions,
+        std::span<float> heights)
+    {
+        assert(worldPositions.size() == heights.size());
+
+        constexpr int landSize = ESM::Land::LAND_SIZE;
+        constexpr float verticesPerUnit = (landSize - 1) / static_cast<float>(Constants::CellSizeInUnits);
+        constexpr std::size_t blockSize = 8;
+        const float originX = static_cast<float>(cellX * Constants::CellSizeInUnits);
+        const float originY = static_cast<float>(cellY * Constants::CellSizeInUnits);
+
+        for (std::size_t blockBegin = 0; blockBegin < worldPositions.size(); blockBegin += blockSize)
+        {
+            const std::size_t count = std::min(blockSize, worldPositions.size() - blockBegin);
+            const osg::Vec3f* const positions = worldPositions.data() + blockBegin;
+            float* const result = heights.data() + blockBegin;
+
+            // Position relative to the bottom left vertex of the quad containing it and index of that vertex
+            float x[blockSize];
+            float y[blockSize];
+            int index[blockSize];
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const float vertexX = std::clamp((positions[i].x() - originX) * verticesPerUnit, 0.f, landSize - 1.f);
+                const float vertexY = std::clamp((positions[i].y() - originY) * verticesPerUnit, 0.f, landSize - 1.f);
+                const int startX = std::min(static_cast<int>(vertexX), landSize - 2);
+                const int startY = std::min(static_cast<int>(vertexY), landSize - 2);
+                x[i] = vertexX - startX;
+                y[i] = vertexY - startY;
+                index[i] = startY * landSize + startX;
+            }
+
+            // Same vertex names as in getHeightAt
+            float h0[blockSize];
+            float h1[blockSize];
+            float h2[blockSize];
+            float h3[blockSize];
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                h0[i] = data.mHeights[index[i]];
+                h1[i] = data.mHeights[index[i] + 1];
+                h2[i] = data.mHeights[index[i] + landSize + 1];
+                h3[i] = data.mHeights[index[i] + landSize];
+            }
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const float first = h0[i] + (h1[i] - h0[i]) * x[i] + (h3[i] - h0[i]) * y[i];
+                const float second = h2[i] + (h3[i] - h2[i]) * (1 - x[i]) + (h1[i] - h2[i]) * (1 - y[i]);
+                result[i] = x[i] + y[i] < 1 ? first : second;
+            }
+        }
+    }
+
+    float Storage::getHeightAt(const osg::Vec3f& worldPos)
+    {
+        const int cellX = getCellIndex(worldPos.x());
+        const int cellY = getCellIndex(worldPos.y());
+
+        osg::ref_ptr<const LandObject> land = getLand(cellX, cellY);
+        if (!land)
+            return defaultHeight;
+
+        const ESM::Land::LandData* data = land->getData(ESM::Land::DATA_VHGT);
+        if (!data)
+            return defaultHeight;
+
+        return ESMTerrain::getHeightAt(*data, cellX, cellY, worldPos);
+    }
+
+    void Storage::getHeightsAt(std::span<const osg::Vec3f> worldPositions, std::span<float> heights)
+    {
+        assert(worldPositions.size() == heights.size());
+        std::size_t begin = 0;
+        while (begin < worldPositions.size())
+        {
+            const int cellX = getCellIndex(worldPositions[begin].x());
+            const int cellY = getCellIndex(worldPositions[begin].y());
+            std::size_t end = begin + 1;
+            while (end < worldPositions.size() && getCellIndex(worldPositions[end].x()) == cellX
+                && getCellIndex(worldPositions[end].y()) == cellY)
+                ++end;
+
+            const std::span<float> cellHeights = heights.subspan(begin, end - begin);
+            const osg::ref_ptr<const LandObject> land = getLand(cellX, cellY);
+            const ESM::Land::LandData* data = land != nullptr ? land->getData(ESM::Land::DATA_VHGT) : nullptr;
+            if (data == nullptr)
+                std::fill(cellHeights.begin(), cellHeights.end(), defaultHeight);
+            else
+                ESMTerrain::getHeightsAt(*data, cellX, cellY, worldPositions.subspan(begin, end - begin), cellHeights);
+
+            begin = end;
+        }
+    }
+
     const LandObject* Storage::getLand(int cellX, int cellY, LandCache& cache)
     {
         LandCache::Map::iterator found = cache.mMap.find(std::make_pair(cellX, cellY));
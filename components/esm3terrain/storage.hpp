@@ -3,6 +3,7 @@
 
 #include <cassert>
 #include <mutex>
+#include <span>
 
 #include <components/terrain/storage.hpp>
 
@@ -46,6 +47,16 @@ namespace ESMTerrain
         ESM::Land::LandData mData;
     };
 
+    /// @brief Interpolate the terrain height at the given world position using the heights of the land
+    /// containing it
+    float getHeightAt(const ESM::Land::LandData& data, int cellX, int cellY, const osg::Vec3f& worldPos);
+
+    /// @brief Same as getHeightAt for multiple positions within the same cell
+    /// The arithmetic is done in small blocks of positions separately from fetching the heights so the compiler can
+    /// vectorize it with the instruction set of the target platform.
+    void getHeightsAt(const ESM::Land::LandData& data, int cellX, int cellY, std::span<const osg::Vec3f> worldPositions,
+        std::span<float> heights);
+
     /// @brief Feeds data from ESM terrain records (ESM::Land, ESM::LandTexture)
     ///        into the terrain component, converting it on the fly as needed.
     class Storage : public Terrain::Storage
@@ -98,6 +109,8 @@ namespace ESMTerrain
 
         float getHeightAt(const osg::Vec3f& worldPos) override;
 
+        void getHeightsAt(std::span<const osg::Vec3f> worldPositions, std::span<float> heights) override;
+
         /// Get the transformation factor for mapping cell units to world units.
         float getCellWorldSize() override;
 
@@ -0,0 +1,486 @@
+#include "cache.hpp"
+#include "esmdata.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/esm3/loadacti.hpp>
+#include <components/esm3/loadcell.hpp>
+#include <components/esm3/loadcont.hpp>
+#include <components/esm3/loaddoor.hpp>
+#include <components/esm3/loadgmst.hpp>
+#include <components/esm3/loadland.hpp>
+#include <components/esm3/loadstat.hpp>
+#include <components/esm3/readerscache.hpp>
+#include <components/esm3/variant.hpp>
+#include <components/files/collections.hpp>
+#include <components/files/conversion.hpp>
+#include <components/files/hash.hpp>
+#include <components/files/multidircollection.hpp>
+#include <components/files/openfile.hpp>
+#include <components/misc/strings/lower.hpp>
+#include <components/platform/file.hpp>
+#include <components/serialization/binaryreader.hpp>
+#include <components/serialization/binarywriter.hpp>
+#include <components/serialization/format.hpp>
+#include <components/serialization/sizeaccumulator.hpp>
+#include <components/to_utf8/to_utf8.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace EsmLoader
+{
+    namespace
+    {
+        constexpr char cacheMagic[] = { 'O', 'E', 'S', 'M' };
+        constexpr std::uint32_t cacheVersion = 1;
+
+        struct ContentFile
+        {
+            std::string mName;
+            std::array<std::uint64_t, 2> mHash;
+
+            friend bool operator==(const ContentFile& l, const ContentFile& r)
+            {
+                return l.mName == r.mName && l.mHash == r.mHash;
+            }
+        };
+
+        struct CacheHeader
+        {
+            Query mQuery;
+            std::string mEncoding;
+            std::vector<ContentFile> mContentFiles;
+
+            friend bool operator==(const CacheHeader& l, const CacheHeader& r)
+            {
+                const auto tie = [](const Query& v) {
+                    return std::tie(v.mLoadActivators, v.mLoadCells, v.mLoadContainers, v.mLoadDoors,
+                        v.mLoadGameSettings, v.mLoadLands, v.mLoadStatics);
+                };
+                return tie(l.mQuery) == tie(r.mQuery) && l.mEncoding == r.mEncoding
+                    && l.mContentFiles == r.mContentFiles;
+            }
+        };
+
+        template <class T, class... Ts>
+        constexpr bool isOneOf = (std::is_same_v<std::decay_t<T>, Ts> || ...);
+
+        template <Serialization::Mode mode>
+        struct Format : Serialization::Format<mode, Format<mode>>
+        {
+            using Serialization::Format<mode, Format<mode>>::operator();
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const -> std::enable_if_t<isOneOf<T, std::string>>
+            {
+                if constexpr (mode == Serialization::Mode::Write)
+                    visitor(*this, static_cast<std::uint64_t>(value.size()));
+                else
+                {
+                    static_assert(mode == Serialization::Mode::Read);
+                    std::uint64_t size = 0;
+                    visitor(*this, size);
+                    value.resize(static_cast<std::size_t>(size));
+                }
+                visitor(*this, value.data(), value.size());
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const -> std::enable_if_t<isOneOf<T, ESM::RefId>>
+            {
+                if constexpr (mode == Serialization::Mode::Write)
+                    visitor(*this, value.getRefIdString());
+                else
+                {
+                    static_assert(mode == Serialization::Mode::Read);
+                    std::string id;
+                    visitor(*this, id);
+                    value = ESM::RefId::stringRefId(id);
+                }
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const -> std::enable_if_t<isOneOf<T, std::filesystem::path>>
+            {
+                if constexpr (mode == Serialization::Mode::Write)
+                    visitor(*this, Files::pathToUnicodeString(value));
+                else
+                {
+                    static_assert(mode == Serialization::Mode::Read);
+                    std::string path;
+                    visitor(*this, path);
+                    value = Files::pathFromUnicodeString(path);
+                }
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const -> std::enable_if_t<isOneOf<T, ESM::Variant>>
+            {
+                ESM::VarType type = value.getType();
+                visitField<std::int32_t>(visitor, type);
+                if constexpr (mode == Serialization::Mode::Read)
+                    value.setType(type);
+                switch (type)
+                {
+                    case ESM::VT_Short:
+                    case ESM::VT_Int:
+                    case ESM::VT_Long:
+                        return visitValue<std::int32_t>(
+                            visitor, value, &ESM::Variant::getInteger, &ESM::Variant::setInteger);
+                    case ESM::VT_Float:
+                        return visitValue<float>(visitor, value, &ESM::Variant::getFloat, &ESM::Variant::setFloat);
+                    case ESM::VT_String:
+                        return visitValue<std::string>(visitor, value, &ESM::Variant::getString,
+                            static_cast<void (ESM::Variant::*)(std::string&&)>(&ESM::Variant::setString));
+                    case ESM::VT_Unknown:
+                    case ESM::VT_None:
+                        return;
+                }
+                throw std::runtime_error("Invalid variant type: " + std::to_string(static_cast<int>(type)));
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const -> std::enable_if_t<isOneOf<T, ESM::ESM_Context>>
+            {
+                visitor(*this, value.filename);
+                visitor(*this, value.leftRec);
+                visitor(*this, value.leftSub);
+                visitor(*this, value.leftFile);
+                visitor(*this, value.recName.mData);
+                visitor(*this, value.subName.mData);
+                visitor(*this, value.index);
+                visitor(*this, value.parentFileIndices);
+                visitor(*this, value.subCached);
+                visitField<std::uint64_t>(visitor, value.filePos);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const -> std::enable_if_t<isOneOf<T, ESM::Activator>>
+            {
+                visitor(*this, value.mRecordFlags);
+                visitor(*this, value.mId);
+                visitor(*this, value.mScript);
+                visitor(*this, value.mName);
+                visitor(*this, value.mModel);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const -> std::enable_if_t<isOneOf<T, ESM::Cell>>
+            {
+                visitor(*this, value.mName);
+                visitor(*this, value.mRegion);
+                visitor(*this, value.mContextList);
+                visitor(*this, value.mData.mFlags);
+                visitor(*this, value.mData.mX);
+                visitor(*this, value.mData.mY);
+                visitor(*this, value.mCellId.mWorldspace);
+                visitor(*this, value.mCellId.mIndex.mX);
+                visitor(*this, value.mCellId.mIndex.mY);
+                visitor(*this, value.mCellId.mPaged);
+                visitor(*this, value.mAmbi.mAmbient);
+                visitor(*this, value.mAmbi.mSunlight);
+                visitor(*this, value.mAmbi.mFog);
+                visitor(*this, value.mAmbi.mFogDensity);
+                visitor(*this, value.mHasAmbi);
+                visitor(*this, value.mWater);
+                visitor(*this, value.mWaterInt);
+                visitor(*this, value.mMapColor);
+                visitor(*this, value.mRefNumCounter);
+                // mLeasedRefs and mMovedRefs are not filled by loadEsmData
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const -> std::enable_if_t<isOneOf<T, ESM::ContItem>>
+            {
+                visitor(*this, value.mCount);
+                visitor(*this, value.mItem);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const -> std::enable_if_t<isOneOf<T, ESM::Container>>
+            {
+                visitor(*this, value.mRecordFlags);
+                visitor(*this, value.mId);
+                visitor(*this, value.mScript);
+                visitor(*this, value.mName);
+                visitor(*this, value.mModel);
+                visitor(*this, value.mWeight);
+                visitor(*this, value.mFlags);
+                visitor(*this, value.mInventory.mList);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const -> std::enable_if_t<isOneOf<T, ESM::Door>>
+            {
+                visitor(*this, value.mRecordFlags);
+                visitor(*this, value.mId);
+                visitor(*this, value.mScript);
+                visitor(*this, value.mOpenSound);
+                visitor(*this, value.mCloseSound);
+                visitor(*this, value.mName);
+                visitor(*this, value.mModel);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const -> std::enable_if_t<isOneOf<T, ESM::GameSetting>>
+            {
+                visitor(*this, value.mRecordFlags);
+                visitor(*this, value.mId);
+                visitor(*this, value.mValue);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const -> std::enable_if_t<isOneOf<T, ESM::Land>>
+            {
+                visitor(*this, value.mFlags);
+                visitor(*this, value.mX);
+                visitor(*this, value.mY);
+                visitor(*this, value.mContext);
+                visitor(*this, value.mDataTypes);
+                visitor(*this, value.mWnam);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const -> std::enable_if_t<isOneOf<T, ESM::Static>>
+            {
+                visitor(*this, value.mRecordFlags);
+                visitor(*this, value.mId);
+                visitor(*this, value.mModel);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const -> std::enable_if_t<isOneOf<T, RefIdWithType>>
+            {
+                visitor(*this, value.mId);
+                visitField<std::uint32_t>(visitor, value.mType);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const -> std::enable_if_t<isOneOf<T, ContentFile>>
+            {
+                visitor(*this, value.mName);
+                visitor(*this, value.mHash.data(), value.mHash.size());
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const -> std::enable_if_t<isOneOf<T, CacheHeader>>
+            {
+                if constexpr (mode == Serialization::Mode::Write)
+                {
+                    visitor(*this, cacheMagic);
+                    visitor(*this, cacheVersion);
+                }
+                else
+                {
+                    static_assert(mode == Serialization::Mode::Read);
+                    char magic[std::size(cacheMagic)];
+                    visitor(*this, magic);
+                    if (std::memcmp(magic, cacheMagic, sizeof(magic)) != 0)
+                        throw std::runtime_error("Bad ESM data cache magic");
+                    std::uint32_t version = 0;
+                    visitor(*this, version);
+                    if (version != cacheVersion)
+                        throw std::runtime_error("Bad ESM data cache version");
+                }
+                visitor(*this, value.mQuery.mLoadActivators);
+                visitor(*this, value.mQuery.mLoadCells);
+                visitor(*this, value.mQuery.mLoadContainers);
+                visitor(*this, value.mQuery.mLoadDoors);
+                visitor(*this, value.mQuery.mLoadGameSettings);
+                visitor(*this, value.mQuery.mLoadLands);
+                visitor(*this, value.mQuery.mLoadStatics);
+                visitor(*this, value.mEncoding);
+                visitor(*this, value.mContentFiles);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const -> std::enable_if_t<isOneOf<T, EsmData>>
+            {
+                visitor(*this, value.mActivators);
+                visitor(*this, value.mCells);
+                visitor(*this, value.mContainers);
+                visitor(*this, value.mDoors);
+                visitor(*this, value.mGameSettings);
+                visitor(*this, value.mLands);
+                visitor(*this, value.mStatics);
+                visitor(*this, value.mRefIdTypes);
+            }
+
+        private:
+            // Stores value as type V independently from the platform specific type T
+            template <class V, class Visitor, class T>
+            void visitField(Visitor&& visitor, T& value) const
+            {
+                if constexpr (mode == Serialization::Mode::Write)
+                    visitor(*this, static_cast<V>(value));
+                else
+                {
+                    static_assert(mode == Serialization::Mode::Read);
+                    V stored{};
+                    visitor(*this, stored);
+                    value = static_cast<T>(stored);
+                }
+            }
+
+            template <class V, class Visitor, class T, class Getter, class Setter>
+            void visitValue(Visitor&& visitor, T& value, Getter getter, Setter setter) const
+            {
+                if constexpr (mode == Serialization::Mode::Write)
+                    visitor(*this, static_cast<V>((value.*getter)()));
+                else
+                {
+                    static_assert(mode == Serialization::Mode::Read);
+                    V stored{};
+                    visitor(*this, stored);
+                    (value.*setter)(std::move(stored));
+                }
+            }
+        };
+
+        // Utf8Encoder doesn't expose the code page, so the conversion result of all non-ASCII characters is used
+        // to detect encoding changes
+        std::string getEncoding(ToUTF8::Utf8Encoder* encoder)
+        {
+            if (encoder == nullptr)
+                return {};
+            std::string nonAscii;
+            for (int i = 0x80; i <= 0xff; ++i)
+                nonAscii.push_back(static_cast<char>(i));
+            return std::string(encoder->getUtf8(nonAscii));
+        }
+
+        CacheHeader makeHeader(const Query& query, const std::vector<std::string>& contentFiles,
+            const Files::Collections& fileCollections, ToUTF8::Utf8Encoder* encoder)
+        {
+            CacheHeader result;
+            result.mQuery = query;
+            result.mEncoding = getEncoding(encoder);
+            result.mContentFiles.reserve(contentFiles.size());
+
+            for (const std::string& file : contentFiles)
+            {
+                const std::string extension
+                    = Misc::StringUtils::lowerCase(Files::pathToUnicodeString(std::filesystem::path(file).extension()));
+                if (!isSupportedFormat(extension))
+                {
+                    result.mContentFiles.push_back(ContentFile{ file, {} });
+                    continue;
+                }
+                const std::filesystem::path path = fileCollections.getCollection(extension).getPath(file);
+                const auto stream = Files::openBinaryInputFileStream(path);
+                result.mContentFiles.push_back(ContentFile{ file, Files::getHash(path, *stream) });
+            }
+
+            return result;
+        }
+
+        std::optional<EsmData> readCache(const std::filesystem::path& path, const CacheHeader& expected)
+        {
+            if (!std::filesystem::exists(path))
+                return std::nullopt;
+
+            try
+            {
+                const Platform::File::MappedFile file(path);
+                const std::byte* const begin = reinterpret_cast<const std::byte*>(file.data());
+                Serialization::BinaryReader reader(begin, begin + file.size());
+                constexpr Format<Serialization::Mode::Read> format;
+
+                CacheHeader header;
+                format(reader, header);
+                if (!(header == expected))
+                {
+                    Log(Debug::Info) << "ESM data cache " << path << " is outdated";
+                    return std::nullopt;
+                }
+
+                EsmData result;
+                format(reader, result);
+                return result;
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to read ESM data cache " << path << ": " << e.what();
+                return std::nullopt;
+            }
+        }
+
+        void writeCache(const std::filesystem::path& path, const CacheHeader& header, const EsmData& data)
+        {
+            constexpr Format<Serialization::Mode::Write> format;
+            Serialization::SizeAccumulator sizeAccumulator;
+            format(sizeAccumulator, header);
+            format(sizeAccumulator, data);
+
+            std::vector<std::byte> buffer(sizeAccumulator.value());
+            Serialization::BinaryWriter writer(buffer.data(), buffer.data() + buffer.size());
+            format(writer, header);
+            format(writer, data);
+
+            // Write into a temporary file first to never leave a partially written cache
+            std::filesystem::path tempPath = path;
+            tempPath += ".tmp";
+            {
+                std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+                stream.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+                if (!stream)
+                    throw std::runtime_error("Failed to write " + Files::pathToUnicodeString(tempPath));
+            }
+            std::filesystem::rename(tempPath, path);
+        }
+
+        void openReaders(const std::vector<std::string>& contentFiles, const Files::Collections& fileCollections,
+            ESM::ReadersCache& readers, ToUTF8::Utf8Encoder* encoder)
+        {
+            for (std::size_t i = 0; i < contentFiles.size(); ++i)
+            {
+                const std::string& file = contentFiles[i];
+                const std::string extension
+                    = Misc::StringUtils::lowerCase(Files::pathToUnicodeString(std::filesystem::path(file).extension()));
+                if (!isSupportedFormat(extension))
+                    continue;
+                const ESM::ReadersCache::BusyItem reader = readers.get(i);
+                reader->setEncoder(encoder);
+                reader->setIndex(static_cast<int>(i));
+                reader->open(fileCollections.getCollection(extension).getPath(file));
+            }
+        }
+    }
+
+    EsmData loadCachedEsmData(const std::filesystem::path& cachePath, const Query& query,
+        const std::vector<std::string>& contentFiles, const Files::Collections& fileCollections,
+        ESM::ReadersCache& readers, ToUTF8::Utf8Encoder* encoder, Loading::Listener* listener,
+        std::size_t threadsNumber)
+    {
+        const CacheHeader header = makeHeader(query, contentFiles, fileCollections, encoder);
+
+        if (std::optional<EsmData> cached = readCache(cachePath, header))
+        {
+            Log(Debug::Info) << "Loaded ESM data from cache " << cachePath;
+            openReaders(contentFiles, fileCollections, readers, encoder);
+            return std::move(*cached);
+        }
+
+        EsmData result = loadEsmData(query, contentFiles, fileCollections, readers, encoder, listener, threadsNumber);
+
+        try
+        {
+            writeCache(cachePath, header, result);
+            Log(Debug::Info) << "ESM data cache is written to " << cachePath;
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write ESM data cache " << cachePath << ": " << e.what();
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,25 @@
+#ifndef OPENMW_COMPONENTS_ESMLOADER_CACHE_H
+#define OPENMW_COMPONENTS_ESMLOADER_CACHE_H
+
+#include "load.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace EsmLoader
+{
+    struct EsmData;
+
+    /// Same as loadEsmData but reuses the result stored in the cache file when the query, the content files list,
+    /// the content files themselves and the encoding are unchanged. Otherwise the data is loaded from the content
+    /// files and the cache file is rewritten.
+    /// @note Content file readers are still opened to make records contexts usable.
+    EsmData loadCachedEsmData(const std::filesystem::path& cachePath, const Query& query,
+        const std::vector<std::string>& contentFiles, const Files::Collections& fileCollections,
+        ESM::ReadersCache& readers, ToUTF8::Utf8Encoder* encoder, Loading::Listener* listener = nullptr,
+        std::size_t threadsNumber = 1);
+}
+
+#endif
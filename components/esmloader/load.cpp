@@ -20,15 +20,24 @@
 #include <components/loadinglistener/loadinglistener.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/strings/lower.hpp>
+#include <components/to_utf8/to_utf8.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <exception>
 #include <filesystem>
+#include <functional>
+#include <iterator>
+#include <limits>
 #include <map>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -61,6 +70,8 @@ namespace EsmLoader
             Records<ESM::Cell> mValues;
             std::map<std::string, std::size_t> mByName;
             std::map<std::pair<int, int>, std::size_t> mByPosition;
+            // Index in mValues and reader context at the beginning of each loaded record in the loading order
+            std::vector<std::pair<std::size_t, ESM::ESM_Context>> mRecords;
         };
 
         template <class T, class = std::void_t<>>
@@ -96,8 +107,15 @@ namespace EsmLoader
             records.emplace_back(deleted, std::move(record));
         }
 
+        void mergeCell(ESM::ESMReader& reader, const ESM::Cell& record, Record<ESM::Cell>& old)
+        {
+            old.mValue.mData = record.mData;
+            old.mValue.loadCell(reader, true);
+        }
+
         void loadRecord(ESM::ESMReader& reader, CellRecords& records)
         {
+            ESM::ESM_Context context = reader.getContext();
             ESM::Cell record;
             bool deleted = false;
             record.loadNameAndData(reader, deleted);
@@ -108,14 +126,14 @@ namespace EsmLoader
                 if (it == records.mByName.end())
                 {
                     record.loadCell(reader, true);
+                    records.mRecords.emplace_back(records.mValues.size(), std::move(context));
                     records.mByName.emplace_hint(it, record.mName, records.mValues.size());
                     records.mValues.emplace_back(deleted, std::move(record));
                 }
                 else
                 {
-                    Record<ESM::Cell>& old = records.mValues[it->second];
-                    old.mValue.mData = record.mData;
-                    old.mValue.loadCell(reader, true);
+                    records.mRecords.emplace_back(it->second, std::move(context));
+                    mergeCell(reader, record, records.mValues[it->second]);
                 }
             }
             else
@@ -125,14 +143,14 @@ namespace EsmLoader
                 if (it == records.mByPosition.end())
                 {
                     record.loadCell(reader, true);
+                    records.mRecords.emplace_back(records.mValues.size(), std::move(context));
                     records.mByPosition.emplace_hint(it, position, records.mValues.size());
                     records.mValues.emplace_back(deleted, std::move(record));
                 }
                 else
                 {
-                    Record<ESM::Cell>& old = records.mValues[it->second];
-                    old.mValue.mData = record.mData;
-                    old.mValue.loadCell(reader, true);
+                    records.mRecords.emplace_back(it->second, std::move(context));
+                    mergeCell(reader, record, records.mValues[it->second]);
                 }
             }
         }
@@ -205,27 +223,157 @@ namespace EsmLoader
             }
         }
 
-        ShallowContent shallowLoad(const Query& query, const std::vector<std::string>& contentFiles,
-            const Files::Collections& fileCollections, ESM::ReadersCache& readers, ToUTF8::Utf8Encoder* encoder,
-            Loading::Listener* listener)
+        template <class T>
+        void mergeRecords(Records<T>& from, Records<T>& to)
+        {
+            to.insert(to.end(), std::make_move_iterator(from.begin()), std::make_move_iterator(from.end()));
+        }
+
+        // Gives the same result as loading all cell records of the file with the same reader into the result
+        void mergeCellRecords(ESM::ESMReader& reader, CellRecords& from, CellRecords& to)
+        {
+            constexpr std::size_t added = std::numeric_limits<std::size_t>::max();
+
+            std::vector<std::size_t> targets;
+            targets.reserve(from.mValues.size());
+
+            for (Record<ESM::Cell>& value : from.mValues)
+            {
+                const ESM::Cell& cell = value.mValue;
+                std::size_t target = added;
+                if ((cell.mData.mFlags & ESM::Cell::Interior) != 0)
+                {
+                    const auto [it, inserted] = to.mByName.emplace(cell.mName, to.mValues.size());
+                    if (!inserted)
+                        target = it->second;
+                }
+                else
+                {
+                    const std::pair<int, int> position(cell.mData.mX, cell.mData.mY);
+                    const auto [it, inserted] = to.mByPosition.emplace(position, to.mValues.size());
+                    if (!inserted)
+                        target = it->second;
+                }
+                if (target == added)
+                    to.mValues.push_back(std::move(value));
+                targets.push_back(target);
+            }
+
+            // Records overriding cells from the previous files are loaded again on top of the existing values
+            for (auto& [index, context] : from.mRecords)
+            {
+                const std::size_t target = targets[index];
+                if (target == added)
+                    continue;
+                reader.restoreContext(context);
+                ESM::Cell record;
+                bool deleted = false;
+                record.loadNameAndData(reader, deleted);
+                mergeCell(reader, record, to.mValues[target]);
+            }
+        }
+
+        void mergeContent(ESM::ESMReader& reader, ShallowContent& from, ShallowContent& to)
+        {
+            mergeRecords(from.mActivators, to.mActivators);
+            mergeCellRecords(reader, from.mCells, to.mCells);
+            mergeRecords(from.mContainers, to.mContainers);
+            mergeRecords(from.mDoors, to.mDoors);
+            mergeRecords(from.mGameSettings, to.mGameSettings);
+            mergeRecords(from.mLands, to.mLands);
+            mergeRecords(from.mStatics, to.mStatics);
+        }
+
+        struct PendingFile
+        {
+            std::size_t mIndex;
+            ESM::ESM_Context mContext;
+        };
+
+        ShallowContent loadFile(const Query& query, const PendingFile& file, ToUTF8::Utf8Encoder* encoder)
         {
+            // Utf8Encoder is not thread-safe so each file gets own one
+            std::optional<ToUTF8::Utf8Encoder> fileEncoder;
+            ESM::ESMReader reader;
+            if (encoder != nullptr)
+                reader.setEncoder(&fileEncoder.emplace(encoder->getStatelessEncoder()));
+            reader.open(file.mContext.filename);
+            reader.restoreContext(file.mContext);
+
             ShallowContent result;
+            loadEsm(query, reader, result, nullptr);
+            return result;
+        }
 
-            const std::set<std::string> supportedFormats{
-                ".esm",
-                ".esp",
-                ".omwgame",
-                ".omwaddon",
-                ".project",
+        void loadInParallel(const Query& query, const std::vector<PendingFile>& files, ESM::ReadersCache& readers,
+            ToUTF8::Utf8Encoder* encoder, Loading::Listener* listener, std::size_t threadsNumber,
+            ShallowContent& result)
+        {
+            std::vector<ShallowContent> contents(files.size());
+            std::atomic_size_t next{ 0 };
+            std::atomic_size_t loaded{ 0 };
+            std::mutex errorMutex;
+            std::exception_ptr error;
+
+            if (listener != nullptr)
+                listener->setProgressRange(files.size());
+
+            // Only the calling thread reports progress
+            const auto work = [&](Loading::Listener* workerListener) {
+                try
+                {
+                    for (std::size_t i = next++; i < files.size(); i = next++)
+                    {
+                        contents[i] = loadFile(query, files[i], encoder);
+                        ++loaded;
+                        if (workerListener != nullptr)
+                            workerListener->setProgress(loaded);
+                    }
+                }
+                catch (...)
+                {
+                    next = files.size();
+                    const std::lock_guard lock(errorMutex);
+                    if (error == nullptr)
+                        error = std::current_exception();
+                }
             };
 
+            std::vector<std::thread> workers;
+            const std::size_t threadsCount = std::min(threadsNumber, files.size());
+            for (std::size_t i = 1; i < threadsCount; ++i)
+                workers.emplace_back(work, nullptr);
+
+            work(listener);
+
+            for (std::thread& worker : workers)
+                worker.join();
+
+            if (error != nullptr)
+                std::rethrow_exception(error);
+
+            for (std::size_t i = 0; i < files.size(); ++i)
+            {
+                const ESM::ReadersCache::BusyItem reader = readers.get(files[i].mIndex);
+                mergeContent(*reader, contents[i], result);
+                contents[i] = ShallowContent();
+            }
+        }
+
+        ShallowContent shallowLoad(const Query& query, const std::vector<std::string>& contentFiles,
+            const Files::Collections& fileCollections, ESM::ReadersCache& readers, ToUTF8::Utf8Encoder* encoder,
+            Loading::Listener* listener, std::size_t threadsNumber)
+        {
+            ShallowContent result;
+            std::vector<PendingFile> pendingFiles;
+
             for (std::size_t i = 0; i < contentFiles.size(); ++i)
             {
                 const std::string& file = contentFiles[i];
                 const std::string extension
                     = Misc::StringUtils::lowerCase(Files::pathToUnicodeString(std::filesystem::path(file).extension()));
 
-                if (supportedFormats.find(extension) == supportedFormats.end())
+                if (!isSupportedFormat(extension))
                 {
                     Log(Debug::Warning) << "Skipping unsupported content file: " << file;
                     continue;
@@ -246,9 +394,19 @@ namespace EsmLoader
                 if (query.mLoadCells)
                     reader->resolveParentFileIndices(readers);
 
+                // Records are loaded later by worker threads starting from the same reader state
+                if (threadsNumber > 1)
+                {
+                    pendingFiles.push_back(PendingFile{ i, reader->getContext() });
+                    continue;
+                }
+
                 loadEsm(query, *reader, result, listener);
             }
 
+            if (!pendingFiles.empty())
+                loadInParallel(query, pendingFiles, readers, encoder, listener, threadsNumber, result);
+
             return result;
         }
 
@@ -293,13 +451,27 @@ namespace EsmLoader
         }
     }
 
+    bool isSupportedFormat(std::string_view extension)
+    {
+        static const std::set<std::string, std::less<>> supportedFormats{
+            ".esm",
+            ".esp",
+            ".omwgame",
+            ".omwaddon",
+            ".project",
+        };
+
+        return supportedFormats.find(extension) != supportedFormats.end();
+    }
+
     EsmData loadEsmData(const Query& query, const std::vector<std::string>& contentFiles,
         const Files::Collections& fileCollections, ESM::ReadersCache& readers, ToUTF8::Utf8Encoder* encoder,
-        Loading::Listener* listener)
+        Loading::Listener* listener, std::size_t threadsNumber)
     {
         Log(Debug::Info) << "Loading ESM data...";
 
-        ShallowContent content = shallowLoad(query, contentFiles, fileCollections, readers, encoder, listener);
+        ShallowContent content
+            = shallowLoad(query, contentFiles, fileCollections, readers, encoder, listener, threadsNumber);
 
         std::ostringstream loaded;
 
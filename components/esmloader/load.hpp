@@ -3,7 +3,9 @@
 
 #include <components/esm3/esmreader.hpp>
 
+#include <cstddef>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace ToUTF8
@@ -38,9 +40,14 @@ namespace EsmLoader
         bool mLoadStatics = false;
     };
 
+    /// @param extension lower case content file extension including the dot
+    bool isSupportedFormat(std::string_view extension);
+
+    /// Content files are parsed by threadsNumber threads into separate staging storages which are merged in the load
+    /// order, so the result doesn't depend on the threads number.
     EsmData loadEsmData(const Query& query, const std::vector<std::string>& contentFiles,
         const Files::Collections& fileCollections, ESM::ReadersCache& readers, ToUTF8::Utf8Encoder* encoder,
-        Loading::Listener* listener = nullptr);
+        Loading::Listener* listener = nullptr, std::size_t threadsNumber = 1);
 }
 
 #endif
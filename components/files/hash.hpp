@@ -5,10 +5,14 @@
 #include <cstdint>
 #include <filesystem>
 #include <iosfwd>
+#include <string_view>
 
 namespace Files
 {
     std::array<std::uint64_t, 2> getHash(const std::filesystem::path& fileName, std::istream& stream);
+
+    /// Gives the same result as getHash for a stream with the given content.
+    std::array<std::uint64_t, 2> getHash(std::string_view content);
 }
 
 #endif
@@ -2,6 +2,7 @@
 #define OPENMW_COMPONENTS_FILES_MEMORYSTREAM_H
 
 #include <istream>
+#include <string_view>
 
 namespace Files
 {
@@ -31,6 +32,12 @@ namespace Files
             return seekoff(pos, std::ios_base::beg, which);
         }
 
+        /// Not yet read part of the buffer
+        std::string_view getUnread() const
+        {
+            return std::string_view(gptr(), static_cast<std::size_t>(egptr() - gptr()));
+        }
+
     protected:
         char* bufferStart;
         char* bufferEnd;
@@ -0,0 +1,40 @@
+#ifndef OPENMW_COMPONENTS_INTERPRETER_DECODEDPROGRAM_H
+#define OPENMW_COMPONENTS_INTERPRETER_DECODEDPROGRAM_H
+
+#include "types.hpp"
+
+#include <vector>
+
+namespace Interpreter
+{
+    class Opcode0;
+    class Opcode1;
+
+    /// Instruction with the segment and opcode already resolved to a handler.
+    struct DecodedInstruction
+    {
+        enum class Type
+        {
+            Opcode0,
+            Opcode1,
+            Jump, ///< Unconditional jump to mTarget
+            Invalid, ///< Unknown opcode or segment, reported only when executed
+        };
+
+        Type mType = Type::Invalid;
+        Opcode0* mOpcode0 = nullptr;
+        Opcode1* mOpcode1 = nullptr;
+        unsigned int mArg0 = 0;
+        int mTarget = 0;
+        Type_Code mCode = 0;
+    };
+
+    /// Pre-decoded form of a Program. Produced by Interpreter::decode and only valid for the interpreter that
+    /// produced it as long as no opcodes are installed into it.
+    struct DecodedProgram
+    {
+        std::vector<DecodedInstruction> mInstructions;
+    };
+}
+
+#endif
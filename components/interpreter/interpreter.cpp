@@ -4,6 +4,7 @@
 #include <stdexcept>
 #include <string>
 
+#include "controlopcodes.hpp"
 #include "opcodes.hpp"
 #include "program.hpp"
 
@@ -21,61 +22,136 @@ namespace Interpreter
         throw std::runtime_error(error);
     }
 
-    template <typename T>
-    auto& getDispatcher(const T& segment, unsigned int seg, int opcode)
+    static bool splitCode(Type_Code code, int& segment, int& opcode, unsigned int& arg0)
     {
-        auto it = segment.find(opcode);
-        if (it == segment.end())
+        switch (code >> 30)
         {
-            abortUnknownCode(seg, opcode);
+            case 0:
+                segment = 0;
+                opcode = code >> 24;
+                arg0 = code & 0xffffff;
+                return true;
+
+            case 2:
+                segment = 2;
+                opcode = (code >> 20) & 0x3ff;
+                arg0 = code & 0xfffff;
+                return true;
         }
-        return it->second;
+
+        switch (code >> 26)
+        {
+            case 0x30:
+                segment = 3;
+                opcode = (code >> 8) & 0x3ffff;
+                arg0 = code & 0xff;
+                return true;
+
+            case 0x32:
+                segment = 5;
+                opcode = code & 0x3ffffff;
+                arg0 = 0;
+                return true;
+        }
+
+        return false;
     }
 
-    void Interpreter::execute(Type_Code code)
+    [[noreturn]] static void abortInvalidCode(Type_Code code)
     {
-        unsigned int segSpec = code >> 30;
+        int segment = 0;
+        int opcode = 0;
+        unsigned int arg0 = 0;
 
-        switch (segSpec)
-        {
-            case 0:
-            {
-                const int opcode = code >> 24;
-                const unsigned int arg0 = code & 0xffffff;
+        if (!splitCode(code, segment, opcode, arg0))
+            abortUnknownSegment(code);
 
-                return getDispatcher(mSegment0, 0, opcode)->execute(mRuntime, arg0);
-            }
+        abortUnknownCode(segment, opcode);
+    }
 
-            case 2:
-            {
-                const int opcode = (code >> 20) & 0x3ff;
-                const unsigned int arg0 = code & 0xfffff;
+    DecodedInstruction Interpreter::decode(Type_Code code) const
+    {
+        DecodedInstruction result;
+        result.mCode = code;
 
-                return getDispatcher(mSegment2, 2, opcode)->execute(mRuntime, arg0);
-            }
+        int segment = 0;
+        int opcode = 0;
+
+        if (!splitCode(code, segment, opcode, result.mArg0))
+            return result;
+
+        switch (segment)
+        {
+            case 0:
+                result.mOpcode1 = mSegment0.find(opcode);
+                break;
+            case 2:
+                result.mOpcode1 = mSegment2.find(opcode);
+                break;
+            case 3:
+                result.mOpcode1 = mSegment3.find(opcode);
+                break;
+            case 5:
+                result.mOpcode0 = mSegment5.find(opcode);
+                break;
         }
 
-        segSpec = code >> 26;
+        if (result.mOpcode0 != nullptr)
+            result.mType = DecodedInstruction::Type::Opcode0;
+        else if (result.mOpcode1 != nullptr)
+            result.mType = DecodedInstruction::Type::Opcode1;
+
+        return result;
+    }
+
+    DecodedProgram Interpreter::decode(const Program& program) const
+    {
+        DecodedProgram result;
+        result.mInstructions.reserve(program.mInstructions.size());
 
-        switch (segSpec)
+        for (std::size_t i = 0; i < program.mInstructions.size(); ++i)
         {
-            case 0x30:
-            {
-                const int opcode = (code >> 8) & 0x3ffff;
-                const unsigned int arg0 = code & 0xff;
+            DecodedInstruction instruction = decode(program.mInstructions[i]);
 
-                return getDispatcher(mSegment3, 3, opcode)->execute(mRuntime, arg0);
+            // Jumps with zero distance are left to the opcode, so they still report an infinite loop when executed
+            if (instruction.mType == DecodedInstruction::Type::Opcode1 && instruction.mArg0 != 0)
+            {
+                const int pc = static_cast<int>(i);
+                const int distance = static_cast<int>(instruction.mArg0);
+
+                if (dynamic_cast<OpJumpForward*>(instruction.mOpcode1) != nullptr)
+                {
+                    instruction.mType = DecodedInstruction::Type::Jump;
+                    instruction.mTarget = pc + distance;
+                }
+                else if (dynamic_cast<OpJumpBackward*>(instruction.mOpcode1) != nullptr)
+                {
+                    instruction.mType = DecodedInstruction::Type::Jump;
+                    instruction.mTarget = pc - distance;
+                }
             }
 
-            case 0x32:
-            {
-                const int opcode = code & 0x3ffffff;
+            result.mInstructions.push_back(instruction);
+        }
 
-                return getDispatcher(mSegment5, 5, opcode)->execute(mRuntime);
-            }
+        return result;
+    }
+
+    void Interpreter::execute(const DecodedInstruction& instruction)
+    {
+        switch (instruction.mType)
+        {
+            case DecodedInstruction::Type::Opcode0:
+                return instruction.mOpcode0->execute(mRuntime);
+            case DecodedInstruction::Type::Opcode1:
+                return instruction.mOpcode1->execute(mRuntime, instruction.mArg0);
+            case DecodedInstruction::Type::Jump:
+                return mRuntime.setPC(instruction.mTarget);
+            case DecodedInstruction::Type::Invalid:
+                break;
         }
 
-        abortUnknownSegment(code);
+        abortInvalidCode(instruction.mCode);
     }
 
     void Interpreter::begin()
@@ -107,15 +183,24 @@ namespace Interpreter
 
     void Interpreter::run(const Program& program, Context& context)
     {
+        run(program, decode(program), context);
+    }
+
+    void Interpreter::run(const Program& program, const DecodedProgram& decoded, Context& context)
+    {
+        assert(program.mInstructions.size() == decoded.mInstructions.size());
+
         begin();
 
         try
         {
             mRuntime.configure(program, context);
 
-            while (mRuntime.getPC() >= 0 && static_cast<std::size_t>(mRuntime.getPC()) < program.mInstructions.size())
+            const int size = static_cast<int>(decoded.mInstructions.size());
+
+            while (mRuntime.getPC() >= 0 && mRuntime.getPC() < size)
             {
-                const Type_Code instruction = program.mInstructions[mRuntime.getPC()];
+                const DecodedInstruction& instruction = decoded.mInstructions[mRuntime.getPC()];
                 mRuntime.setPC(mRuntime.getPC() + 1);
                 execute(instruction);
             }
@@ -1,14 +1,14 @@
 #ifndef INTERPRETER_INTERPRETER_H_INCLUDED
 #define INTERPRETER_INTERPRETER_H_INCLUDED
 
-#include <cassert>
-#include <map>
 #include <memory>
 #include <stack>
 #include <utility>
 
 #include "components/interpreter/program.hpp"
+#include "decodedprogram.hpp"
 #include "opcodes.hpp"
+#include "opcodetable.hpp"
 #include "runtime.hpp"
 #include "types.hpp"
 
@@ -21,12 +21,14 @@ namespace Interpreter
         std::stack<Runtime> mCallstack;
         bool mRunning = false;
         Runtime mRuntime;
-        std::map<int, std::unique_ptr<Opcode1>> mSegment0;
-        std::map<int, std::unique_ptr<Opcode1>> mSegment2;
-        std::map<int, std::unique_ptr<Opcode1>> mSegment3;
-        std::map<int, std::unique_ptr<Opcode0>> mSegment5;
+        OpcodeTable<Opcode1> mSegment0;
+        OpcodeTable<Opcode1> mSegment2;
+        OpcodeTable<Opcode1> mSegment3;
+        OpcodeTable<Opcode0> mSegment5;
 
-        void execute(Type_Code code);
+        DecodedInstruction decode(Type_Code code) const;
+
+        void execute(const DecodedInstruction& instruction);
 
         void begin();
 
@@ -35,8 +37,7 @@ namespace Interpreter
         template <typename TSeg, typename TOp>
         void installSegment(TSeg& seg, int code, TOp&& op)
         {
-            assert(seg.find(code) == seg.end());
-            seg.emplace(code, std::move(op));
+            seg.insert(code, std::move(op));
         }
 
     public:
@@ -69,7 +70,14 @@ namespace Interpreter
             installSegment(mSegment5, code, std::make_unique<T>(std::forward<TArgs>(args)...));
         }
 
+        DecodedProgram decode(const Program& program) const;
+        ///< Resolve opcode handlers and jump targets once, so the program can be executed repeatedly without
+        /// decoding each instruction again.
+
         void run(const Program& program, Context& context);
+
+        void run(const Program& program, const DecodedProgram& decoded, Context& context);
+        ///< \a decoded must be produced by decode from \a program by this interpreter.
     };
 }
 
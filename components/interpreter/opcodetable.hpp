@@ -0,0 +1,77 @@
+#ifndef OPENMW_COMPONENTS_INTERPRETER_OPCODETABLE_H
+#define OPENMW_COMPONENTS_INTERPRETER_OPCODETABLE_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Interpreter
+{
+    /// @brief Maps opcodes of a segment to their implementations.
+    /// @par Opcodes are clustered into a few contiguous ranges (e.g. generic ones starting from 0 and extensions
+    /// starting from 0x2000000), so each range is stored as a dense array and a lookup is a range check plus indexing.
+    template <class T>
+    class OpcodeTable
+    {
+    public:
+        void insert(int code, std::unique_ptr<T>&& opcode)
+        {
+            assert(code >= 0);
+            assert(find(code) == nullptr);
+
+            auto range = std::find_if(mRanges.begin(), mRanges.end(), [&](const Range& v) {
+                return code >= v.mBase - sMaxGap && code < v.mBase + static_cast<int>(v.mOpcodes.size()) + sMaxGap;
+            });
+
+            if (range == mRanges.end())
+                range = mRanges.insert(mRanges.end(), Range{ code, {} });
+
+            if (code < range->mBase)
+            {
+                const auto shift = static_cast<std::size_t>(range->mBase - code);
+                std::vector<std::unique_ptr<T>> opcodes(range->mOpcodes.size() + shift);
+                std::move(range->mOpcodes.begin(), range->mOpcodes.end(), opcodes.begin() + shift);
+                range->mOpcodes = std::move(opcodes);
+                range->mBase = code;
+            }
+
+            const auto index = static_cast<std::size_t>(code - range->mBase);
+            if (index >= range->mOpcodes.size())
+                range->mOpcodes.resize(index + 1);
+
+            range->mOpcodes[index] = std::move(opcode);
+
+            // Bigger ranges are likely to contain more frequently used opcodes
+            std::stable_sort(mRanges.begin(), mRanges.end(),
+                [](const Range& l, const Range& r) { return l.mOpcodes.size() > r.mOpcodes.size(); });
+        }
+
+        T* find(int code) const
+        {
+            for (const Range& range : mRanges)
+            {
+                // Negative difference turns into a large unsigned value failing the size check
+                const auto index = static_cast<std::size_t>(static_cast<unsigned>(code - range.mBase));
+                if (index < range.mOpcodes.size())
+                    return range.mOpcodes[index].get();
+            }
+            return nullptr;
+        }
+
+    private:
+        static constexpr int sMaxGap = 256;
+
+        struct Range
+        {
+            int mBase;
+            std::vector<std::unique_ptr<T>> mOpcodes;
+        };
+
+        std::vector<Range> mRanges;
+    };
+}
+
+#endif
@@ -10,6 +10,7 @@ namespace l10n
 
     void Manager::setPreferredLocales(const std::vector<std::string>& langs)
     {
+        std::lock_guard lock(mMutex);
         mPreferredLocales.clear();
         for (const auto& lang : langs)
             mPreferredLocales.push_back(icu::Locale(lang.c_str()));
@@ -70,6 +71,7 @@ namespace l10n
         const std::string& contextName, const std::string& fallbackLocaleName)
     {
         std::pair<std::string, std::string> key(contextName, fallbackLocaleName);
+        std::lock_guard lock(mMutex);
         auto it = mCache.find(key);
         if (it != mCache.end())
             return it->second;
@@ -2,6 +2,7 @@
 #define COMPONENTS_L10N_MANAGER_H
 
 #include <memory>
+#include <mutex>
 
 #include <components/l10n/messagebundles.hpp>
 
@@ -21,7 +22,11 @@ namespace l10n
         {
         }
 
-        void dropCache() { mCache.clear(); }
+        void dropCache()
+        {
+            std::lock_guard lock(mMutex);
+            mCache.clear();
+        }
         void setPreferredLocales(const std::vector<std::string>& locales);
         const std::vector<icu::Locale>& getPreferredLocales() const { return mPreferredLocales; }
 
@@ -35,6 +40,8 @@ namespace l10n
         const VFS::Manager* mVFS;
         std::vector<icu::Locale> mPreferredLocales;
         std::map<std::pair<std::string, std::string>, std::shared_ptr<MessageBundles>> mCache;
+        // Contexts can be requested by Lua scripts running in several threads.
+        std::mutex mMutex;
     };
 
 }
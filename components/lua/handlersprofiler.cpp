@@ -0,0 +1,105 @@
+#include "handlersprofiler.hpp"
+
+#include <algorithm>
+
+#include "configuration.hpp"
+
+namespace LuaUtil
+{
+    namespace
+    {
+        constexpr double frameTimeAvgCoef = 1.0 / 30; // averaging over approximately 30 frames
+    }
+
+    void HandlersProfiler::add(
+        int scriptId, HandlerType type, std::string_view name, std::chrono::steady_clock::duration time)
+    {
+        std::lock_guard lock(mMutex);
+        auto it = mRecords.find(KeyView{ scriptId, type, name });
+        if (it == mRecords.end())
+            it = mRecords.emplace(Key{ scriptId, type, std::string(name) }, Record{}).first;
+        ++it->second.mCurrentFrameCalls;
+        it->second.mCurrentFrameTime += time;
+    }
+
+    void HandlersProfiler::nextFrame()
+    {
+        std::lock_guard lock(mMutex);
+        mFrameCalls = 0;
+        mFrameTime = {};
+        for (auto& [key, record] : mRecords)
+        {
+            // The averaging formula is: averageValue = averageValue * (1-c) + newValue * c
+            const double frameTime = std::chrono::duration<double>(record.mCurrentFrameTime).count();
+            record.mAvgFrameTime = record.mAvgFrameTime * (1 - frameTimeAvgCoef) + frameTime * frameTimeAvgCoef;
+            record.mFrameCalls = record.mCurrentFrameCalls;
+            record.mFrameTime = record.mCurrentFrameTime;
+            record.mTotalCalls += record.mCurrentFrameCalls;
+            record.mTotalTime += record.mCurrentFrameTime;
+            record.mCurrentFrameCalls = 0;
+            record.mCurrentFrameTime = {};
+            mFrameCalls += record.mFrameCalls;
+            mFrameTime += record.mFrameTime;
+        }
+    }
+
+    std::vector<HandlersProfiler::HandlerStats> HandlersProfiler::getStats() const
+    {
+        std::vector<HandlerStats> result;
+        {
+            std::lock_guard lock(mMutex);
+            result.reserve(mRecords.size());
+            for (const auto& [key, record] : mRecords)
+                result.push_back(HandlerStats{ key.mScriptId, key.mType, key.mName, record.mAvgFrameTime,
+                    record.mFrameCalls, record.mFrameTime, record.mTotalCalls, record.mTotalTime });
+        }
+        std::stable_sort(result.begin(), result.end(),
+            [](const HandlerStats& l, const HandlerStats& r) { return l.mAvgFrameTime > r.mAvgFrameTime; });
+        return result;
+    }
+
+    std::chrono::steady_clock::duration HandlersProfiler::getFrameTime() const
+    {
+        std::lock_guard lock(mMutex);
+        return mFrameTime;
+    }
+
+    std::uint64_t HandlersProfiler::getFrameCalls() const
+    {
+        std::lock_guard lock(mMutex);
+        return mFrameCalls;
+    }
+
+    void HandlersProfiler::writeCollapsedStacks(const ScriptsConfiguration& configuration, std::ostream& stream) const
+    {
+        std::lock_guard lock(mMutex);
+        for (const auto& [key, record] : mRecords)
+        {
+            const auto time = std::chrono::duration_cast<std::chrono::microseconds>(record.mTotalTime);
+            if (time.count() == 0)
+                continue;
+            if (key.mScriptId >= 0 && static_cast<std::size_t>(key.mScriptId) < configuration.size())
+                stream << configuration[key.mScriptId].mScriptPath;
+            else
+                stream << "script#" << key.mScriptId;
+            stream << ';';
+            if (key.mType != HandlerType::Engine)
+                stream << getHandlerTypeName(key.mType) << ':';
+            stream << key.mName << ' ' << time.count() << '\n';
+        }
+    }
+
+    std::string_view getHandlerTypeName(HandlersProfiler::HandlerType type)
+    {
+        switch (type)
+        {
+            case HandlersProfiler::HandlerType::Engine:
+                return "engine";
+            case HandlersProfiler::HandlerType::Event:
+                return "event";
+            case HandlersProfiler::HandlerType::Timer:
+                return "timer";
+        }
+        return "unknown";
+    }
+}
@@ -0,0 +1,139 @@
+#ifndef COMPONENTS_LUA_HANDLERSPROFILER_H
+#define COMPONENTS_LUA_HANDLERSPROFILER_H
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace LuaUtil
+{
+    class ScriptsConfiguration;
+
+    // Measures wall time spent in Lua handlers per script and handler. Time is aggregated over all instances of each
+    // script. Handlers are expected to be called from a single thread, results can be read from any thread.
+    class HandlersProfiler
+    {
+    public:
+        enum class HandlerType
+        {
+            Engine,
+            Event,
+            Timer,
+        };
+
+        struct HandlerStats
+        {
+            int mScriptId;
+            HandlerType mType;
+            std::string mName;
+            double mAvgFrameTime = 0; // seconds, averaged over approximately 30 frames
+            std::uint64_t mFrameCalls = 0; // in the last frame
+            std::chrono::steady_clock::duration mFrameTime{}; // in the last frame
+            std::uint64_t mTotalCalls = 0;
+            std::chrono::steady_clock::duration mTotalTime{};
+        };
+
+        // Measures time from construction to destruction. Does nothing if the profiler is null.
+        class Scope
+        {
+        public:
+            Scope(HandlersProfiler* profiler, int scriptId, HandlerType type, std::string_view name)
+                : mProfiler(profiler)
+                , mScriptId(scriptId)
+                , mType(type)
+                , mName(name)
+            {
+                if (mProfiler != nullptr)
+                    mStart = std::chrono::steady_clock::now();
+            }
+
+            ~Scope()
+            {
+                if (mProfiler != nullptr)
+                    mProfiler->add(mScriptId, mType, mName, std::chrono::steady_clock::now() - mStart);
+            }
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            HandlersProfiler* mProfiler;
+            int mScriptId;
+            HandlerType mType;
+            std::string_view mName;
+            std::chrono::steady_clock::time_point mStart;
+        };
+
+        void add(int scriptId, HandlerType type, std::string_view name, std::chrono::steady_clock::duration time);
+
+        // Finishes the current frame, time of this frame is added to the averaged and total values.
+        void nextFrame();
+
+        // Returns stats for every measured handler sorted by averaged time per frame, the slowest first.
+        std::vector<HandlerStats> getStats() const;
+
+        // Total time spent in all handlers during the last frame.
+        std::chrono::steady_clock::duration getFrameTime() const;
+
+        std::uint64_t getFrameCalls() const;
+
+        // Writes total time per script and handler in the collapsed stack format ("script;handler microseconds" per
+        // line) accepted by flame graph tools.
+        void writeCollapsedStacks(const ScriptsConfiguration& configuration, std::ostream& stream) const;
+
+    private:
+        struct Key
+        {
+            int mScriptId;
+            HandlerType mType;
+            std::string mName;
+        };
+
+        struct KeyView
+        {
+            int mScriptId;
+            HandlerType mType;
+            std::string_view mName;
+        };
+
+        struct Less
+        {
+            using is_transparent = void;
+
+            template <class L, class R>
+            bool operator()(const L& l, const R& r) const
+            {
+                if (l.mScriptId != r.mScriptId)
+                    return l.mScriptId < r.mScriptId;
+                if (l.mType != r.mType)
+                    return l.mType < r.mType;
+                return std::string_view(l.mName) < std::string_view(r.mName);
+            }
+        };
+
+        struct Record
+        {
+            double mAvgFrameTime = 0;
+            std::uint64_t mCurrentFrameCalls = 0;
+            std::chrono::steady_clock::duration mCurrentFrameTime{};
+            std::uint64_t mFrameCalls = 0;
+            std::chrono::steady_clock::duration mFrameTime{};
+            std::uint64_t mTotalCalls = 0;
+            std::chrono::steady_clock::duration mTotalTime{};
+        };
+
+        mutable std::mutex mMutex;
+        std::map<Key, Record, Less> mRecords;
+        std::uint64_t mFrameCalls = 0;
+        std::chrono::steady_clock::duration mFrameTime{};
+    };
+
+    std::string_view getHandlerTypeName(HandlersProfiler::HandlerType type);
+}
+
+#endif // COMPONENTS_LUA_HANDLERSPROFILER_H
@@ -172,6 +172,9 @@ namespace LuaUtil
         if (sProfilerEnabled)
             lua_sethook(mLuaHolder.get(), &countHook, LUA_MASKCOUNT, countHookStep);
 
+        if (mSettings.mProfileHandlers)
+            mHandlersProfiler = std::make_unique<HandlersProfiler>();
+
         mSol.open_libraries(sol::lib::base, sol::lib::coroutine, sol::lib::math, sol::lib::bit32, sol::lib::string,
             sol::lib::table, sol::lib::os, sol::lib::debug);
 
@@ -6,8 +6,10 @@
 #include <sol/sol.hpp>
 
 #include <filesystem>
+#include <memory>
 
 #include "configuration.hpp"
+#include "handlersprofiler.hpp"
 
 namespace VFS
 {
@@ -32,6 +34,7 @@ namespace LuaUtil
         uint64_t mMemoryLimit = 0; // 0 is unlimited
         uint64_t mSmallAllocMaxSize = 1024 * 1024; // big default value efficiently disables memory tracking
         bool mLogMemoryUsage = false;
+        bool mProfileHandlers = false; // measure time spent in engine handlers, event handlers and timers
     };
 
     // Holds Lua state.
@@ -112,6 +115,10 @@ namespace LuaUtil
 
         const LuaStateSettings& getSettings() const { return mSettings; }
 
+        // Returns nullptr if handlers profiling is disabled.
+        HandlersProfiler* getHandlersProfiler() { return mHandlersProfiler.get(); }
+        const HandlersProfiler* getHandlersProfiler() const { return mHandlersProfiler.get(); }
+
         // Note: Lua profiler can not be re-enabled after disabling.
         static void disableProfiler() { sProfilerEnabled = false; }
         static bool isProfilerEnabled() { return sProfilerEnabled; }
@@ -145,6 +152,7 @@ namespace LuaUtil
         uint64_t mTotalMemoryUsage = 0;
         uint64_t mSmallAllocMemoryUsage = 0;
         std::vector<int64_t> mMemoryUsage;
+        std::unique_ptr<HandlersProfiler> mHandlersProfiler;
 
         class LuaStateHolder
         {
@@ -15,6 +15,9 @@ namespace LuaUtil
     static constexpr std::string_view HANDLER_LOAD = "onLoad";
     static constexpr std::string_view HANDLER_INTERFACE_OVERRIDE = "onInterfaceOverride";
 
+    // Timers with time in the same 1/16 of a second (simulation time or game time) are in the same bucket.
+    static constexpr double timerResolution = 1.0 / 16;
+
     int64_t ScriptsContainer::sInstanceCount = 0;
 
     ScriptsContainer::ScriptsContainer(LuaUtil::LuaState* lua, std::string_view namePrefix)
@@ -315,6 +318,8 @@ namespace LuaUtil
         for (int i = list.size() - 1; i >= 0; --i)
         {
             const Handler& h = list[i];
+            const HandlersProfiler::Scope profile(
+                mLua.getHandlersProfiler(), h.mScriptId, HandlersProfiler::HandlerType::Event, eventName);
             try
             {
                 sol::object res = LuaUtil::call({ this, h.mScriptId }, h.mFn, data);
@@ -360,10 +365,10 @@ namespace LuaUtil
             savedTimer.mCallbackArgument = timer.mSerializedArg;
             timers[timer.mScriptId].push_back(std::move(savedTimer));
         };
-        for (const Timer& timer : mSimulationTimersQueue)
-            saveTimerFn(timer, TimerType::SIMULATION_TIME);
-        for (const Timer& timer : mGameTimersQueue)
-            saveTimerFn(timer, TimerType::GAME_TIME);
+        for (const auto& [type, handle] : mTimerHandles)
+            saveTimerFn(mTimers->getWheel(type).get(handle).mTimer, type);
+        for (const auto& [type, timer] : mPostponedTimers)
+            saveTimerFn(timer, type);
         data.mScripts.clear();
         for (auto& [scriptId, script] : mScripts)
         {
@@ -461,10 +466,7 @@ namespace LuaUtil
                     // updates refnums, so timer.mSerializedArg may be not equal to savedTimer.mCallbackArgument.
                     timer.mSerializedArg = serialize(timer.mArg, mSerializer);
 
-                    if (savedTimer.mType == TimerType::GAME_TIME)
-                        mGameTimersQueue.push_back(std::move(timer));
-                    else
-                        mSimulationTimersQueue.push_back(std::move(timer));
+                    insertTimer(savedTimer.mType, std::move(timer));
                 }
                 catch (std::exception& e)
                 {
@@ -472,14 +474,13 @@ namespace LuaUtil
                 }
             }
         }
-
-        std::make_heap(mSimulationTimersQueue.begin(), mSimulationTimersQueue.end());
-        std::make_heap(mGameTimersQueue.begin(), mGameTimersQueue.end());
     }
 
     ScriptsContainer::~ScriptsContainer()
     {
         sInstanceCount--;
+        for (const auto& [type, handle] : mTimerHandles)
+            mTimers->getWheel(type).erase(handle);
         for (auto& [_, script] : mScripts)
             script.mHiddenData[sScriptIdKey] = sol::nil;
         *mThis = nullptr;
@@ -498,8 +499,10 @@ namespace LuaUtil
         for (auto& [_, handlers] : mEngineHandlers)
             handlers->mList.clear();
         mEventHandlers.clear();
-        mSimulationTimersQueue.clear();
-        mGameTimersQueue.clear();
+        for (const auto& [type, handle] : mTimerHandles)
+            mTimers->getWheel(type).erase(handle);
+        mTimerHandles.clear();
+        mPostponedTimers.clear();
         mPublicInterfaces.clear();
     }
 
@@ -517,10 +520,57 @@ namespace LuaUtil
         getScript(scriptId).mRegisteredCallbacks.emplace(std::string(callbackName), std::move(callback));
     }
 
-    void ScriptsContainer::insertTimer(std::vector<Timer>& timerQueue, Timer&& t)
+    ScriptsTimers& ScriptsContainer::getTimers()
+    {
+        if (!mTimers)
+        {
+            mOwnTimers = std::make_unique<ScriptsTimers>();
+            mTimers = mOwnTimers.get();
+        }
+        return *mTimers;
+    }
+
+    void ScriptsContainer::insertTimer(TimerType type, Timer&& t)
+    {
+        const double time = t.mTime;
+        const TimerHandle handle = getTimers().getWheel(type).insert(time, { this, std::move(t) });
+        mTimerHandles.emplace_back(type, handle);
+    }
+
+    void ScriptsContainer::removeTimerHandle(TimerType type, TimerHandle handle)
+    {
+        auto it = std::find(mTimerHandles.begin(), mTimerHandles.end(), std::make_pair(type, handle));
+        *it = mTimerHandles.back();
+        mTimerHandles.pop_back();
+    }
+
+    void ScriptsContainer::setTimers(ScriptsTimers* timers)
+    {
+        if (timers == mTimers)
+            return;
+        std::vector<std::pair<TimerType, TimerHandle>> handles;
+        handles.swap(mTimerHandles);
+        std::vector<std::pair<TimerType, Timer>> timerValues;
+        for (const auto& [type, handle] : handles)
+        {
+            TimerWheel<ScriptsTimers::Entry>& wheel = mTimers->getWheel(type);
+            timerValues.emplace_back(type, std::move(wheel.get(handle).mTimer));
+            wheel.erase(handle);
+        }
+        mTimers = timers;
+        mOwnTimers.reset();
+        for (auto& [type, timer] : timerValues)
+            insertTimer(type, std::move(timer));
+    }
+
+    void ScriptsContainer::setTimersActive(bool active)
     {
-        timerQueue.push_back(std::move(t));
-        std::push_heap(timerQueue.begin(), timerQueue.end());
+        mTimersActive = active;
+        if (!active)
+            return;
+        for (auto& [type, timer] : mPostponedTimers)
+            insertTimer(type, std::move(timer));
+        mPostponedTimers.clear();
     }
 
     void ScriptsContainer::setupSerializableTimer(
@@ -533,7 +583,7 @@ namespace LuaUtil
         t.mTime = time;
         t.mArg = callbackArg;
         t.mSerializedArg = serialize(t.mArg, mSerializer);
-        insertTimer(type == TimerType::GAME_TIME ? mGameTimersQueue : mSimulationTimersQueue, std::move(t));
+        insertTimer(type, std::move(t));
     }
 
     void ScriptsContainer::setupUnsavableTimer(
@@ -548,11 +598,15 @@ namespace LuaUtil
         getScript(t.mScriptId).mTemporaryCallbacks.emplace(mTemporaryCallbackCounter, std::move(callback));
         mTemporaryCallbackCounter++;
 
-        insertTimer(type == TimerType::GAME_TIME ? mGameTimersQueue : mSimulationTimersQueue, std::move(t));
+        insertTimer(type, std::move(t));
     }
 
     void ScriptsContainer::callTimer(const Timer& t)
     {
+        // Unsavable timers have no names, they are measured together
+        const std::string_view name = t.mSerializable ? std::string_view(std::get<std::string>(t.mCallback)) : "";
+        const HandlersProfiler::Scope profile(
+            mLua.getHandlersProfiler(), t.mScriptId, HandlersProfiler::HandlerType::Timer, name);
         try
         {
             Script& script = getScript(t.mScriptId);
@@ -577,20 +631,45 @@ namespace LuaUtil
         }
     }
 
-    void ScriptsContainer::updateTimerQueue(std::vector<Timer>& timerQueue, double time)
+    void ScriptsContainer::processTimers(double simulationTime, double gameTime)
     {
-        while (!timerQueue.empty() && timerQueue.front().mTime <= time)
-        {
-            callTimer(timerQueue.front());
-            std::pop_heap(timerQueue.begin(), timerQueue.end());
-            timerQueue.pop_back();
-        }
+        if (mOwnTimers)
+            mOwnTimers->processTimers(simulationTime, gameTime);
     }
 
-    void ScriptsContainer::processTimers(double simulationTime, double gameTime)
+    ScriptsTimers::ScriptsTimers()
+        : mSimulationTimers(timerResolution)
+        , mGameTimers(timerResolution)
     {
-        updateTimerQueue(mSimulationTimersQueue, simulationTime);
-        updateTimerQueue(mGameTimersQueue, gameTime);
+    }
+
+    void ScriptsTimers::processTimers(double simulationTime, double gameTime)
+    {
+        processWheel(TimerType::SIMULATION_TIME, simulationTime);
+        processWheel(TimerType::GAME_TIME, gameTime);
+    }
+
+    void ScriptsTimers::processWheel(TimerType type, double time)
+    {
+        TimerWheel<Entry>& wheel = getWheel(type);
+        mExpired.clear();
+        wheel.advance(time, mExpired);
+        // All expired timers are detached before calling any callback because callbacks can add or remove timers.
+        mDue.clear();
+        for (TimerHandle handle : mExpired)
+        {
+            Entry& entry = wheel.get(handle);
+            ScriptsContainer* container = entry.mContainer;
+            container->removeTimerHandle(type, handle);
+            if (container->mTimersActive)
+                mDue.push_back(std::move(entry));
+            else
+                container->mPostponedTimers.emplace_back(type, std::move(entry.mTimer));
+            wheel.erase(handle);
+        }
+        for (const Entry& entry : mDue)
+            entry.mContainer->callTimer(entry.mTimer);
+        mDue.clear();
     }
 
     static constexpr float instructionCountAvgCoef = 1.0 / 30; // averaging over approximately 30 frames
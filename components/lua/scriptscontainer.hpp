@@ -2,6 +2,7 @@
 #define COMPONENTS_LUA_SCRIPTSCONTAINER_H
 
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 
@@ -10,9 +11,11 @@
 
 #include "luastate.hpp"
 #include "serialization.hpp"
+#include "timerwheel.hpp"
 
 namespace LuaUtil
 {
+    class ScriptsTimers;
 
     // ScriptsContainer is a base class for all scripts containers (LocalScripts,
     // GlobalScripts, PlayerScripts, etc). Each script runs in a separate sandbox.
@@ -96,8 +99,17 @@ namespace LuaUtil
         bool hasScript(int scriptId) const { return mScripts.count(scriptId) != 0; }
         void removeScript(int scriptId);
 
+        // Calls callbacks of due timers. Does nothing if the container uses timers shared with other containers,
+        // in this case they are processed by `ScriptsTimers::processTimers`.
         void processTimers(double simulationTime, double gameTime);
 
+        // Moves timers of the container to `timers` which can be shared by several containers of the same LuaState.
+        // The container can't outlive `timers`. If `nullptr`, the container uses its own timers.
+        void setTimers(ScriptsTimers* timers);
+
+        // Due timers of an inactive container are postponed and called when the container is activated again.
+        void setTimersActive(bool active);
+
         // Calls `onUpdate` (if present) for every script in the container.
         // Handlers are called in the same order as scripts were added.
         void update(float dt) { callEngineHandlers(mUpdateHandlers, dt); }
@@ -182,6 +194,8 @@ namespace LuaUtil
         {
             for (Handler& handler : handlers.mList)
             {
+                const HandlersProfiler::Scope profile(mLua.getHandlersProfiler(), handler.mScriptId,
+                    HandlersProfiler::HandlerType::Engine, handlers.mName);
                 try
                 {
                     LuaUtil::call({ this, handler.mScriptId }, handler.mFn, args...);
@@ -222,12 +236,11 @@ namespace LuaUtil
             std::variant<std::string, int64_t> mCallback; // string if serializable, integer otherwise
             sol::main_object mArg;
             std::string mSerializedArg;
-
-            bool operator<(const Timer& t) const { return mTime > t.mTime; }
         };
         using EventHandlerList = std::vector<Handler>;
 
         friend class LuaState;
+        friend class ScriptsTimers;
         void addInstructionCount(int scriptId, int64_t instructionCount);
         void addMemoryUsage(int scriptId, int64_t memoryDelta);
 
@@ -241,8 +254,9 @@ namespace LuaUtil
         const std::string& scriptPath(int scriptId) const { return mLua.getConfiguration()[scriptId].mScriptPath; }
         void callOnInit(int scriptId, const sol::function& onInit, std::string_view data);
         void callTimer(const Timer& t);
-        void updateTimerQueue(std::vector<Timer>& timerQueue, double time);
-        static void insertTimer(std::vector<Timer>& timerQueue, Timer&& t);
+        ScriptsTimers& getTimers();
+        void insertTimer(TimerType type, Timer&& t);
+        void removeTimerHandle(TimerType type, TimerHandle handle);
         static void insertHandler(std::vector<Handler>& list, int scriptId, sol::function fn);
         static void removeHandler(std::vector<Handler>& list, int scriptId);
         void insertInterface(int scriptId, const Script& script);
@@ -260,8 +274,11 @@ namespace LuaUtil
         std::map<std::string_view, EngineHandlerList*> mEngineHandlers;
         std::map<std::string, EventHandlerList, std::less<>> mEventHandlers;
 
-        std::vector<Timer> mSimulationTimersQueue;
-        std::vector<Timer> mGameTimersQueue;
+        ScriptsTimers* mTimers = nullptr;
+        std::unique_ptr<ScriptsTimers> mOwnTimers; // created on demand if timers are not shared
+        std::vector<std::pair<TimerType, TimerHandle>> mTimerHandles;
+        std::vector<std::pair<TimerType, Timer>> mPostponedTimers;
+        bool mTimersActive = true;
         int64_t mTemporaryCallbackCounter = 0;
 
         std::map<int, int64_t> mRemovedScriptsMemoryUsage;
@@ -269,6 +286,42 @@ namespace LuaUtil
 
         static int64_t sInstanceCount; // debug information, shown in Lua profiler
     };
+
+    // Pending timers of any number of ScriptsContainers that use the same LuaState. Due timers are found using
+    // timer wheels, so the time of `processTimers` depends only on the number of expired timers.
+    class ScriptsTimers
+    {
+    public:
+        using TimerType = ScriptsContainer::TimerType;
+
+        ScriptsTimers();
+
+        // Calls callbacks of all timers that are due according to `simulationTime` or `gameTime` (depending
+        // on the timer type) in the order of their time. Timers of inactive containers are postponed.
+        void processTimers(double simulationTime, double gameTime);
+
+        std::size_t size() const { return mSimulationTimers.size() + mGameTimers.size(); }
+
+    private:
+        friend class ScriptsContainer;
+
+        struct Entry
+        {
+            ScriptsContainer* mContainer;
+            ScriptsContainer::Timer mTimer;
+        };
+
+        TimerWheel<Entry>& getWheel(TimerType type)
+        {
+            return type == TimerType::GAME_TIME ? mGameTimers : mSimulationTimers;
+        }
+        void processWheel(TimerType type, double time);
+
+        TimerWheel<Entry> mSimulationTimers;
+        TimerWheel<Entry> mGameTimers;
+        std::vector<TimerHandle> mExpired;
+        std::vector<Entry> mDue;
+    };
 }
 
 #endif // COMPONENTS_LUA_SCRIPTSCONTAINER_H
@@ -0,0 +1,264 @@
+#ifndef COMPONENTS_LUA_TIMERWHEEL_H
+#define COMPONENTS_LUA_TIMERWHEEL_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace LuaUtil
+{
+    using TimerHandle = std::uint32_t;
+
+    // Hierarchical timing wheel. Time is divided into ticks of the given resolution. Level N consists of 64 buckets,
+    // each of them covers 64^N ticks; a value is stored in the lowest level where its tick differs from the current
+    // one. Advancing the time takes only the buckets that are already due, so the cost of `advance` is proportional
+    // to the number of expired values (every value moves down at most once per level) and doesn't depend on
+    // the number of values that are not expired yet.
+    template <class T>
+    class TimerWheel
+    {
+    public:
+        using Handle = TimerHandle;
+
+        explicit TimerWheel(double resolution)
+            : mResolution(resolution)
+        {
+        }
+
+        // The number of values in the wheel including the expired values that are not erased yet.
+        std::size_t size() const { return mSize; }
+
+        Handle insert(double time, T value)
+        {
+            Handle handle;
+            if (mFreeNodes.empty())
+            {
+                handle = static_cast<Handle>(mNodes.size());
+                mNodes.emplace_back();
+            }
+            else
+            {
+                handle = mFreeNodes.back();
+                mFreeNodes.pop_back();
+            }
+            Node& node = mNodes[handle];
+            node.mValue = std::move(value);
+            node.mTime = time;
+            node.mTick = toTick(time);
+            node.mSequence = mNextSequence++;
+            mSize++;
+            place(handle);
+            return handle;
+        }
+
+        // References are invalidated by `insert`.
+        T& get(Handle handle) { return *mNodes[handle].mValue; }
+        const T& get(Handle handle) const { return *mNodes[handle].mValue; }
+        double getTime(Handle handle) const { return mNodes[handle].mTime; }
+
+        // Removes the value (expired or not). The handle can be reused by the next `insert`.
+        void erase(Handle handle)
+        {
+            Node& node = mNodes[handle];
+            if (node.mList != sDetached)
+                unlink(handle);
+            node.mValue.reset();
+            node.mList = sFree;
+            mFreeNodes.push_back(handle);
+            mSize--;
+        }
+
+        void clear()
+        {
+            mNodes.clear();
+            mFreeNodes.clear();
+            for (std::vector<Handle>& list : mLists)
+                list.clear();
+            mOccupied.fill(0);
+            mSize = 0;
+        }
+
+        // Takes out all values with time <= `time` and appends their handles to `expired` ordered by time (values with
+        // equal time are ordered by insertion). Expired values stay accessible via `get` until `erase` is called.
+        // If `time` is less than in the previous call, all values are redistributed (O(size)).
+        void advance(double time, std::vector<Handle>& expired)
+        {
+            const std::int64_t target = toTick(time);
+            if (target < mCurrentTick)
+                rebase(target);
+            while (true)
+            {
+                int level = 0;
+                while (level < sLevels && mOccupied[level] == 0)
+                    level++;
+                if (level == sLevels)
+                {
+                    std::optional<std::int64_t> nextTick = findOverflowTick();
+                    if (!nextTick || *nextTick > target)
+                    {
+                        setCurrentTick(target);
+                        break;
+                    }
+                    // Beginning of the range covered by the levels that contains `nextTick`.
+                    setCurrentTick((*nextTick >> sTopShift) << sTopShift);
+                    continue;
+                }
+                const int slot = std::countr_zero(mOccupied[level]);
+                const int shift = level * sBitsPerLevel;
+                const std::int64_t bucketTick = ((mCurrentTick >> (shift + sBitsPerLevel)) << (shift + sBitsPerLevel))
+                    | (static_cast<std::int64_t>(slot) << shift);
+                if (bucketTick > target)
+                {
+                    setCurrentTick(target);
+                    break;
+                }
+                mCurrentTick = bucketTick;
+                std::vector<Handle>& bucket = mLists[level * sSlotsPerLevel + slot];
+                mCascade.swap(bucket);
+                mOccupied[level] &= ~(std::uint64_t(1) << slot);
+                for (Handle handle : mCascade)
+                    place(handle);
+                mCascade.clear();
+            }
+
+            const std::size_t begin = expired.size();
+            std::vector<Handle>& pending = mLists[sPendingList];
+            for (std::size_t i = pending.size(); i > 0; --i)
+            {
+                const Handle handle = pending[i - 1];
+                if (mNodes[handle].mTime > time)
+                    continue;
+                unlink(handle);
+                expired.push_back(handle);
+            }
+            std::sort(expired.begin() + begin, expired.end(), [&](Handle l, Handle r) {
+                const Node& left = mNodes[l];
+                const Node& right = mNodes[r];
+                return std::make_pair(left.mTime, left.mSequence) < std::make_pair(right.mTime, right.mSequence);
+            });
+        }
+
+    private:
+        static constexpr int sBitsPerLevel = 6;
+        static constexpr int sSlotsPerLevel = 1 << sBitsPerLevel;
+        static constexpr int sLevels = 6;
+        static constexpr int sTopShift = sLevels * sBitsPerLevel;
+        // Values that are beyond the range of the levels.
+        static constexpr int sOverflowList = sLevels * sSlotsPerLevel;
+        // Values with the tick that is already reached, but which time is not.
+        static constexpr int sPendingList = sOverflowList + 1;
+        static constexpr int sDetached = -1;
+        static constexpr int sFree = -2;
+        static constexpr double sMaxTick = 1ll << 62;
+
+        struct Node
+        {
+            std::optional<T> mValue;
+            double mTime = 0;
+            std::int64_t mTick = 0;
+            std::uint64_t mSequence = 0;
+            int mList = sFree;
+            std::uint32_t mIndex = 0;
+        };
+
+        std::int64_t toTick(double time) const
+        {
+            const double tick = std::floor(time / mResolution);
+            if (!(tick < sMaxTick))
+                return static_cast<std::int64_t>(sMaxTick);
+            if (tick < -sMaxTick)
+                return static_cast<std::int64_t>(-sMaxTick);
+            return static_cast<std::int64_t>(tick);
+        }
+
+        void place(Handle handle)
+        {
+            Node& node = mNodes[handle];
+            if (node.mTick <= mCurrentTick)
+                node.mList = sPendingList;
+            else
+            {
+                const auto diff = static_cast<std::uint64_t>(node.mTick ^ mCurrentTick);
+                const int level = (std::bit_width(diff) - 1) / sBitsPerLevel;
+                if (level >= sLevels)
+                    node.mList = sOverflowList;
+                else
+                {
+                    const int slot = (node.mTick >> (level * sBitsPerLevel)) & (sSlotsPerLevel - 1);
+                    node.mList = level * sSlotsPerLevel + slot;
+                    mOccupied[level] |= std::uint64_t(1) << slot;
+                }
+            }
+            std::vector<Handle>& list = mLists[node.mList];
+            node.mIndex = static_cast<std::uint32_t>(list.size());
+            list.push_back(handle);
+        }
+
+        void unlink(Handle handle)
+        {
+            Node& node = mNodes[handle];
+            std::vector<Handle>& list = mLists[node.mList];
+            const Handle last = list.back();
+            list[node.mIndex] = last;
+            mNodes[last].mIndex = node.mIndex;
+            list.pop_back();
+            if (list.empty() && node.mList < sOverflowList)
+                mOccupied[node.mList / sSlotsPerLevel] &= ~(std::uint64_t(1) << (node.mList % sSlotsPerLevel));
+            node.mList = sDetached;
+        }
+
+        std::optional<std::int64_t> findOverflowTick() const
+        {
+            std::optional<std::int64_t> result;
+            for (Handle handle : mLists[sOverflowList])
+                if (!result || mNodes[handle].mTick < *result)
+                    result = mNodes[handle].mTick;
+            return result;
+        }
+
+        // Moves forward without passing any non-empty bucket.
+        void setCurrentTick(std::int64_t tick)
+        {
+            const bool sameRange = (tick >> sTopShift) == (mCurrentTick >> sTopShift);
+            mCurrentTick = tick;
+            if (sameRange)
+                return;
+            mCascade.swap(mLists[sOverflowList]);
+            for (Handle handle : mCascade)
+                place(handle);
+            mCascade.clear();
+        }
+
+        void rebase(std::int64_t tick)
+        {
+            mCurrentTick = tick;
+            mOccupied.fill(0);
+            for (int list = 0; list < sPendingList + 1; ++list)
+            {
+                if (mLists[list].empty())
+                    continue;
+                mCascade.swap(mLists[list]);
+                for (Handle handle : mCascade)
+                    place(handle);
+                mCascade.clear();
+            }
+        }
+
+        double mResolution;
+        std::int64_t mCurrentTick = 0;
+        std::uint64_t mNextSequence = 0;
+        std::size_t mSize = 0;
+        std::vector<Node> mNodes;
+        std::vector<Handle> mFreeNodes;
+        std::array<std::vector<Handle>, sPendingList + 1> mLists;
+        std::array<std::uint64_t, sLevels> mOccupied{};
+        std::vector<Handle> mCascade;
+    };
+}
+
+#endif // COMPONENTS_LUA_TIMERWHEEL_H
@@ -0,0 +1,109 @@
+#ifndef OPENMW_COMPONENTS_MISC_SPATIALGRID_H
+#define OPENMW_COMPONENTS_MISC_SPATIALGRID_H
+
+#include <osg/Vec3f>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace Misc
+{
+    /// Uniform grid over the XY plane to find values placed near a given position without iterating over all of them.
+    /// Values are added with their positions and then build is called. Any change requires a rebuild from scratch.
+    template <class T>
+    class SpatialGrid
+    {
+    public:
+        explicit SpatialGrid(float cellSize)
+            : mCellSize(cellSize)
+        {
+        }
+
+        void clear()
+        {
+            mItems.clear();
+        }
+
+        void add(const osg::Vec3f& position, const T& value)
+        {
+            const std::uint64_t cellKey = getCellKey(getCellIndex(position.x()), getCellIndex(position.y()));
+            mItems.push_back(Item{ cellKey, position, value });
+        }
+
+        /// Makes added values visible for queries. Values within the same cell keep the order they were added in.
+        void build()
+        {
+            std::stable_sort(
+                mItems.begin(), mItems.end(), [](const Item& l, const Item& r) { return l.mCellKey < r.mCellKey; });
+        }
+
+        std::size_t size() const { return mItems.size(); }
+
+        /// Calls function(value, position) for each value from the cells intersecting the square with the given
+        /// center and half size. Some values may be further than halfSize from the center, the caller should check
+        /// the distance.
+        template <class Function>
+        void forEachInSquare(const osg::Vec3f& center, float halfSize, Function&& function) const
+        {
+            const std::int64_t minX = getCellIndex(center.x() - halfSize);
+            const std::int64_t maxX = getCellIndex(center.x() + halfSize);
+            const std::int64_t minY = getCellIndex(center.y() - halfSize);
+            const std::int64_t maxY = getCellIndex(center.y() + halfSize);
+            // Cells are ordered by X then by Y so each row of cells within the square is a continuous range of items
+            auto it = mItems.begin();
+            for (std::int64_t x = minX; x <= maxX && it != mItems.end(); ++x)
+            {
+                const std::uint64_t begin = getCellKey(x, minY);
+                const std::uint64_t end = getCellKey(x, maxY);
+                it = std::partition_point(it, mItems.end(), [&](const Item& item) { return item.mCellKey < begin; });
+                for (; it != mItems.end() && it->mCellKey <= end; ++it)
+                    function(it->mValue, it->mPosition);
+            }
+        }
+
+        /// Calls function(value, position) for each value added at a position not further than radius from the given
+        /// one.
+        template <class Function>
+        void forEachInRange(const osg::Vec3f& position, float radius, Function&& function) const
+        {
+            const float radius2 = radius * radius;
+            forEachInSquare(position, radius, [&](const T& value, const osg::Vec3f& valuePosition) {
+                if ((valuePosition - position).length2() <= radius2)
+                    function(value, valuePosition);
+            });
+        }
+
+    private:
+        struct Item
+        {
+            std::uint64_t mCellKey;
+            osg::Vec3f mPosition;
+            T mValue;
+        };
+
+        float mCellSize;
+        std::vector<Item> mItems;
+
+        std::int64_t getCellIndex(float coordinate) const
+        {
+            constexpr double min = std::numeric_limits<std::int32_t>::min();
+            constexpr double max = std::numeric_limits<std::int32_t>::max();
+            return static_cast<std::int64_t>(std::clamp(std::floor(double{ coordinate } / mCellSize), min, max));
+        }
+
+        // Keeps the order of cell indices for negative values
+        static std::uint64_t getCellKey(std::int64_t x, std::int64_t y)
+        {
+            const auto toUnsigned = [](std::int64_t v) {
+                return static_cast<std::uint32_t>(static_cast<std::int32_t>(v)) ^ std::uint32_t{ 0x80000000 };
+            };
+            return (static_cast<std::uint64_t>(toUnsigned(x)) << 32) | toUnsigned(y);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef OPENMW_COMPONENTS_MISC_WORKSTEALINGRANGES_H
+#define OPENMW_COMPONENTS_MISC_WORKSTEALINGRANGES_H
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+
+namespace Misc
+{
+    /// @brief Lock-free distribution of job indices between a fixed number of workers
+    /// Each worker owns a continuous range of indices and takes chunks from its beginning. A worker with the empty range
+    /// steals the second half of the range of another worker, so workers with cheaper jobs help the ones with expensive
+    /// jobs while contention on the shared state stays low.
+    class WorkStealingRanges
+    {
+    public:
+        /// @param workers number of threads calling take, each with its own index
+        explicit WorkStealingRanges(std::size_t workers)
+            : mSize(std::max<std::size_t>(workers, 1))
+            , mRanges(std::make_unique<Range[]>(mSize))
+        {
+        }
+
+        std::size_t getWorkersCount() const { return mSize; }
+
+        /// @brief split [0, count) between workers
+        /// Is not thread safe, no worker can call take at the same time.
+        void reset(std::size_t count, std::size_t chunkSize = 1)
+        {
+            assert(count <= std::numeric_limits<std::uint32_t>::max());
+            mChunkSize = static_cast<std::uint32_t>(std::max<std::size_t>(chunkSize, 1));
+            for (std::size_t i = 0; i < mSize; ++i)
+                mRanges[i].mValue.store(pack(count * i / mSize, count * (i + 1) / mSize), std::memory_order_release);
+        }
+
+        /// @return range of job indices [first, second) to be processed by given worker, empty when all jobs are taken
+        std::pair<std::size_t, std::size_t> take(std::size_t worker)
+        {
+            assert(worker < mSize);
+            std::atomic<std::uint64_t>& own = mRanges[worker].mValue;
+            std::uint64_t value = own.load(std::memory_order_acquire);
+            while (getBegin(value) < getEnd(value))
+            {
+                const std::uint32_t begin = getBegin(value);
+                const std::uint32_t end = std::min<std::uint32_t>(getEnd(value), begin + mChunkSize);
+                if (own.compare_exchange_weak(value, pack(end, getEnd(value)), std::memory_order_acq_rel))
+                    return { begin, end };
+            }
+            for (std::size_t i = 1; i < mSize; ++i)
+            {
+                std::atomic<std::uint64_t>& victim = mRanges[(worker + i) % mSize].mValue;
+                value = victim.load(std::memory_order_acquire);
+                while (getBegin(value) < getEnd(value))
+                {
+                    const std::uint32_t begin = getBegin(value);
+                    const std::uint32_t end = getEnd(value);
+                    const std::uint32_t middle = end - std::max<std::uint32_t>((end - begin) / 2, 1);
+                    if (!victim.compare_exchange_weak(value, pack(begin, middle), std::memory_order_acq_rel))
+                        continue;
+                    // Own range is empty so only this worker can change it, thieves skip empty ranges
+                    const std::uint32_t chunkEnd = std::min<std::uint32_t>(end, middle + mChunkSize);
+                    own.store(pack(chunkEnd, end), std::memory_order_release);
+                    return { middle, chunkEnd };
+                }
+            }
+            return { 0, 0 };
+        }
+
+    private:
+        struct alignas(64) Range
+        {
+            std::atomic<std::uint64_t> mValue{ 0 };
+        };
+
+        std::size_t mSize;
+        std::unique_ptr<Range[]> mRanges;
+        std::uint32_t mChunkSize = 1;
+
+        static std::uint64_t pack(std::size_t begin, std::size_t end)
+        {
+            return (static_cast<std::uint64_t>(begin) << 32) | static_cast<std::uint32_t>(end);
+        }
+
+        static std::uint32_t getBegin(std::uint64_t value) { return static_cast<std::uint32_t>(value >> 32); }
+
+        static std::uint32_t getEnd(std::uint64_t value) { return static_cast<std::uint32_t>(value); }
+    };
+}
+
+#endif
@@ -201,11 +201,11 @@ namespace Nif
 
     void Reader::parse(Files::IStreamPtr&& stream)
     {
-        const std::array<std::uint64_t, 2> fileHash = Files::getHash(filename, *stream);
-        hash.append(reinterpret_cast<const char*>(fileHash.data()), fileHash.size() * sizeof(std::uint64_t));
-
         NIFStream nif(*this, std::move(stream));
 
+        const std::array<std::uint64_t, 2> fileHash = Files::getHash(nif.getUnread());
+        hash.append(reinterpret_cast<const char*>(fileHash.data()), fileHash.size() * sizeof(std::uint64_t));
+
         // Check the header string
         std::string head = nif.getVersionString();
         static const std::array<std::string, 2> verStrings = {
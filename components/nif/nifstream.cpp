@@ -2,12 +2,57 @@
 // For error reporting
 #include "niffile.hpp"
 
+#include <components/files/memorystream.hpp>
+
 namespace Nif
 {
+    NIFStream::NIFStream(const Reader& file, Files::IStreamPtr&& stream)
+        : file(file)
+        , inp(std::move(stream))
+    {
+        if (const auto* memBuf = dynamic_cast<const Files::MemBuf*>(inp->rdbuf()))
+        {
+            const std::string_view data = memBuf->getUnread();
+            mPos = data.data();
+            mEnd = data.data() + data.size();
+            return;
+        }
+
+        const std::streampos start = inp->tellg();
+        inp->seekg(0, std::ios_base::end);
+        const std::streampos end = inp->tellg();
+        inp->seekg(start);
+        if (start != std::streampos(-1) && end != std::streampos(-1) && end >= start)
+        {
+            mBuffer.resize(static_cast<std::size_t>(end - start));
+            inp->read(mBuffer.data(), static_cast<std::streamsize>(mBuffer.size()));
+            mBuffer.resize(static_cast<std::size_t>(inp->gcount()));
+        }
+        else
+        {
+            // Size is unknown for non seekable streams
+            inp->clear();
+            constexpr std::size_t chunkSize = 64 * 1024;
+            while (*inp)
+            {
+                const std::size_t size = mBuffer.size();
+                mBuffer.resize(size + chunkSize);
+                inp->read(mBuffer.data() + size, chunkSize);
+                mBuffer.resize(size + static_cast<std::size_t>(inp->gcount()));
+            }
+        }
+        if (inp->bad())
+            throw std::runtime_error("Failed to read NIF stream");
+        inp.reset();
+
+        mPos = mBuffer.data();
+        mEnd = mBuffer.data() + mBuffer.size();
+    }
+
     osg::Quat NIFStream::getQuaternion()
     {
         float f[4];
-        readLittleEndianBufferOfType<4, float>(inp, f);
+        readLittleEndianBufferOfType<4>(f);
         osg::Quat quat;
         quat.w() = f[0];
         quat.x() = f[1];
@@ -3,10 +3,14 @@
 #ifndef OPENMW_COMPONENTS_NIF_NIFSTREAM_HPP
 #define OPENMW_COMPONENTS_NIF_NIFSTREAM_HPP
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <istream>
 #include <stdexcept>
 #include <stdint.h>
+#include <string>
+#include <string_view>
 #include <type_traits>
 #include <vector>
 
@@ -24,94 +28,110 @@ namespace Nif
 
     class Reader;
 
-    template <std::size_t numInstances, typename T>
-    inline void readLittleEndianBufferOfType(Files::IStreamPtr& pIStream, T* dest)
-    {
-        static_assert(std::is_arithmetic_v<T>, "Buffer element type is not arithmetic");
-        pIStream->read((char*)dest, numInstances * sizeof(T));
-        if (pIStream->bad())
-            throw std::runtime_error("Failed to read little endian typed (" + std::string(typeid(T).name())
-                + ") buffer of " + std::to_string(numInstances) + " instances");
-        if constexpr (Misc::IS_BIG_ENDIAN)
-            for (std::size_t i = 0; i < numInstances; i++)
-                Misc::swapEndiannessInplace(dest[i]);
-    }
-
-    template <typename T>
-    inline void readLittleEndianDynamicBufferOfType(Files::IStreamPtr& pIStream, T* dest, std::size_t numInstances)
-    {
-        static_assert(std::is_arithmetic_v<T>, "Buffer element type is not arithmetic");
-        pIStream->read((char*)dest, numInstances * sizeof(T));
-        if (pIStream->bad())
-            throw std::runtime_error(
-                "Failed to read little endian dynamic buffer of " + std::to_string(numInstances) + " instances");
-        if constexpr (Misc::IS_BIG_ENDIAN)
-            for (std::size_t i = 0; i < numInstances; i++)
-                Misc::swapEndiannessInplace(dest[i]);
-    }
-    template <typename type>
-    type inline readLittleEndianType(Files::IStreamPtr& pIStream)
-    {
-        type val;
-        readLittleEndianBufferOfType<1, type>(pIStream, &val);
-        return val;
-    }
-
     class NIFStream
     {
         const Reader& file;
 
-        /// Input stream
+        /// Input stream. Kept alive while its memory buffer is read directly.
         Files::IStreamPtr inp;
 
-    public:
-        explicit NIFStream(const Reader& file, Files::IStreamPtr&& inp)
-            : file(file)
-            , inp(std::move(inp))
+        /// Stream content when the stream is not backed by a memory buffer
+        std::vector<char> mBuffer;
+
+        const char* mPos = nullptr;
+        const char* mEnd = nullptr;
+
+        void checkAvailable(std::size_t size, std::string_view what) const
+        {
+            if (static_cast<std::size_t>(mEnd - mPos) < size)
+                throw std::runtime_error("Failed to read " + std::string(what) + " of " + std::to_string(size)
+                    + " bytes: only " + std::to_string(mEnd - mPos) + " bytes left");
+        }
+
+        template <typename T>
+        void readLittleEndianDynamicBufferOfType(T* dest, std::size_t numInstances)
+        {
+            static_assert(std::is_arithmetic_v<T>, "Buffer element type is not arithmetic");
+            const std::size_t size = numInstances * sizeof(T);
+            checkAvailable(size, "little endian buffer");
+            std::memcpy(dest, mPos, size);
+            mPos += size;
+            if constexpr (Misc::IS_BIG_ENDIAN)
+                for (std::size_t i = 0; i < numInstances; i++)
+                    Misc::swapEndiannessInplace(dest[i]);
+        }
+
+        template <std::size_t numInstances, typename T>
+        void readLittleEndianBufferOfType(T* dest)
+        {
+            readLittleEndianDynamicBufferOfType(dest, numInstances);
+        }
+
+        template <typename T>
+        T readLittleEndianType()
+        {
+            T val;
+            readLittleEndianBufferOfType<1>(&val);
+            return val;
+        }
+
+        std::string_view readChars(std::size_t size, std::string_view what)
         {
+            checkAvailable(size, what);
+            const std::string_view result(mPos, size);
+            mPos += size;
+            return result;
         }
 
+    public:
+        /// Reads the stream data directly when the stream is backed by Files::MemBuf and reads the whole stream into
+        /// memory otherwise.
+        explicit NIFStream(const Reader& file, Files::IStreamPtr&& stream);
+
+        /// Data that has not been read yet
+        std::string_view getUnread() const { return std::string_view(mPos, static_cast<std::size_t>(mEnd - mPos)); }
+
         const Reader& getFile() const { return file; }
 
-        void skip(size_t size) { inp->ignore(size); }
+        void skip(size_t size) { readChars(size, "skipped data"); }
 
-        char getChar() { return readLittleEndianType<char>(inp); }
+        char getChar() { return readLittleEndianType<char>(); }
 
-        short getShort() { return readLittleEndianType<short>(inp); }
+        short getShort() { return readLittleEndianType<short>(); }
 
-        unsigned short getUShort() { return readLittleEndianType<unsigned short>(inp); }
+        unsigned short getUShort() { return readLittleEndianType<unsigned short>(); }
 
-        int getInt() { return readLittleEndianType<int>(inp); }
+        int getInt() { return readLittleEndianType<int>(); }
 
-        unsigned int getUInt() { return readLittleEndianType<unsigned int>(inp); }
+        unsigned int getUInt() { return readLittleEndianType<unsigned int>(); }
 
-        float getFloat() { return readLittleEndianType<float>(inp); }
+        float getFloat() { return readLittleEndianType<float>(); }
 
         osg::Vec2f getVector2()
         {
             osg::Vec2f vec;
-            readLittleEndianBufferOfType<2, float>(inp, vec._v);
+            readLittleEndianBufferOfType<2>(vec._v);
             return vec;
         }
 
         osg::Vec3f getVector3()
         {
             osg::Vec3f vec;
-            readLittleEndianBufferOfType<3, float>(inp, vec._v);
+            readLittleEndianBufferOfType<3>(vec._v);
             return vec;
         }
 
         osg::Vec4f getVector4()
         {
             osg::Vec4f vec;
-            readLittleEndianBufferOfType<4, float>(inp, vec._v);
+            readLittleEndianBufferOfType<4>(vec._v);
             return vec;
         }
 
         Matrix3 getMatrix3()
         {
             Matrix3 mat;
-            readLittleEndianBufferOfType<9, float>(inp, (float*)&mat.mValues);
+            readLittleEndianBufferOfType<9>((float*)&mat.mValues);
             return mat;
         }
 
@@ -136,105 +156,94 @@ namespace Nif
         /// Read in a string of the given length
         std::string getSizedString(size_t length)
         {
-            std::string str(length, '\0');
-            inp->read(str.data(), length);
-            if (inp->bad())
-                throw std::runtime_error("Failed to read sized string of " + std::to_string(length) + " chars");
-            size_t end = str.find('\0');
-            if (end != std::string::npos)
-                str.erase(end);
-            return str;
+            const std::string_view str = readChars(length, "sized string");
+            return std::string(str.substr(0, str.find('\0')));
         }
         /// Read in a string of the length specified in the file
         std::string getSizedString()
         {
-            size_t size = readLittleEndianType<uint32_t>(inp);
+            size_t size = readLittleEndianType<uint32_t>();
             return getSizedString(size);
         }
 
         /// Specific to Bethesda headers, uses a byte for length
         std::string getExportString()
         {
-            size_t size = static_cast<size_t>(readLittleEndianType<uint8_t>(inp));
+            size_t size = static_cast<size_t>(readLittleEndianType<uint8_t>());
             return getSizedString(size);
         }
 
         /// This is special since the version string doesn't start with a number, and ends with "\n"
         std::string getVersionString()
         {
-            std::string result;
-            std::getline(*inp, result);
-            if (inp->bad())
-                throw std::runtime_error("Failed to read version string");
-            return result;
+            const std::string_view unread = getUnread();
+            const std::size_t end = std::min(unread.find('\n'), unread.size());
+            mPos += std::min(end + 1, unread.size());
+            return std::string(unread.substr(0, end));
         }
 
         /// Read a sequence of null-terminated strings
         std::string getStringPalette()
         {
-            size_t size = readLittleEndianType<uint32_t>(inp);
-            std::string str(size, '\0');
-            inp->read(str.data(), size);
-            if (inp->bad())
-                throw std::runtime_error("Failed to read string palette of " + std::to_string(size) + " chars");
-            return str;
+            size_t size = readLittleEndianType<uint32_t>();
+            return std::string(readChars(size, "string palette"));
         }
 
         void getChars(std::vector<char>& vec, size_t size)
         {
             vec.resize(size);
-            readLittleEndianDynamicBufferOfType<char>(inp, vec.data(), size);
+            readLittleEndianDynamicBufferOfType<char>(vec.data(), size);
         }
 
         void getUChars(std::vector<unsigned char>& vec, size_t size)
         {
             vec.resize(size);
-            readLittleEndianDynamicBufferOfType<unsigned char>(inp, vec.data(), size);
+            readLittleEndianDynamicBufferOfType<unsigned char>(vec.data(), size);
         }
 
         void getUShorts(std::vector<unsigned short>& vec, size_t size)
         {
             vec.resize(size);
-            readLittleEndianDynamicBufferOfType<unsigned short>(inp, vec.data(), size);
+            readLittleEndianDynamicBufferOfType<unsigned short>(vec.data(), size);
         }
 
         void getFloats(std::vector<float>& vec, size_t size)
         {
             vec.resize(size);
-            readLittleEndianDynamicBufferOfType<float>(inp, vec.data(), size);
+            readLittleEndianDynamicBufferOfType<float>(vec.data(), size);
         }
 
         void getInts(std::vector<int>& vec, size_t size)
         {
             vec.resize(size);
-            readLittleEndianDynamicBufferOfType<int>(inp, vec.data(), size);
+            readLittleEndianDynamicBufferOfType<int>(vec.data(), size);
         }
 
         void getUInts(std::vector<unsigned int>& vec, size_t size)
         {
             vec.resize(size);
-            readLittleEndianDynamicBufferOfType<unsigned int>(inp, vec.data(), size);
+            readLittleEndianDynamicBufferOfType<unsigned int>(vec.data(), size);
         }
 
         void getVector2s(std::vector<osg::Vec2f>& vec, size_t size)
         {
             vec.resize(size);
             /* The packed storage of each Vec2f is 2 floats exactly */
-            readLittleEndianDynamicBufferOfType<float>(inp, (float*)vec.data(), size * 2);
+            readLittleEndianDynamicBufferOfType<float>((float*)vec.data(), size * 2);
         }
 
         void getVector3s(std::vector<osg::Vec3f>& vec, size_t size)
         {
             vec.resize(size);
             /* The packed storage of each Vec3f is 3 floats exactly */
-            readLittleEndianDynamicBufferOfType<float>(inp, (float*)vec.data(), size * 3);
+            readLittleEndianDynamicBufferOfType<float>((float*)vec.data(), size * 3);
         }
 
         void getVector4s(std::vector<osg::Vec4f>& vec, size_t size)
         {
             vec.resize(size);
             /* The packed storage of each Vec4f is 4 floats exactly */
-            readLittleEndianDynamicBufferOfType<float>(inp, (float*)vec.data(), size * 4);
+            readLittleEndianDynamicBufferOfType<float>((float*)vec.data(), size * 4);
         }
 
         void getQuaternions(std::vector<osg::Quat>& quat, size_t size)
@@ -3,6 +3,7 @@
 
 #include <cstdlib>
 #include <filesystem>
+#include <memory>
 
 namespace Platform::File
 {
@@ -63,6 +64,31 @@ namespace Platform::File
 
         operator Handle() const { return mHandle; }
     };
+
+    /// Read-only view of the whole file content. Uses memory mapping when supported by the platform, otherwise reads
+    /// the file into memory.
+    /// @note Thread safe.
+    class MappedFile
+    {
+    public:
+        explicit MappedFile(const std::filesystem::path& filename);
+
+        MappedFile(const MappedFile& other) = delete;
+
+        ~MappedFile();
+
+        MappedFile& operator=(const MappedFile& other) = delete;
+
+        const char* data() const { return mData; }
+
+        std::size_t size() const { return mSize; }
+
+    private:
+        const char* mData = nullptr;
+        std::size_t mSize = 0;
+        intptr_t mMapping = -1;
+        std::unique_ptr<char[]> mBuffer;
+    };
 }
 
 #endif // OPENMW_COMPONENTS_PLATFORM_FILE_HPP
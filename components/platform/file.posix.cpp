@@ -6,6 +6,8 @@
 #include <stdexcept>
 #include <string.h>
 #include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
 
@@ -103,4 +105,32 @@ namespace Platform::File
         return amount;
     }
 
+    MappedFile::MappedFile(const std::filesystem::path& filename)
+    {
+        const ScopedHandle file(open(filename));
+        const auto nativeHandle = getNativeHandle(file);
+
+        struct stat info;
+        if (::fstat(nativeHandle, &info) == -1)
+            throw std::system_error(errno, std::generic_category(), "An fstat() call failed");
+
+        mSize = static_cast<size_t>(info.st_size);
+        if (mSize == 0)
+            return;
+
+        void* const data = ::mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, nativeHandle, 0);
+        if (data == MAP_FAILED)
+        {
+            throw std::system_error(errno, std::generic_category(),
+                std::string("Failed to map '") + Files::pathToUnicodeString(filename) + "' into memory");
+        }
+        mData = static_cast<const char*>(data);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (mData != nullptr)
+            ::munmap(const_cast<char*>(mData), mSize);
+    }
+
 }
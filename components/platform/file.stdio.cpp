@@ -93,4 +93,25 @@ namespace Platform::File
         return static_cast<size_t>(amount);
     }
 
+    MappedFile::MappedFile(const std::filesystem::path& filename)
+    {
+        const ScopedHandle file(open(filename));
+
+        mSize = File::size(file);
+        mBuffer = std::make_unique<char[]>(mSize);
+
+        std::size_t offset = 0;
+        while (offset < mSize)
+        {
+            const std::size_t amount = read(file, mBuffer.get() + offset, mSize - offset);
+            if (amount == 0)
+                throw std::runtime_error("Unexpected end of file '" + Files::pathToUnicodeString(filename) + "'");
+            offset += amount;
+        }
+
+        mData = mBuffer.get();
+    }
+
+    MappedFile::~MappedFile() = default;
+
 }
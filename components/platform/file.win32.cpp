@@ -100,4 +100,38 @@ namespace Platform::File
 
         return bytesRead;
     }
+
+    MappedFile::MappedFile(const std::filesystem::path& filename)
+    {
+        const ScopedHandle file(open(filename));
+
+        mSize = File::size(file);
+        if (mSize == 0)
+            return;
+
+        HANDLE mapping = CreateFileMappingW(getNativeHandle(file), nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+            throw std::runtime_error(std::string("Failed to create mapping for '")
+                + Files::pathToUnicodeString(filename) + "': " + std::to_string(GetLastError()));
+
+        const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (data == nullptr)
+        {
+            const auto errCode = GetLastError();
+            CloseHandle(mapping);
+            throw std::runtime_error(std::string("Failed to map '") + Files::pathToUnicodeString(filename)
+                + "' into memory: " + std::to_string(errCode));
+        }
+
+        mMapping = reinterpret_cast<intptr_t>(mapping);
+        mData = static_cast<const char*>(data);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (mData != nullptr)
+            UnmapViewOfFile(mData);
+        if (mMapping != -1)
+            CloseHandle(reinterpret_cast<HANDLE>(mMapping));
+    }
 }
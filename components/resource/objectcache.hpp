@@ -3,6 +3,7 @@
 // - removeExpiredObjectsInCache no longer keeps a lock while the unref happens.
 // - template allows customized KeyType.
 // - objects with uninitialized time stamp are not removed.
+// - objects are distributed over independently locked shards, expiry can be done incrementally within a time budget.
 
 /* -*-c++-*- OpenSceneGraph - Copyright (C) 1998-2006 Robert Osfield
  *
@@ -22,11 +23,22 @@
 
 #include <osg/Node>
 #include <osg/Referenced>
+#include <osg/Vec2f>
 #include <osg/ref_ptr>
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
 #include <map>
 #include <mutex>
 #include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <components/misc/hash.hpp>
 
 namespace osg
 {
@@ -37,7 +49,51 @@ namespace osg
 
 namespace Resource
 {
+    struct CacheStats
+    {
+        std::size_t mHit = 0;
+        std::size_t mMiss = 0;
+        std::size_t mContention = 0;
+    };
+
+    /// Used to distribute keys over GenericObjectCache shards. Supports the key types used by resource managers.
+    struct ObjectCacheKeyHash
+    {
+        template <class T>
+        std::size_t operator()(const T& value) const
+        {
+            return std::hash<T>()(value);
+        }
+
+        std::size_t operator()(const osg::Vec2f& value) const
+        {
+            std::size_t seed = 0;
+            Misc::hashCombine(seed, value.x());
+            Misc::hashCombine(seed, value.y());
+            return seed;
+        }
+
+        template <class First, class Second>
+        std::size_t operator()(const std::pair<First, Second>& value) const
+        {
+            std::size_t seed = 0;
+            Misc::hashCombine(seed, (*this)(value.first));
+            Misc::hashCombine(seed, (*this)(value.second));
+            return seed;
+        }
+
+        template <class... Types>
+        std::size_t operator()(const std::tuple<Types...>& value) const
+        {
+            std::size_t seed = 0;
+            std::apply([&](const auto&... v) { (Misc::hashCombine(seed, (*this)(v)), ...); }, value);
+            return seed;
+        }
+    };
 
+    /// @brief Thread-safe cache of objects with expiration.
+    /// @par Objects are distributed over a fixed number of shards by key hash. Each shard has its own lock so
+    /// concurrent lookups of different keys rarely wait for each other.
     template <typename KeyType>
     class GenericObjectCache : public osg::Referenced
     {
@@ -56,14 +112,11 @@ namespace Resource
         void updateTimeStampOfObjectsInCacheWithExternalReferences(double referenceTime)
         {
             // look for objects with external references and update their time stamp.
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            for (typename ObjectCacheMap::iterator itr = _objectCache.begin(); itr != _objectCache.end(); ++itr)
+            for (Shard& shard : mShards)
             {
-                // If ref count is greater than 1, the object has an external reference.
-                // If the timestamp is yet to be initialized, it needs to be updated too.
-                if ((itr->second.first != nullptr && itr->second.first->referenceCount() > 1)
-                    || itr->second.second == 0.0)
-                    itr->second.second = referenceTime;
+                const std::unique_lock<std::mutex> lock = lockShard(shard);
+                for (auto& [key, value] : shard.mObjects)
+                    updateTimeStamp(value, referenceTime);
             }
         }
 
@@ -74,96 +127,133 @@ namespace Resource
         void removeExpiredObjectsInCache(double expiryTime)
         {
             std::vector<osg::ref_ptr<osg::Object>> objectsToRemove;
+            for (Shard& shard : mShards)
             {
-                std::lock_guard<std::mutex> lock(_objectCacheMutex);
+                const std::unique_lock<std::mutex> lock = lockShard(shard);
                 // Remove expired entries from object cache
-                typename ObjectCacheMap::iterator oitr = _objectCache.begin();
-                while (oitr != _objectCache.end())
-                {
-                    if (oitr->second.second <= expiryTime)
-                    {
-                        objectsToRemove.push_back(oitr->second.first);
-                        _objectCache.erase(oitr++);
-                    }
-                    else
-                        ++oitr;
-                }
+                removeExpired(shard, expiryTime, objectsToRemove);
             }
             // note, actual unref happens outside of the lock
             objectsToRemove.clear();
         }
 
+        /** Does the same as updateTimeStampOfObjectsInCacheWithExternalReferences followed by
+         * removeExpiredObjectsInCache but one shard at a time. Stops when the time budget is exceeded after processing
+         * at least one shard, the next call continues from the next shard.*/
+        void updateCache(double referenceTime, double expiryTime, std::chrono::steady_clock::duration budget)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            std::vector<osg::ref_ptr<osg::Object>> objectsToRemove;
+            for (std::size_t i = 0; i < sShardsCount; ++i)
+            {
+                Shard& shard = mShards[mNextShardToUpdate.fetch_add(1) % sShardsCount];
+                {
+                    const std::unique_lock<std::mutex> lock = lockShard(shard);
+                    for (auto& [key, value] : shard.mObjects)
+                        updateTimeStamp(value, referenceTime);
+                    removeExpired(shard, expiryTime, objectsToRemove);
+                }
+                // note, actual unref happens outside of the lock
+                objectsToRemove.clear();
+                if (std::chrono::steady_clock::now() - start >= budget)
+                    break;
+            }
+        }
+
         /** Remove all objects in the cache regardless of having external references or expiry times.*/
         void clear()
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            _objectCache.clear();
+            for (Shard& shard : mShards)
+            {
+                const std::unique_lock<std::mutex> lock = lockShard(shard);
+                shard.mObjects.clear();
+            }
         }
 
         /** Add a key,object,timestamp triple to the Registry::ObjectCache.*/
         void addEntryToObjectCache(const KeyType& key, osg::Object* object, double timestamp = 0.0)
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            _objectCache[key] = ObjectTimeStampPair(object, timestamp);
+            Shard& shard = getShard(key);
+            const std::unique_lock<std::mutex> lock = lockShard(shard);
+            shard.mObjects[key] = ObjectTimeStampPair(object, timestamp);
         }
 
         /** Remove Object from cache.*/
         void removeFromObjectCache(const KeyType& key)
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            typename ObjectCacheMap::iterator itr = _objectCache.find(key);
-            if (itr != _objectCache.end())
-                _objectCache.erase(itr);
+            Shard& shard = getShard(key);
+            const std::unique_lock<std::mutex> lock = lockShard(shard);
+            typename ObjectCacheMap::iterator itr = shard.mObjects.find(key);
+            if (itr != shard.mObjects.end())
+                shard.mObjects.erase(itr);
         }
 
         /** Get an ref_ptr<Object> from the object cache*/
         osg::ref_ptr<osg::Object> getRefFromObjectCache(const KeyType& key)
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            typename ObjectCacheMap::iterator itr = _objectCache.find(key);
-            if (itr != _objectCache.end())
+            Shard& shard = getShard(key);
+            const std::unique_lock<std::mutex> lock = lockShard(shard);
+            typename ObjectCacheMap::iterator itr = shard.mObjects.find(key);
+            if (itr != shard.mObjects.end())
+            {
+                ++mHit;
                 return itr->second.first;
+            }
             else
+            {
+                ++mMiss;
                 return nullptr;
+            }
         }
 
         /** Check if an object is in the cache, and if it is, update its usage time stamp. */
         bool checkInObjectCache(const KeyType& key, double timeStamp)
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            typename ObjectCacheMap::iterator itr = _objectCache.find(key);
-            if (itr != _objectCache.end())
+            Shard& shard = getShard(key);
+            const std::unique_lock<std::mutex> lock = lockShard(shard);
+            typename ObjectCacheMap::iterator itr = shard.mObjects.find(key);
+            if (itr != shard.mObjects.end())
             {
+                ++mHit;
                 itr->second.second = timeStamp;
                 return true;
             }
             else
+            {
+                ++mMiss;
                 return false;
+            }
         }
 
         /** call releaseGLObjects on all objects attached to the object cache.*/
         void releaseGLObjects(osg::State* state)
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            for (typename ObjectCacheMap::iterator itr = _objectCache.begin(); itr != _objectCache.end(); ++itr)
+            for (Shard& shard : mShards)
             {
-                osg::Object* object = itr->second.first.get();
-                object->releaseGLObjects(state);
+                const std::unique_lock<std::mutex> lock = lockShard(shard);
+                for (typename ObjectCacheMap::iterator itr = shard.mObjects.begin(); itr != shard.mObjects.end(); ++itr)
+                {
+                    osg::Object* object = itr->second.first.get();
+                    object->releaseGLObjects(state);
+                }
             }
         }
 
         /** call node->accept(nv); for all nodes in the objectCache. */
         void accept(osg::NodeVisitor& nv)
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            for (typename ObjectCacheMap::iterator itr = _objectCache.begin(); itr != _objectCache.end(); ++itr)
+            for (Shard& shard : mShards)
             {
-                osg::Object* object = itr->second.first.get();
-                if (object)
+                const std::unique_lock<std::mutex> lock = lockShard(shard);
+                for (typename ObjectCacheMap::iterator itr = shard.mObjects.begin(); itr != shard.mObjects.end(); ++itr)
                 {
-                    osg::Node* node = dynamic_cast<osg::Node*>(object);
-                    if (node)
-                        node->accept(nv);
+                    osg::Object* object = itr->second.first.get();
+                    if (object)
+                    {
+                        osg::Node* node = dynamic_cast<osg::Node*>(object);
+                        if (node)
+                            node->accept(nv);
+                    }
                 }
             }
         }
@@ -172,16 +262,34 @@ namespace Resource
         template <class Functor>
         void call(Functor& f)
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            for (typename ObjectCacheMap::iterator it = _objectCache.begin(); it != _objectCache.end(); ++it)
-                f(it->first, it->second.first.get());
+            for (Shard& shard : mShards)
+            {
+                const std::unique_lock<std::mutex> lock = lockShard(shard);
+                for (typename ObjectCacheMap::iterator it = shard.mObjects.begin(); it != shard.mObjects.end(); ++it)
+                    f(it->first, it->second.first.get());
+            }
         }
 
         /** Get the number of objects in the cache. */
         unsigned int getCacheSize() const
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            return _objectCache.size();
+            std::size_t result = 0;
+            for (const Shard& shard : mShards)
+            {
+                const std::unique_lock<std::mutex> lock = lockShard(shard);
+                result += shard.mObjects.size();
+            }
+            return static_cast<unsigned int>(result);
+        }
+
+        /** Get lookup and lock statistics collected since the previous call. */
+        CacheStats takeStats()
+        {
+            CacheStats result;
+            result.mHit = mHit.exchange(0);
+            result.mMiss = mMiss.exchange(0);
+            result.mContention = mContention.exchange(0);
+            return result;
         }
 
     protected:
@@ -190,8 +298,57 @@ namespace Resource
         typedef std::pair<osg::ref_ptr<osg::Object>, double> ObjectTimeStampPair;
         typedef std::map<KeyType, ObjectTimeStampPair> ObjectCacheMap;
 
-        ObjectCacheMap _objectCache;
-        mutable std::mutex _objectCacheMutex;
+    private:
+        static constexpr std::size_t sShardsCount = 16;
+
+        struct Shard
+        {
+            ObjectCacheMap mObjects;
+            mutable std::mutex mMutex;
+        };
+
+        std::array<Shard, sShardsCount> mShards;
+        std::atomic_size_t mNextShardToUpdate{ 0 };
+        std::atomic_size_t mHit{ 0 };
+        std::atomic_size_t mMiss{ 0 };
+        mutable std::atomic_size_t mContention{ 0 };
+
+        Shard& getShard(const KeyType& key) { return mShards[ObjectCacheKeyHash()(key) % sShardsCount]; }
+
+        std::unique_lock<std::mutex> lockShard(const Shard& shard) const
+        {
+            std::unique_lock<std::mutex> lock(shard.mMutex, std::try_to_lock);
+            if (!lock.owns_lock())
+            {
+                ++mContention;
+                lock.lock();
+            }
+            return lock;
+        }
+
+        static void updateTimeStamp(ObjectTimeStampPair& value, double referenceTime)
+        {
+            // If ref count is greater than 1, the object has an external reference.
+            // If the timestamp is yet to be initialized, it needs to be updated too.
+            if ((value.first != nullptr && value.first->referenceCount() > 1) || value.second == 0.0)
+                value.second = referenceTime;
+        }
+
+        static void removeExpired(
+            Shard& shard, double expiryTime, std::vector<osg::ref_ptr<osg::Object>>& objectsToRemove)
+        {
+            typename ObjectCacheMap::iterator oitr = shard.mObjects.begin();
+            while (oitr != shard.mObjects.end())
+            {
+                if (oitr->second.second <= expiryTime)
+                {
+                    objectsToRemove.push_back(oitr->second.first);
+                    shard.mObjects.erase(oitr++);
+                }
+                else
+                    ++oitr;
+            }
+        }
     };
 
     class ObjectCache : public GenericObjectCache<std::string>
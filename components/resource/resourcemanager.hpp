@@ -3,6 +3,8 @@
 
 #include <osg/ref_ptr>
 
+#include <chrono>
+
 #include "objectcache.hpp"
 
 namespace VFS
@@ -27,6 +29,8 @@ namespace Resource
         virtual void clearCache() {}
         virtual void setExpiryDelay(double expiryDelay) {}
         virtual void reportStats(unsigned int frameNumber, osg::Stats* stats) const {}
+        /// Add object cache statistics collected since the previous call.
+        virtual void collectCacheStats(CacheStats& stats) const {}
         virtual void releaseGLObjects(osg::State* state) {}
     };
 
@@ -49,10 +53,11 @@ namespace Resource
         virtual ~GenericResourceManager() {}
 
         /// Clear cache entries that have not been referenced for longer than expiryDelay.
+        /// @note Limited by a time budget, the remaining cache shards are processed by the next calls.
         void updateCache(double referenceTime) override
         {
-            mCache->updateTimeStampOfObjectsInCacheWithExternalReferences(referenceTime);
-            mCache->removeExpiredObjectsInCache(referenceTime - mExpiryDelay);
+            constexpr std::chrono::microseconds budget(100);
+            mCache->updateCache(referenceTime, referenceTime - mExpiryDelay, budget);
         }
 
         /// Clear all cache entries.
@@ -66,6 +71,14 @@ namespace Resource
 
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const override {}
 
+        void collectCacheStats(CacheStats& stats) const override
+        {
+            const CacheStats cacheStats = mCache->takeStats();
+            stats.mHit += cacheStats.mHit;
+            stats.mMiss += cacheStats.mMiss;
+            stats.mContention += cacheStats.mContention;
+        }
+
         void releaseGLObjects(osg::State* state) override { mCache->releaseGLObjects(state); }
 
     protected:
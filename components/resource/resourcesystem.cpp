@@ -2,6 +2,8 @@
 
 #include <algorithm>
 
+#include <osg/Stats>
+
 #include "imagemanager.hpp"
 #include "keyframemanager.hpp"
 #include "niffilemanager.hpp"
@@ -100,6 +102,13 @@ namespace Resource
         for (std::vector<BaseResourceManager*>::const_iterator it = mResourceManagers.begin();
              it != mResourceManagers.end(); ++it)
             (*it)->reportStats(frameNumber, stats);
+
+        CacheStats cacheStats;
+        for (const BaseResourceManager* manager : mResourceManagers)
+            manager->collectCacheStats(cacheStats);
+        stats->setAttribute(frameNumber, "Cache Hit", cacheStats.mHit);
+        stats->setAttribute(frameNumber, "Cache Miss", cacheStats.mMiss);
+        stats->setAttribute(frameNumber, "Cache Contention", cacheStats.mContention);
     }
 
     void ResourceSystem::releaseGLObjects(osg::State* state)
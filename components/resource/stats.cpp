@@ -437,11 +437,16 @@ namespace Resource
                 "",
                 "Groundcover Chunk",
                 "Object Chunk",
+                "Object Chunk Time",
                 "Terrain Chunk",
                 "Terrain Texture",
                 "Land",
                 "Composite",
                 "",
+                "Cache Hit",
+                "Cache Miss",
+                "Cache Contention",
+                "",
                 "NavMesh Jobs",
                 "NavMesh Waiting",
                 "NavMesh Pushed",
@@ -457,12 +462,21 @@ namespace Resource
                 "Mechanics Actors",
                 "Mechanics Objects",
                 "",
+                "MWScript Runs",
+                "MWScript Time",
+                "",
                 "Physics Actors",
                 "Physics Objects",
                 "Physics Projectiles",
                 "Physics HeightFields",
+                "Physics LOS Hit",
+                "Physics LOS Miss",
+                "Physics LOS Batched",
+                "Physics LOS Time",
                 "",
                 "Lua UsedMemory",
+                "Lua Handler Calls",
+                "Lua Handler Time",
             });
 
             static const auto longest = std::max_element(statNames.begin(), statNames.end(),
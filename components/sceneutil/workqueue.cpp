@@ -2,10 +2,93 @@
 
 #include <components/debug/debuglog.hpp>
 
+#include <algorithm>
+#include <exception>
+#include <memory>
 #include <numeric>
 
 namespace SceneUtil
 {
+    namespace
+    {
+        struct ParallelForState
+        {
+            std::function<void(std::size_t)> mFunction;
+            std::size_t mCount;
+            std::atomic_size_t mNext{ 0 };
+            std::size_t mFinished = 0;
+            std::exception_ptr mError;
+            std::mutex mMutex;
+            std::condition_variable mCondition;
+
+            explicit ParallelForState(std::size_t count)
+                : mCount(count)
+            {
+            }
+
+            void run()
+            {
+                while (true)
+                {
+                    const std::size_t index = mNext.fetch_add(1);
+                    if (index >= mCount)
+                        return;
+                    std::exception_ptr error;
+                    try
+                    {
+                        mFunction(index);
+                    }
+                    catch (...)
+                    {
+                        error = std::current_exception();
+                    }
+                    std::lock_guard lock(mMutex);
+                    if (error != nullptr && mError == nullptr)
+                        mError = std::move(error);
+                    if (++mFinished == mCount)
+                        mCondition.notify_all();
+                }
+            }
+        };
+
+        class ParallelForItem final : public WorkItem
+        {
+        public:
+            explicit ParallelForItem(std::shared_ptr<ParallelForState> state)
+                : mState(std::move(state))
+            {
+            }
+
+            void doWork() override { mState->run(); }
+
+        private:
+            std::shared_ptr<ParallelForState> mState;
+        };
+    }
+
+    void parallelFor(WorkQueue* workQueue, std::size_t count, const std::function<void(std::size_t)>& function)
+    {
+        if (count == 0)
+            return;
+        const std::size_t helpers = workQueue == nullptr ? 0 : std::min(workQueue->getNumThreads(), count - 1);
+        if (helpers == 0)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                function(i);
+            return;
+        }
+        // Items may start after the function is finished so they share ownership of the state.
+        const auto state = std::make_shared<ParallelForState>(count);
+        state->mFunction = function;
+        for (std::size_t i = 0; i < helpers; ++i)
+            workQueue->addWorkItem(new ParallelForItem(state), true);
+        state->run();
+        std::unique_lock lock(state->mMutex);
+        state->mCondition.wait(lock, [&] { return state->mFinished == state->mCount; });
+        // Items which start later will find no more indices and won't call the function.
+        if (state->mError != nullptr)
+            std::rethrow_exception(state->mError);
+    }
 
     void WorkItem::waitTillDone()
     {
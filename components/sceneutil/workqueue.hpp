@@ -7,6 +7,7 @@
 #include <atomic>
 #include <condition_variable>
 #include <deque>
+#include <functional>
 #include <mutex>
 #include <thread>
 #include <vector>
@@ -66,6 +67,8 @@ namespace SceneUtil
 
         unsigned int getNumActiveThreads() const;
 
+        std::size_t getNumThreads() const { return mThreads.size(); }
+
     private:
         bool mIsReleased;
         std::deque<osg::ref_ptr<WorkItem>> mQueue;
@@ -76,6 +79,12 @@ namespace SceneUtil
         std::vector<std::unique_ptr<WorkThread>> mThreads;
     };
 
+    /// Calls function(index) for each index in [0, count) on the calling thread and the work queue threads. Returns
+    /// when all calls are finished. Work queue items which didn't start before the calling thread has processed the
+    /// rest are not waited for, so a work queue busy with long items doesn't delay the caller. The first exception
+    /// thrown by the function is rethrown.
+    void parallelFor(WorkQueue* workQueue, std::size_t count, const std::function<void(std::size_t)>& function);
+
     /// Internally used by WorkQueue.
     class WorkThread
     {
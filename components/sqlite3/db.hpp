@@ -16,6 +16,8 @@ namespace Sqlite3
     using Db = std::unique_ptr<sqlite3, CloseSqlite3>;
 
     Db makeDb(std::string_view path, const char* schema);
+
+    Db makeReadOnlyDb(std::string_view path);
 }
 
 #endif
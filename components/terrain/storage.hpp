@@ -1,6 +1,9 @@
 #ifndef COMPONENTS_TERRAIN_STORAGE_H
 #define COMPONENTS_TERRAIN_STORAGE_H
 
+#include <cassert>
+#include <cstddef>
+#include <span>
 #include <vector>
 
 #include <osg/Array>
@@ -77,6 +80,14 @@ namespace Terrain
 
         virtual float getHeightAt(const osg::Vec3f& worldPos) = 0;
 
+        /// Get heights for multiple positions at once. Positions within the same cell should go one after another.
+        virtual void getHeightsAt(std::span<const osg::Vec3f> worldPositions, std::span<float> heights)
+        {
+            assert(worldPositions.size() == heights.size());
+            for (std::size_t i = 0; i < worldPositions.size(); ++i)
+                heights[i] = getHeightAt(worldPositions[i]);
+        }
+
         /// Get the transformation factor for mapping cell units to world units.
         virtual float getCellWorldSize() = 0;
 
@@ -127,6 +127,11 @@ namespace Terrain
         return mStorage->getHeightAt(worldPos);
     }
 
+    void World::getHeightsAt(std::span<const osg::Vec3f> worldPositions, std::span<float> heights)
+    {
+        mStorage->getHeightsAt(worldPositions, heights);
+    }
+
     void World::updateTextureFiltering()
     {
         if (mTextureManager)
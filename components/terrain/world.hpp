@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <set>
+#include <span>
 
 #include "cellborder.hpp"
 
@@ -61,6 +62,9 @@ namespace Terrain
 
         float getHeightAt(const osg::Vec3f& worldPos);
 
+        /// See Storage::getHeightsAt
+        void getHeightsAt(std::span<const osg::Vec3f> worldPositions, std::span<float> heights);
+
         /// Clears the cached land and landtexture data.
         /// @note Thread safe.
         virtual void clearAssociatedCaches();
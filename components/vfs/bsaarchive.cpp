@@ -9,7 +9,7 @@ namespace VFS
     BsaArchive::BsaArchive(const std::filesystem::path& filename)
     {
         mFile = std::make_unique<Bsa::BSAFile>();
-        mFile->open(filename);
+        mFile->open(filename, true);
 
         const Bsa::BSAFile::FileList& filelist = mFile->getList();
         for (Bsa::BSAFile::FileList::const_iterator it = filelist.begin(); it != filelist.end(); ++it)
@@ -67,7 +67,7 @@ namespace VFS
         : Archive()
     {
         mCompressedFile = std::make_unique<Bsa::CompressedBSAFile>();
-        mCompressedFile->open(filename);
+        mCompressedFile->open(filename, true);
 
         const Bsa::BSAFile::FileList& filelist = mCompressedFile->getList();
         for (Bsa::BSAFile::FileList::const_iterator it = filelist.begin(); it != filelist.end(); ++it)
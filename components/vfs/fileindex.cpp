@@ -0,0 +1,107 @@
+#include "fileindex.hpp"
+
+#include <algorithm>
+
+#include <components/misc/strings/lower.hpp>
+
+namespace VFS
+{
+    namespace
+    {
+        // Compares normalized value with a not normalized one the same way as std::string does
+        int compareNormalized(std::string_view normalized, std::string_view value, bool strict)
+        {
+            const std::size_t size = std::min(normalized.size(), value.size());
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                const auto lhs = static_cast<unsigned char>(normalized[i]);
+                const auto rhs = static_cast<unsigned char>(FileIndex::normalize(value[i], strict));
+                if (lhs != rhs)
+                    return lhs < rhs ? -1 : 1;
+            }
+            if (normalized.size() == value.size())
+                return 0;
+            return normalized.size() < value.size() ? -1 : 1;
+        }
+    }
+
+    FileIndex::FileIndex(bool strict)
+        : mStrict(strict)
+        , mLookup(0, Hash{ strict }, Equal{ strict })
+    {
+    }
+
+    char FileIndex::normalize(char ch, bool strict)
+    {
+        if (ch == '\\')
+            return '/';
+        return strict ? ch : Misc::StringUtils::toLower(ch);
+    }
+
+    void FileIndex::clear()
+    {
+        mLookup.clear();
+        mEntries.clear();
+    }
+
+    void FileIndex::assign(std::map<std::string, File*>&& files)
+    {
+        clear();
+
+        mEntries.reserve(files.size());
+        while (!files.empty())
+        {
+            auto node = files.extract(files.begin());
+            mEntries.emplace_back(std::move(node.key()), node.mapped());
+        }
+
+        // Keys point into mEntries so it must not be modified until the next assign or clear call
+        mLookup.reserve(mEntries.size());
+        for (const Entry& entry : mEntries)
+            mLookup.emplace(entry.first, entry.second);
+    }
+
+    File* FileIndex::find(std::string_view name) const
+    {
+        const auto it = mLookup.find(name);
+        if (it == mLookup.end())
+            return nullptr;
+        return it->second;
+    }
+
+    std::pair<FileIndex::const_iterator, FileIndex::const_iterator> FileIndex::findPrefix(
+        std::string_view prefix) const
+    {
+        if (prefix.empty())
+            return { mEntries.begin(), mEntries.end() };
+        const auto first = std::partition_point(mEntries.begin(), mEntries.end(),
+            [&](const Entry& entry) { return compareNormalized(entry.first, prefix, mStrict) < 0; });
+        const auto last = std::partition_point(first, mEntries.end(), [&](const Entry& entry) {
+            return entry.first.size() >= prefix.size()
+                && compareNormalized(std::string_view(entry.first).substr(0, prefix.size()), prefix, mStrict) == 0;
+        });
+        return { first, last };
+    }
+
+    std::size_t FileIndex::Hash::operator()(std::string_view value) const
+    {
+        // FNV-1a
+        std::size_t result = static_cast<std::size_t>(14695981039346656037ULL);
+        for (const char ch : value)
+        {
+            result ^= static_cast<unsigned char>(normalize(ch, mStrict));
+            result *= static_cast<std::size_t>(1099511628211ULL);
+        }
+        return result;
+    }
+
+    bool FileIndex::Equal::operator()(std::string_view lhs, std::string_view rhs) const
+    {
+        if (lhs.size() != rhs.size())
+            return false;
+        for (std::size_t i = 0; i < lhs.size(); ++i)
+            if (normalize(lhs[i], mStrict) != normalize(rhs[i], mStrict))
+                return false;
+        return true;
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef OPENMW_COMPONENTS_VFS_FILEINDEX_H
+#define OPENMW_COMPONENTS_VFS_FILEINDEX_H
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace VFS
+{
+    class File;
+
+    /// @brief Immutable index of normalized file paths.
+    /// @par Paths are stored once in a sorted contiguous array, so prefix queries return a contiguous range. A hash
+    /// table keyed by views into this array provides constant time lookups. Both lookup kinds normalize the query on
+    /// the fly and never allocate.
+    /// @par All const methods are thread-safe.
+    class FileIndex
+    {
+    public:
+        using Entry = std::pair<std::string, File*>;
+        using const_iterator = std::vector<Entry>::const_iterator;
+
+        /// @param strict Use strict path handling? If enabled, no case folding will
+        /// be done, but slash/backslash conversions are always done.
+        explicit FileIndex(bool strict);
+
+        FileIndex(const FileIndex&) = delete;
+
+        FileIndex& operator=(const FileIndex&) = delete;
+
+        void clear();
+
+        /// Replace index content. Keys are expected to be normalized already.
+        void assign(std::map<std::string, File*>&& files);
+
+        /// Find a file by name. The name doesn't have to be normalized.
+        /// @return nullptr if there is no such file.
+        File* find(std::string_view name) const;
+
+        /// Find all files with names starting with the given prefix. The prefix doesn't have to be normalized.
+        std::pair<const_iterator, const_iterator> findPrefix(std::string_view prefix) const;
+
+        const_iterator begin() const { return mEntries.begin(); }
+
+        const_iterator end() const { return mEntries.end(); }
+
+        std::size_t size() const { return mEntries.size(); }
+
+        bool empty() const { return mEntries.empty(); }
+
+        static char normalize(char ch, bool strict);
+
+    private:
+        struct Hash
+        {
+            bool mStrict;
+
+            std::size_t operator()(std::string_view value) const;
+        };
+
+        struct Equal
+        {
+            bool mStrict;
+
+            bool operator()(std::string_view lhs, std::string_view rhs) const;
+        };
+
+        bool mStrict;
+        std::vector<Entry> mEntries;
+        std::unordered_map<std::string_view, File*, Hash, Equal> mLookup;
+    };
+}
+
+#endif
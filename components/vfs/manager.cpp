@@ -1,6 +1,7 @@
 #include "manager.hpp"
 
 #include <algorithm>
+#include <map>
 #include <stdexcept>
 
 #include <components/files/conversion.hpp>
@@ -34,6 +35,7 @@ namespace VFS
 
     Manager::Manager(bool strict)
         : mStrict(strict)
+        , mIndex(strict)
     {
     }
 
@@ -52,34 +54,33 @@ namespace VFS
 
     void Manager::buildIndex()
     {
-        mIndex.clear();
+        std::map<std::string, File*> files;
 
         for (const auto& archive : mArchives)
-            archive->listResources(mIndex, mStrict ? &strict_normalize_char : &nonstrict_normalize_char);
+            archive->listResources(files, mStrict ? &strict_normalize_char : &nonstrict_normalize_char);
+
+        mIndex.assign(std::move(files));
     }
 
     Files::IStreamPtr Manager::get(std::string_view name) const
     {
-        std::string normalized(name);
-        normalize_path(normalized, mStrict);
-
-        return getNormalized(normalized);
+        File* const file = mIndex.find(name);
+        if (file == nullptr)
+            throw std::runtime_error("Resource '" + normalizeFilename(name) + "' not found");
+        return file->open();
     }
 
     Files::IStreamPtr Manager::getNormalized(const std::string& normalizedName) const
     {
-        std::map<std::string, File*>::const_iterator found = mIndex.find(normalizedName);
-        if (found == mIndex.end())
+        File* const file = mIndex.find(normalizedName);
+        if (file == nullptr)
             throw std::runtime_error("Resource '" + normalizedName + "' not found");
-        return found->second->open();
+        return file->open();
     }
 
     bool Manager::exists(std::string_view name) const
     {
-        std::string normalized(name);
-        normalize_path(normalized, mStrict);
-
-        return mIndex.find(normalized) != mIndex.end();
+        return mIndex.find(name) != nullptr;
     }
 
     std::string Manager::normalizeFilename(std::string_view name) const
@@ -106,29 +107,15 @@ namespace VFS
         std::string normalized = Files::pathToUnicodeString(name);
         normalize_path(normalized, mStrict);
 
-        const auto found = mIndex.find(normalized);
-        if (found == mIndex.end())
+        File* const file = mIndex.find(normalized);
+        if (file == nullptr)
             throw std::runtime_error("Resource '" + normalized + "' not found");
-        return found->second->getPath();
-    }
-
-    namespace
-    {
-        bool startsWith(std::string_view text, std::string_view start)
-        {
-            return text.rfind(start, 0) == 0;
-        }
+        return file->getPath();
     }
 
     Manager::RecursiveDirectoryRange Manager::getRecursiveDirectoryIterator(std::string_view path) const
     {
-        if (path.empty())
-            return { mIndex.begin(), mIndex.end() };
-        auto normalized = normalizeFilename(path);
-        const auto it = mIndex.lower_bound(normalized);
-        if (it == mIndex.end() || !startsWith(it->first, normalized))
-            return { it, it };
-        ++normalized.back();
-        return { it, mIndex.lower_bound(normalized) };
+        const auto [first, last] = mIndex.findPrefix(path);
+        return { first, last };
     }
 }
@@ -3,8 +3,9 @@
 
 #include <components/files/istreamptr.hpp>
 
+#include "fileindex.hpp"
+
 #include <filesystem>
-#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -42,7 +43,7 @@ namespace VFS
         class RecursiveDirectoryIterator
         {
         public:
-            RecursiveDirectoryIterator(std::map<std::string, File*>::const_iterator it)
+            RecursiveDirectoryIterator(FileIndex::const_iterator it)
                 : mIt(it)
             {
             }
@@ -56,7 +57,7 @@ namespace VFS
             }
 
         private:
-            std::map<std::string, File*>::const_iterator mIt;
+            FileIndex::const_iterator mIt;
         };
 
         using RecursiveDirectoryRange = IteratorPair<RecursiveDirectoryIterator>;
@@ -114,7 +115,7 @@ namespace VFS
 
         std::vector<std::unique_ptr<Archive>> mArchives;
 
-        std::map<std::string, File*> mIndex;
+        FileIndex mIndex;
     };
 
 }